@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+'''
+@file bench_compare.py
+@brief Performance regression gate: compare benchmarks against a baseline
+@author gm
+@copyright gm 2016
+
+This file is part of SoundTailor
+
+SoundTailor is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SoundTailor is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+'''
+
+'''
+Baseline file format (JSON):
+
+    {
+      "version": 1,
+      "context": { Google Benchmark context of the recording run },
+      "benchmarks": {
+        "<benchmark name>": {
+          "median": <median ns per sample over repetitions>,
+          "mad": <median absolute deviation of the above>,
+          "repetitions": <repetitions count>
+        },
+        ...
+      }
+    }
+
+A benchmark is reported as a regression when its median got slower than
+the baseline one by more than the relative tolerance, and when this
+difference is significant given the spread of both measurements, i.e.
+above the given count of (normalized) median absolute deviations.
+'''
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+kBaselineVersion = 1
+# Scaling factor making the MAD a consistent estimator of the standard
+# deviation for normally distributed measurements
+kMadToSigma = 1.4826
+
+def Median(values):
+    '''
+    Median of a non-empty list of values
+    '''
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return 0.5 * (ordered[middle - 1] + ordered[middle])
+
+def MedianAbsoluteDeviation(values, median):
+    '''
+    Median of absolute deviations of values from their median
+    '''
+    return Median([abs(value - median) for value in values])
+
+def RunBenchmarks(executable, repetitions, bench_filter, min_time):
+    '''
+    Run the benchmark executable, return its raw JSON output
+    '''
+    handle, out_filename = tempfile.mkstemp(suffix=".json")
+    os.close(handle)
+    # Interleaving repetitions of all benchmarks prevents slow drifts
+    # of the machine state to be attributed to a single benchmark
+    arguments = [executable,
+                 "--benchmark_repetitions=%d" % repetitions,
+                 "--benchmark_enable_random_interleaving=true",
+                 "--benchmark_out=%s" % out_filename,
+                 "--benchmark_out_format=json"]
+    if bench_filter:
+        arguments.append("--benchmark_filter=%s" % bench_filter)
+    if min_time:
+        arguments.append("--benchmark_min_time=%s" % min_time)
+    try:
+        subprocess.check_call(arguments, stdout=sys.stderr)
+        with open(out_filename) as out_file:
+            return json.load(out_file)
+    finally:
+        os.remove(out_filename)
+
+def Summarize(results):
+    '''
+    Compute median and MAD of each benchmark over its repetitions,
+    from Google Benchmark raw JSON output
+    '''
+    measures = {}
+    for benchmark in results["benchmarks"]:
+        # Aggregates (mean, median...) are recomputed here
+        if benchmark.get("run_type", "iteration") != "iteration":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        if "ns_per_sample" in benchmark:
+            value = benchmark["ns_per_sample"]
+        else:
+            value = benchmark["real_time"]
+        measures.setdefault(name, []).append(value)
+    summary = {}
+    for name, values in measures.items():
+        median = Median(values)
+        summary[name] = {"median": median,
+                         "mad": MedianAbsoluteDeviation(values, median),
+                         "repetitions": len(values)}
+    return summary
+
+def LoadBaseline(filename):
+    with open(filename) as baseline_file:
+        baseline = json.load(baseline_file)
+    if baseline.get("version") != kBaselineVersion:
+        raise ValueError("Unsupported baseline version in %s" % filename)
+    return baseline["benchmarks"]
+
+def SaveBaseline(filename, results, summary):
+    baseline = {"version": kBaselineVersion,
+                "context": results.get("context", {}),
+                "benchmarks": summary}
+    with open(filename, "w") as baseline_file:
+        json.dump(baseline, baseline_file, indent=2, sort_keys=True)
+        baseline_file.write("\n")
+
+def Compare(baseline, current, tolerance, mad_count):
+    '''
+    Compare current summary with the baseline one:
+    print a per-benchmark report, return the list of regressions names
+    '''
+    regressions = []
+    name_width = max([len(name) for name in current] + [len("Benchmark")])
+    print("%-*s %12s %12s %9s  %s" % (name_width, "Benchmark",
+                                      "Baseline", "Current",
+                                      "Change", "Status"))
+    for name in sorted(current):
+        measure = current[name]
+        if name not in baseline:
+            print("%-*s %12s %12.4f %9s  new" % (name_width, name, "-",
+                                                 measure["median"], "-"))
+            continue
+        reference = baseline[name]
+        difference = measure["median"] - reference["median"]
+        relative = difference / reference["median"]
+        noise = mad_count * kMadToSigma * max(reference["mad"], measure["mad"])
+        status = "ok"
+        if relative > tolerance and difference > noise:
+            status = "REGRESSION"
+            regressions.append(name)
+        elif -relative > tolerance and -difference > noise:
+            status = "improvement"
+        print("%-*s %12.4f %12.4f %+8.1f%%  %s" % (name_width, name,
+                                                   reference["median"],
+                                                   measure["median"],
+                                                   100.0 * relative,
+                                                   status))
+    for name in sorted(set(baseline) - set(current)):
+        print("%-*s %12.4f %12s %9s  missing" % (name_width, name,
+                                                 baseline[name]["median"],
+                                                 "-", "-"))
+    return regressions
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Compare SoundTailor benchmarks against a stored baseline")
+    parser.add_argument("baseline", help="Baseline JSON file")
+    parser.add_argument("--executable",
+                        help="soundtailor_bench executable to be run")
+    parser.add_argument("--results",
+                        help="Use this Google Benchmark JSON output "
+                             "instead of running the executable")
+    parser.add_argument("--record", action="store_true",
+                        help="Write the baseline instead of comparing")
+    parser.add_argument("--repetitions", type=int, default=9)
+    parser.add_argument("--filter", default="",
+                        help="Only run benchmarks matching this regex")
+    parser.add_argument("--min-time", default="",
+                        help="Minimum time per benchmark run, in seconds")
+    parser.add_argument("--tolerance", type=float, default=0.1,
+                        help="Relative slowdown tolerated (default: 10%%)")
+    parser.add_argument("--mad-count", type=float, default=3.0,
+                        help="Slowdown has to be above this count of "
+                             "normalized MADs (default: 3)")
+    arguments = parser.parse_args()
+
+    if arguments.results:
+        with open(arguments.results) as results_file:
+            results = json.load(results_file)
+    elif arguments.executable:
+        results = RunBenchmarks(arguments.executable,
+                                arguments.repetitions,
+                                arguments.filter,
+                                arguments.min_time)
+    else:
+        parser.error("Either --executable or --results is required")
+    summary = Summarize(results)
+
+    if arguments.record:
+        SaveBaseline(arguments.baseline, results, summary)
+        print("Baseline written to %s (%d benchmarks)" % (arguments.baseline,
+                                                          len(summary)))
+        sys.exit(0)
+
+    regressions = Compare(LoadBaseline(arguments.baseline),
+                          summary,
+                          arguments.tolerance,
+                          arguments.mad_count)
+    if regressions:
+        print("%d performance regression(s):" % len(regressions))
+        for name in regressions:
+            print("  %s" % name)
+        sys.exit(1)
+    print("No performance regression")
@@ -0,0 +1,106 @@
+/// @file bench.h
+/// @brief Benchmarks common include file
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_BENCH_BENCH_H_
+#define SOUNDTAILOR_BENCH_BENCH_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "soundtailor/bench/hardware_counters.h"
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/utilities.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+namespace soundtailor {
+namespace bench {
+
+/// @brief Length of the data processed by per-Sample benchmarks
+static const std::size_t kPerSampleLength(4096);
+
+/// @brief Block sizes used by all block benchmarks
+inline void BlockSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(32)->Arg(64)->Arg(256)->Arg(1024)->Arg(4096);
+}
+
+/// @brief Report throughput counters, given the number of samples
+/// processed at each iteration:
+/// - "ns_per_sample": average time spent per sample, in nanoseconds
+/// - "samples_per_second": throughput, in samples per second
+///
+/// If hardware counters are enabled, all available events are reported
+/// per sample as well (e.g. "cycles_per_sample"), along with "ipc".
+/// They have to be constructed right before the benchmark loop.
+///
+/// All are written along with the raw timings in the JSON output.
+inline void SetSampleCounters(benchmark::State& state,
+                              const std::size_t samples_per_iteration,
+                              HardwareCounters* hardware_counters) {
+  hardware_counters->Stop();
+  const double kSamples(static_cast<double>(samples_per_iteration));
+  state.counters["ns_per_sample"] = benchmark::Counter(
+    kSamples * 1e-9,
+    benchmark::Counter::kIsIterationInvariantRate
+    | benchmark::Counter::kInvert);
+  state.counters["samples_per_second"] = benchmark::Counter(
+    kSamples,
+    benchmark::Counter::kIsIterationInvariantRate);
+
+  const double kTotalSamples(kSamples
+                             * static_cast<double>(state.iterations()));
+  for (unsigned int event(0);
+       event < HardwareCounters::kEventsCount;
+       ++event) {
+    const HardwareCounters::Event kEvent(
+      static_cast<HardwareCounters::Event>(event));
+    if (hardware_counters->IsAvailable(kEvent) && kTotalSamples > 0.0) {
+      state.counters[std::string(HardwareCounters::GetName(kEvent))
+                     + "_per_sample"]
+        = hardware_counters->Get(kEvent) / kTotalSamples;
+    }
+  }
+  if (hardware_counters->IsAvailable(HardwareCounters::kCycles)
+      && hardware_counters->IsAvailable(HardwareCounters::kInstructions)
+      && hardware_counters->Get(HardwareCounters::kCycles) > 0.0) {
+    state.counters["ipc"]
+      = hardware_counters->Get(HardwareCounters::kInstructions)
+        / hardware_counters->Get(HardwareCounters::kCycles);
+  }
+}
+
+/// @brief Deterministic input data, within [-1.0 ; 1.0]
+///
+/// Generated once, outside of any timed loop
+inline std::vector<float> MakeInput(const std::size_t length) {
+  std::vector<float> out(length);
+  generators::WhiteNoise noise;
+  ProcessBlock(&out[0], length, noise);
+  return out;
+}
+
+}  // namespace bench
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_BENCH_BENCH_H_
@@ -0,0 +1,429 @@
+/// @file bench_filters.cc
+/// @brief SoundTailor filters benchmarks
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min, std::max
+#include <algorithm>
+// std::pow
+#include <cmath>
+#include <vector>
+
+#include "soundtailor/bench/bench.h"
+
+#include "soundtailor/src/filters/biquad_designer.h"
+#include "soundtailor/src/filters/chamberlin.h"
+#include "soundtailor/src/filters/chamberlin_oversampled.h"
+#include "soundtailor/src/filters/convolver.h"
+#include "soundtailor/src/filters/filter_bank.h"
+#include "soundtailor/src/filters/firstorder_polefixedzero.h"
+#include "soundtailor/src/filters/firstorder_polezero.h"
+#include "soundtailor/src/filters/gain.h"
+#include "soundtailor/src/filters/moog.h"
+#include "soundtailor/src/filters/moog_lowaliasnonlinear.h"
+#include "soundtailor/src/filters/moog_lowpassblock.h"
+#include "soundtailor/src/filters/moog_musicdsp.h"
+#include "soundtailor/src/filters/moog_musicdsp_var1.h"
+#include "soundtailor/src/filters/moog_musicdsp_var2.h"
+#include "soundtailor/src/filters/moog_musicdsp_varstilson.h"
+#include "soundtailor/src/filters/moog_oversampled.h"
+#include "soundtailor/src/filters/oversampler.h"
+#include "soundtailor/src/filters/saturators.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/sos_cascade.h"
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/filters/waveshaper.h"
+
+using soundtailor::Sample;
+using soundtailor::SampleSize;
+using soundtailor::VectorMath;
+using soundtailor::bench::BlockSizes;
+using soundtailor::bench::HardwareCounters;
+using soundtailor::bench::MakeInput;
+using soundtailor::bench::SetSampleCounters;
+using soundtailor::bench::kPerSampleLength;
+
+using soundtailor::filters::Chamberlin;
+using soundtailor::filters::ChamberlinOversampled;
+using soundtailor::filters::Convolver;
+using soundtailor::filters::DesignBiquad;
+using soundtailor::filters::FilterBank;
+using soundtailor::filters::FirstOrderPoleFixedZero;
+using soundtailor::filters::FirstOrderPoleZero;
+using soundtailor::filters::Gain;
+using soundtailor::filters::Moog;
+using soundtailor::filters::MoogLowAliasNonLinear;
+using soundtailor::filters::MoogLowAliasNonLinearParallel;
+using soundtailor::filters::MoogLowPassBlock;
+using soundtailor::filters::MoogMusicDSP;
+using soundtailor::filters::MoogMusicDSPVar1;
+using soundtailor::filters::MoogMusicDSPVar2;
+using soundtailor::filters::MoogMusicDSPVarStilson;
+using soundtailor::filters::MoogOversampled;
+using soundtailor::filters::Oversampler;
+using soundtailor::filters::SecondOrderRaw;
+using soundtailor::filters::SosCascade;
+using soundtailor::filters::SosCascadeParallel;
+using soundtailor::filters::StateVariable;
+using soundtailor::filters::StateVariableParallel;
+using soundtailor::filters::Waveshaper;
+
+/// @brief Set typical parameters, within the filter own bounds
+template <typename FilterType>
+static void SetTypicalParameters(FilterType* filter) {
+  const float kFrequency(std::min(std::max(0.1f,
+                                           FilterType::Meta().freq_min),
+                                  FilterType::Meta().freq_max));
+  filter->SetParameters(kFrequency,
+                        0.5f * (FilterType::Meta().res_min
+                                + FilterType::Meta().res_max));
+}
+
+/// @brief Block processing: the filter own method if any
+template <typename FilterType>
+static auto ProcessFilterBlock(FilterType* filter,
+                               const float* in,
+                               float* out,
+                               const std::size_t block_size,
+                               int) -> decltype(filter->ProcessBlock(
+                                                  in,
+                                                  out,
+                                                  block_size)) {
+  return filter->ProcessBlock(in, out, block_size);
+}
+
+/// @brief Block processing: the generic per-Sample loop otherwise
+template <typename FilterType>
+static void ProcessFilterBlock(FilterType* filter,
+                               const float* in,
+                               float* out,
+                               const std::size_t block_size,
+                               long) {
+  soundtailor::ProcessBlock(in, out, block_size, *filter);
+}
+
+/// @brief Per-Sample path: operator() called on each Sample
+template <typename FilterType>
+static void FilterPerSample(benchmark::State& state) {
+  const std::vector<float> input(MakeInput(kPerSampleLength));
+  FilterType filter;
+  SetTypicalParameters(&filter);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kPerSampleLength; i += SampleSize) {
+      Sample out(filter(VectorMath::Fill(&input[i])));
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  SetSampleCounters(state, kPerSampleLength, &counters);
+}
+
+/// @brief Block path, for the block size given as argument
+template <typename FilterType>
+static void FilterBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  FilterType filter;
+  SetTypicalParameters(&filter);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    ProcessFilterBlock(&filter, &input[0], &output[0], kBlockSize, 0);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+
+#define SOUNDTAILOR_BENCH_FILTER(FilterType) \
+  BENCHMARK_TEMPLATE(FilterPerSample, FilterType); \
+  BENCHMARK_TEMPLATE(FilterBlock, FilterType)->Apply(BlockSizes)
+
+SOUNDTAILOR_BENCH_FILTER(Chamberlin);
+SOUNDTAILOR_BENCH_FILTER(ChamberlinOversampled);
+SOUNDTAILOR_BENCH_FILTER(FirstOrderPoleFixedZero);
+SOUNDTAILOR_BENCH_FILTER(FirstOrderPoleZero);
+SOUNDTAILOR_BENCH_FILTER(Gain);
+SOUNDTAILOR_BENCH_FILTER(Moog);
+SOUNDTAILOR_BENCH_FILTER(MoogLowAliasNonLinear);
+SOUNDTAILOR_BENCH_FILTER(MoogLowPassBlock);
+SOUNDTAILOR_BENCH_FILTER(MoogMusicDSP);
+SOUNDTAILOR_BENCH_FILTER(MoogMusicDSPVar1);
+SOUNDTAILOR_BENCH_FILTER(MoogMusicDSPVar2);
+SOUNDTAILOR_BENCH_FILTER(MoogMusicDSPVarStilson);
+SOUNDTAILOR_BENCH_FILTER(MoogOversampled);
+SOUNDTAILOR_BENCH_FILTER(Oversampler<SecondOrderRaw>);
+SOUNDTAILOR_BENCH_FILTER(SecondOrderRaw);
+SOUNDTAILOR_BENCH_FILTER(StateVariable);
+
+/// @brief Voice-parallel filters: one voice per lane, SampleSize voices
+/// processed for each time step. Reported per sample of each voice.
+template <typename FilterType>
+static void FilterParallelBlock(benchmark::State& state) {
+  const std::size_t kLength(static_cast<std::size_t>(state.range(0)));
+  const std::vector<float> input(MakeInput(kLength * SampleSize));
+  std::vector<float> output(kLength * SampleSize);
+  FilterType filter;
+  SetTypicalParameters(&filter);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    filter.ProcessBlock(&input[0], &output[0], kLength);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kLength * SampleSize, &counters);
+}
+
+BENCHMARK_TEMPLATE(FilterParallelBlock, StateVariableParallel)
+  ->Apply(BlockSizes);
+BENCHMARK_TEMPLATE(FilterParallelBlock, MoogLowAliasNonLinearParallel)
+  ->Apply(BlockSizes);
+
+/// @brief Reference for the above: SampleSize separate filters, each one
+/// processing the whole block. Reported per sample of each voice.
+template <typename FilterType>
+static void FilterSerialBlock(benchmark::State& state) {
+  const std::size_t kLength(static_cast<std::size_t>(state.range(0)));
+  const std::vector<float> input(MakeInput(kLength));
+  std::vector<float> output(kLength);
+  std::vector<FilterType> filters(SampleSize);
+  for (FilterType& filter : filters) {
+    SetTypicalParameters(&filter);
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (FilterType& filter : filters) {
+      ProcessFilterBlock(&filter, &input[0], &output[0], kLength, 0);
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kLength * SampleSize, &counters);
+}
+
+BENCHMARK_TEMPLATE(FilterSerialBlock, StateVariable)->Apply(BlockSizes);
+BENCHMARK_TEMPLATE(FilterSerialBlock, ChamberlinOversampled)
+  ->Apply(BlockSizes);
+BENCHMARK_TEMPLATE(FilterSerialBlock, MoogLowAliasNonLinear)
+  ->Apply(BlockSizes);
+
+/// @brief Second order sections cascade (8 sections, single channel)
+static void SosCascadeBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const unsigned int kSections(8);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  SosCascade cascade(kSections);
+  for (unsigned int i(0); i < kSections; ++i) {
+    cascade.SetSection(i, DesignBiquad(soundtailor::filters::kBiquadLowPass,
+                                       0.1f,
+                                       0.7071f));
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    cascade.ProcessBlock(&input[0], &output[0], kBlockSize);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SosCascadeBlock)->Apply(BlockSizes);
+
+/// @brief Reference for the above: as many chained SecondOrderRaw filters
+static void SosChainedBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const unsigned int kSections(8);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  // Chained filters cannot work in place
+  std::vector<float> scratch(kBlockSize);
+  std::vector<SecondOrderRaw> chained(kSections);
+  for (SecondOrderRaw& filter : chained) {
+    filter.SetParameters(0.1f, 0.7071f);
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    // Alternating buffers so that the last filter writes into the output
+    const float* filter_in(&input[0]);
+    for (unsigned int i(0); i < kSections; ++i) {
+      float* filter_out((kSections - i) % 2 == 1 ? &output[0] : &scratch[0]);
+      soundtailor::ProcessBlock(filter_in, filter_out, kBlockSize, chained[i]);
+      filter_in = filter_out;
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SosChainedBlock)->Apply(BlockSizes);
+
+/// @brief Second order sections cascade (8 sections, SampleSize channels)
+static void SosCascadeParallelBlock(benchmark::State& state) {
+  const std::size_t kLength(static_cast<std::size_t>(state.range(0)));
+  const unsigned int kSections(8);
+  const std::vector<float> input(MakeInput(kLength * SampleSize));
+  std::vector<float> output(kLength * SampleSize);
+  SosCascadeParallel cascade(kSections);
+  for (unsigned int i(0); i < kSections; ++i) {
+    cascade.SetSection(i, DesignBiquad(soundtailor::filters::kBiquadLowPass,
+                                       0.1f,
+                                       0.7071f));
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    cascade.ProcessBlock(&input[0], &output[0], kLength);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kLength * SampleSize, &counters);
+}
+BENCHMARK(SosCascadeParallelBlock)->Apply(BlockSizes);
+
+/// @brief Filter bank (32 bands), with an RMS follower if the second
+/// argument is set. Reported per input sample.
+static void FilterBankBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const bool kFollow(state.range(1) != 0);
+  const unsigned int kBands(32);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> bands(kBlockSize * kBands);
+  std::vector<float> envelopes(kBlockSize * kBands);
+  FilterBank bank(kBands);
+  bank.SetBands(0.001f, 0.4f, 8.0f);
+  bank.SetFollower(soundtailor::filters::kFollowerRms, 100.0f, 100.0f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    if (kFollow) {
+      bank.ProcessBlock(&input[0], &bands[0], &envelopes[0], kBlockSize);
+    } else {
+      bank.ProcessBlock(&input[0], &bands[0], kBlockSize);
+    }
+    benchmark::DoNotOptimize(bands.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(FilterBankBlock)->ArgsProduct({{64, 256, 1024}, {0, 1}});
+
+/// @brief Reference for the above: as many independent band pass filters,
+/// without followers
+static void FilterBankIndependentBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const unsigned int kBands(32);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> bands(kBlockSize * kBands);
+  std::vector<SosCascade> independents(kBands, SosCascade(1));
+  for (unsigned int band(0); band < kBands; ++band) {
+    const float kFrequency(0.001f * std::pow(400.0f,
+                                             band / (kBands - 1.0f)));
+    independents[band].SetSection(
+      0,
+      DesignBiquad(soundtailor::filters::kBiquadBandPass, kFrequency, 8.0f));
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (unsigned int band(0); band < kBands; ++band) {
+      independents[band].ProcessBlock(&input[0],
+                                      &bands[band * kBlockSize],
+                                      kBlockSize);
+    }
+    benchmark::DoNotOptimize(bands.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(FilterBankIndependentBlock)->Arg(64)->Arg(256)->Arg(1024);
+
+/// @brief Partitioned convolution of a one second (48kHz) impulse,
+/// partitions being uniform (of the block size) or not
+static void ProcessConvolver(benchmark::State& state, const bool uniform) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const std::size_t kImpulseSize(48000);
+  const std::vector<float> impulse(MakeInput(kImpulseSize));
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  Convolver convolver(uniform
+                      ? Convolver(&impulse[0],
+                                  kImpulseSize,
+                                  kBlockSize,
+                                  kBlockSize)
+                      : Convolver(&impulse[0], kImpulseSize, kBlockSize));
+  HardwareCounters counters;
+  for (auto _ : state) {
+    convolver.ProcessBlock(&input[0], &output[0], kBlockSize);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+
+/// @brief Non-uniform partitions, the convolver default
+static void ConvolverBlock(benchmark::State& state) {
+  ProcessConvolver(state, false);
+}
+BENCHMARK(ConvolverBlock)->Arg(64)->Arg(256)->Arg(1024);
+
+/// @brief Reference for the above: uniform partitions of the block size
+static void ConvolverUniformBlock(benchmark::State& state) {
+  ProcessConvolver(state, true);
+}
+BENCHMARK(ConvolverUniformBlock)->Arg(64)->Arg(256)->Arg(1024);
+
+/// @brief Waveshaper, for each shape given as first argument
+/// and anti-aliasing enabled if the second one is set
+static void WaveshaperBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(1024);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  Waveshaper waveshaper(
+    static_cast<soundtailor::filters::WaveshaperShape>(state.range(0)));
+  waveshaper.SetDrive(4.0f);
+  waveshaper.SetAntiAliasing(state.range(1) != 0);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    waveshaper.ProcessBlock(&input[0], &output[0], kBlockSize);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(WaveshaperBlock)
+  ->Args({soundtailor::filters::kWaveshaperHardClip, 0})
+  ->Args({soundtailor::filters::kWaveshaperHardClip, 1})
+  ->Args({soundtailor::filters::kWaveshaperSoftClipCubic, 0})
+  ->Args({soundtailor::filters::kWaveshaperSoftClipCubic, 1})
+  ->Args({soundtailor::filters::kWaveshaperTanh, 0});
+
+/// @brief Reference for the above: cubic soft clipping of one value at a
+/// time, broadcasted into a whole Sample
+static void SoftClipCubicPerValue(benchmark::State& state) {
+  const std::size_t kBlockSize(1024);
+  const std::vector<float> input(MakeInput(kBlockSize));
+  std::vector<float> output(kBlockSize);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kBlockSize; ++i) {
+      output[i] = VectorMath::GetFirst(soundtailor::filters::SoftClipCubic(
+        VectorMath::Fill(4.0f * input[i])));
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SoftClipCubicPerValue);
@@ -0,0 +1,252 @@
+/// @file bench_generators.cc
+/// @brief SoundTailor generators benchmarks
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::default_random_engine, std::uniform_real_distribution
+#include <random>
+#include <vector>
+
+#include "soundtailor/bench/bench.h"
+
+#include "soundtailor/src/generators/dpw.h"
+#include "soundtailor/src/generators/generators_common.h"
+#include "soundtailor/src/generators/pink_noise.h"
+#include "soundtailor/src/generators/sample_and_hold_noise.h"
+#include "soundtailor/src/generators/sawtooth_blit.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/sawtooth_unison.h"
+#include "soundtailor/src/generators/square_blit.h"
+#include "soundtailor/src/generators/triangle_dpw.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::Sample;
+using soundtailor::SampleSize;
+using soundtailor::VectorMath;
+using soundtailor::bench::BlockSizes;
+using soundtailor::bench::HardwareCounters;
+using soundtailor::bench::MakeInput;
+using soundtailor::bench::SetSampleCounters;
+using soundtailor::bench::kPerSampleLength;
+
+using soundtailor::generators::DPW;
+using soundtailor::generators::PhaseAccumulator;
+using soundtailor::generators::PinkNoise;
+using soundtailor::generators::SampleAndHoldNoise;
+using soundtailor::generators::SawtoothBLIT;
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::generators::SawtoothUnison;
+using soundtailor::generators::SquareBLIT;
+using soundtailor::generators::TriangleDPW;
+using soundtailor::generators::WhiteNoise;
+
+/// @brief Typical normalized frequency (440Hz at 48kHz)
+static const float kFrequency(440.0f / 48000.0f);
+
+/// @brief Set a typical frequency, for generators having one
+template <typename GeneratorType>
+static auto SetTypicalFrequency(GeneratorType* generator,
+                                int) -> decltype(generator->SetFrequency(
+                                                   kFrequency)) {
+  return generator->SetFrequency(kFrequency);
+}
+
+/// @brief Nothing to be done for the others (e.g. noise)
+template <typename GeneratorType>
+static void SetTypicalFrequency(GeneratorType* generator, long) {
+  soundtailor::IGNORE(generator);
+}
+
+/// @brief Per-Sample path: operator() called for each Sample
+template <typename GeneratorType>
+static void GeneratorPerSample(benchmark::State& state) {
+  GeneratorType generator;
+  SetTypicalFrequency(&generator, 0);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kPerSampleLength; i += SampleSize) {
+      Sample out(generator());
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  SetSampleCounters(state, kPerSampleLength, &counters);
+}
+
+/// @brief Block path, for the block size given as argument
+template <typename GeneratorType>
+static void GeneratorBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  GeneratorType generator;
+  SetTypicalFrequency(&generator, 0);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    soundtailor::ProcessBlock(&output[0], kBlockSize, generator);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+
+/// @brief Audio rate frequency modulation, for generators supporting it
+template <typename GeneratorType>
+static void GeneratorBlockFM(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> frequencies(MakeInput(kBlockSize));
+  for (float& frequency : frequencies) {
+    frequency = kFrequency * (1.0f + 0.1f * frequency);
+  }
+  std::vector<float> output(kBlockSize);
+  GeneratorType generator;
+  SetTypicalFrequency(&generator, 0);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    soundtailor::ProcessBlockFM(&frequencies[0],
+                                &output[0],
+                                kBlockSize,
+                                generator);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+
+#define SOUNDTAILOR_BENCH_GENERATOR(GeneratorType) \
+  BENCHMARK_TEMPLATE(GeneratorPerSample, GeneratorType); \
+  BENCHMARK_TEMPLATE(GeneratorBlock, GeneratorType)->Apply(BlockSizes)
+
+#define SOUNDTAILOR_BENCH_GENERATOR_FM(GeneratorType) \
+  SOUNDTAILOR_BENCH_GENERATOR(GeneratorType); \
+  BENCHMARK_TEMPLATE(GeneratorBlockFM, GeneratorType)->Apply(BlockSizes)
+
+SOUNDTAILOR_BENCH_GENERATOR_FM(DPW<3>);
+SOUNDTAILOR_BENCH_GENERATOR_FM(DPW<4>);
+SOUNDTAILOR_BENCH_GENERATOR_FM(PhaseAccumulator);
+SOUNDTAILOR_BENCH_GENERATOR_FM(SawtoothBLIT);
+SOUNDTAILOR_BENCH_GENERATOR_FM(SawtoothDPW);
+SOUNDTAILOR_BENCH_GENERATOR_FM(SquareBLIT);
+SOUNDTAILOR_BENCH_GENERATOR_FM(TriangleDPW);
+SOUNDTAILOR_BENCH_GENERATOR(PinkNoise);
+SOUNDTAILOR_BENCH_GENERATOR(SampleAndHoldNoise);
+SOUNDTAILOR_BENCH_GENERATOR(WhiteNoise);
+
+/// @brief Reference for the white noise: the standard library
+/// per-value generation
+static void StandardNoiseBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  std::default_random_engine engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (float& value : output) {
+      value = distribution(engine);
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(StandardNoiseBlock)->Apply(BlockSizes);
+
+/// @brief Two operators FM: a triangle modulator drives the frequency
+/// of a sawtooth carrier, with a modulation index of 1 at a 2:1 ratio
+static void FMPairPerSample(benchmark::State& state) {
+  const float kModulatorFrequency(0.5f * kFrequency);
+  TriangleDPW modulator;
+  SawtoothDPW carrier;
+  modulator.SetFrequency(kModulatorFrequency);
+  carrier.SetFrequency(kFrequency);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kPerSampleLength; i += SampleSize) {
+      const Sample kFrequencies(
+        VectorMath::Add(VectorMath::Fill(kFrequency),
+                        VectorMath::MulConst(kModulatorFrequency,
+                                             modulator())));
+      Sample out(carrier.ProcessFM(kFrequencies));
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  SetSampleCounters(state, kPerSampleLength, &counters);
+}
+BENCHMARK(FMPairPerSample);
+
+/// @brief Reference for the above: the same generators, unmodulated
+static void UnmodulatedPairPerSample(benchmark::State& state) {
+  TriangleDPW modulator;
+  SawtoothDPW carrier;
+  modulator.SetFrequency(0.5f * kFrequency);
+  carrier.SetFrequency(kFrequency);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kPerSampleLength; i += SampleSize) {
+      Sample out(VectorMath::Add(carrier(), modulator()));
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  SetSampleCounters(state, kPerSampleLength, &counters);
+}
+BENCHMARK(UnmodulatedPairPerSample);
+
+/// @brief Unison sawtooth, stereo, for the voices count given
+/// as second argument. Reported per output frame.
+static void SawtoothUnisonBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> left(kBlockSize);
+  std::vector<float> right(kBlockSize);
+  SawtoothUnison generator(static_cast<unsigned int>(state.range(1)));
+  generator.SetFrequency(kFrequency);
+  generator.SetDetune(0.5f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    generator.ProcessBlock(&left[0], &right[0], kBlockSize);
+    benchmark::DoNotOptimize(left.data());
+    benchmark::DoNotOptimize(right.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SawtoothUnisonBlock)->ArgsProduct({{64, 256, 1024}, {1, 7, 16}});
+
+/// @brief Reference for the above: as many separate SawtoothDPW instances,
+/// mixed into a single channel. Reported per output frame.
+static void SawtoothSeparateBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> voice(kBlockSize);
+  std::vector<float> mix(kBlockSize);
+  std::vector<SawtoothDPW> generators(
+    static_cast<std::size_t>(state.range(1)));
+  for (SawtoothDPW& generator : generators) {
+    generator.SetFrequency(kFrequency);
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    soundtailor::ProcessBlock(&mix[0], kBlockSize, generators[0]);
+    for (std::size_t i(1); i < generators.size(); ++i) {
+      soundtailor::ProcessBlock(&voice[0], kBlockSize, generators[i]);
+      for (std::size_t j(0); j < kBlockSize; ++j) {
+        mix[j] += voice[j];
+      }
+    }
+    benchmark::DoNotOptimize(mix.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SawtoothSeparateBlock)->ArgsProduct({{64, 256, 1024}, {1, 7, 16}});
@@ -0,0 +1,82 @@
+/// @file bench_io.cc
+/// @brief SoundTailor audio files I/O benchmarks
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/bench/bench.h"
+
+#include "soundtailor/src/io/wave_format.h"
+
+using soundtailor::bench::HardwareCounters;
+using soundtailor::bench::MakeInput;
+using soundtailor::bench::SetSampleCounters;
+
+using soundtailor::io::ConvertFromFloat;
+using soundtailor::io::ConvertToFloat;
+using soundtailor::io::GetBytesPerSample;
+using soundtailor::io::SampleFormat;
+
+/// @brief Length of the converted data, about one second at 48kHz
+static const std::size_t kConvertLength(48000);
+
+/// @brief Conversion of float samples into the format given as argument,
+/// as done when writing a file
+static void WaveConvertFromFloat(benchmark::State& state) {
+  const SampleFormat kFormat(static_cast<SampleFormat>(state.range(0)));
+  const std::vector<float> input(MakeInput(kConvertLength));
+  std::vector<unsigned char> output(kConvertLength
+                                    * GetBytesPerSample(kFormat));
+  HardwareCounters counters;
+  for (auto _ : state) {
+    ConvertFromFloat(&input[0], kConvertLength, kFormat, &output[0]);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kConvertLength, &counters);
+}
+
+/// @brief Conversion of samples in the format given as argument into
+/// floats, as done when reading a file
+static void WaveConvertToFloat(benchmark::State& state) {
+  const SampleFormat kFormat(static_cast<SampleFormat>(state.range(0)));
+  const std::vector<float> input(MakeInput(kConvertLength));
+  std::vector<unsigned char> converted(kConvertLength
+                                       * GetBytesPerSample(kFormat));
+  ConvertFromFloat(&input[0], kConvertLength, kFormat, &converted[0]);
+  std::vector<float> output(kConvertLength);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    ConvertToFloat(&converted[0], kConvertLength, kFormat, &output[0]);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kConvertLength, &counters);
+}
+
+/// @brief All supported formats
+static void SampleFormats(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(soundtailor::io::kSampleFormatInt16)
+           ->Arg(soundtailor::io::kSampleFormatInt24)
+           ->Arg(soundtailor::io::kSampleFormatInt32)
+           ->Arg(soundtailor::io::kSampleFormatFloat32);
+}
+
+BENCHMARK(WaveConvertFromFloat)->Apply(SampleFormats);
+BENCHMARK(WaveConvertToFloat)->Apply(SampleFormats);
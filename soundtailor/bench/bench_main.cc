@@ -0,0 +1,64 @@
+/// @file bench_main.cc
+/// @brief SoundTailor benchmarks entry point
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::fprintf
+#include <cstdio>
+// std::strcmp
+#include <cstring>
+
+#include "benchmark/benchmark.h"
+
+#include "soundtailor/bench/hardware_counters.h"
+
+using soundtailor::bench::HardwareCounters;
+
+/// @brief Google Benchmark default entry point, with an additional flag:
+/// "--perf_counters" enables hardware counters (Linux only)
+int main(int argc, char** argv) {
+  // Own flags are removed before handing arguments to Google Benchmark
+  int kept_count(1);
+  for (int i(1); i < argc; ++i) {
+    if (std::strcmp(argv[i], "--perf_counters") == 0) {
+      HardwareCounters::SetEnabled(true);
+    } else {
+      argv[kept_count] = argv[i];
+      kept_count += 1;
+    }
+  }
+  argc = kept_count;
+
+  if (HardwareCounters::IsEnabled()) {
+    HardwareCounters probe;
+    probe.Stop();
+    if (!probe.IsAvailable(HardwareCounters::kCycles)) {
+      std::fprintf(stderr,
+                   "Hardware counters unavailable (no PMU access?), see "
+                   "/proc/sys/kernel/perf_event_paranoid\n");
+    }
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
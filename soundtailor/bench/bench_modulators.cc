@@ -0,0 +1,312 @@
+/// @file bench_modulators.cc
+/// @brief SoundTailor modulators benchmarks
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::exp
+#include <cmath>
+#include <vector>
+
+#include "soundtailor/bench/bench.h"
+
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/modulators/adsd.h"
+#include "soundtailor/src/modulators/adsd_bank.h"
+#include "soundtailor/src/modulators/adsr.h"
+#include "soundtailor/src/modulators/lfo.h"
+#include "soundtailor/src/modulators/modulation_matrix.h"
+#include "soundtailor/src/modulators/smoothed_parameter.h"
+
+using soundtailor::Sample;
+using soundtailor::SampleSize;
+using soundtailor::VectorMath;
+using soundtailor::bench::BlockSizes;
+using soundtailor::bench::HardwareCounters;
+using soundtailor::bench::SetSampleCounters;
+
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::modulators::Adsd;
+using soundtailor::modulators::AdsdBank;
+using soundtailor::modulators::Adsr;
+using soundtailor::modulators::Lfo;
+using soundtailor::modulators::ModulationMatrix;
+using soundtailor::modulators::SmoothedParameter;
+
+/// @brief Length of a whole envelop cycle: each iteration goes through
+/// all sections (attack, decay, sustain, release and zero)
+static const std::size_t kCycleLength(4096);
+static const unsigned int kAttack(512);
+static const unsigned int kDecay(512);
+static const std::size_t kTriggerOffPosition(2560);
+
+/// @brief Whole envelop cycle, operator() called for each Sample
+template <typename EnvelopType>
+static void EnvelopPerSample(benchmark::State& state) {
+  EnvelopType envelop;
+  envelop.SetParameters(kAttack, kDecay, kDecay, 0.5f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    envelop.TriggerOn();
+    for (std::size_t i(0); i < kCycleLength; i += SampleSize) {
+      if (i == kTriggerOffPosition) {
+        envelop.TriggerOff();
+      }
+      Sample out(envelop());
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  SetSampleCounters(state, kCycleLength, &counters);
+}
+
+/// @brief Whole envelop cycle, by blocks of the size given as argument
+template <typename EnvelopType>
+static void EnvelopBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  EnvelopType envelop;
+  envelop.SetParameters(kAttack, kDecay, kDecay, 0.5f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    envelop.TriggerOn();
+    for (std::size_t i(0); i < kCycleLength; i += kBlockSize) {
+      if (i <= kTriggerOffPosition && kTriggerOffPosition < i + kBlockSize) {
+        envelop.TriggerOff();
+      }
+      soundtailor::ProcessBlock(&output[0], kBlockSize, envelop);
+      benchmark::DoNotOptimize(output.data());
+      benchmark::ClobberMemory();
+    }
+  }
+  SetSampleCounters(state, kCycleLength, &counters);
+}
+
+BENCHMARK_TEMPLATE(EnvelopPerSample, Adsd);
+BENCHMARK_TEMPLATE(EnvelopBlock, Adsd)->Apply(BlockSizes);
+BENCHMARK_TEMPLATE(EnvelopPerSample, Adsr);
+BENCHMARK_TEMPLATE(EnvelopBlock, Adsr)->Apply(BlockSizes);
+
+/// @brief Bank of 16 envelops, one sample of each per time step.
+/// Reported per sample of each envelop.
+static void AdsdBankBlock(benchmark::State& state) {
+  const unsigned int kVoices(16);
+  const std::size_t kLength(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kLength * kVoices);
+  AdsdBank<kVoices> bank;
+  for (unsigned int voice(0); voice < kVoices; ++voice) {
+    bank.SetParameters(voice, kAttack, kDecay, kDecay, 0.5f);
+    bank.TriggerOn(voice);
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    bank.ProcessBlock(&output[0], kLength);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kLength * kVoices, &counters);
+}
+BENCHMARK(AdsdBankBlock)->Apply(BlockSizes);
+
+/// @brief Reference for the above: as many separate envelops,
+/// one sample of each computed per time step
+static void AdsdSeparateBlock(benchmark::State& state) {
+  const unsigned int kVoices(16);
+  const std::size_t kLength(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kLength * kVoices);
+  std::vector<Adsd> envelops(kVoices);
+  for (Adsd& envelop : envelops) {
+    envelop.SetParameters(kAttack, kDecay, kDecay, 0.5f);
+    envelop.TriggerOn();
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kLength; ++i) {
+      for (unsigned int voice(0); voice < kVoices; ++voice) {
+        output[i * kVoices + voice] = envelops[voice].ComputeOneSample();
+      }
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kLength * kVoices, &counters);
+}
+BENCHMARK(AdsdSeparateBlock)->Apply(BlockSizes);
+
+/// @brief Low frequency oscillator block generation, for the waveform
+/// and rate given as arguments
+static void LfoBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  Lfo lfo(static_cast<soundtailor::modulators::LfoWaveform>(state.range(1)));
+  lfo.SetRate(static_cast<soundtailor::modulators::LfoRate>(state.range(2)));
+  lfo.SetFrequency(5.0f / 48000.0f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    lfo.ProcessBlock(&output[0], kBlockSize);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(LfoBlock)->ArgsProduct({
+  {64, 1024},
+  {soundtailor::modulators::kLfoSine,
+   soundtailor::modulators::kLfoTriangle,
+   soundtailor::modulators::kLfoSawtooth,
+   soundtailor::modulators::kLfoSquare,
+   soundtailor::modulators::kLfoSampleAndHold},
+  {soundtailor::modulators::kLfoAudioRate,
+   soundtailor::modulators::kLfoControlRate}});
+
+/// @brief Modulation matrix with 8 LFO sources fully routed to
+/// 16 destinations, half of them at audio rate. Reported per block sample.
+static void ModulationMatrixProcess(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const unsigned int kSources(8);
+  const unsigned int kDestinations(ModulationMatrix::kMaxDestinations);
+  std::vector<Lfo> lfos(kSources);
+  ModulationMatrix matrix(kBlockSize);
+  float sink(0.0f);
+  for (unsigned int source(0); source < kSources; ++source) {
+    lfos[source].SetFrequency((source + 1) / 48000.0f);
+    Lfo* lfo(&lfos[source]);
+    matrix.AddSource([lfo](std::size_t length) {
+      return lfo->ProcessControl(length);
+    });
+  }
+  for (unsigned int destination(0);
+       destination < kDestinations;
+       ++destination) {
+    matrix.AddDestination(
+      [&sink](float value) { sink += value; },
+      0.0f,
+      -16.0f,
+      16.0f,
+      destination % 2 == 0 ? soundtailor::modulators::kDestinationControlRate
+                           : soundtailor::modulators::kDestinationAudioRate);
+    for (unsigned int source(0); source < kSources; ++source) {
+      matrix.SetRoute(source, destination, 0.5f);
+    }
+  }
+  HardwareCounters counters;
+  for (auto _ : state) {
+    matrix.Process(kBlockSize);
+    benchmark::DoNotOptimize(sink);
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(ModulationMatrixProcess)->Apply(BlockSizes);
+
+/// @brief Typical modulated oscillator: a LFO drives a SawtoothDPW
+/// frequency, through the modulation matrix once per block
+static void MatrixModulatedOscillator(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const float kBaseFrequency(0.01f);
+  std::vector<float> output(kBlockSize);
+  Lfo lfo;
+  lfo.SetFrequency(5.0f / 48000.0f);
+  SawtoothDPW generator;
+  ModulationMatrix matrix(kBlockSize);
+  const unsigned int kSource(matrix.AddSource([&lfo](std::size_t length) {
+    return lfo.ProcessControl(length);
+  }));
+  const unsigned int kDestination(matrix.AddDestination(
+    [&generator](float value) { generator.SetFrequency(value); },
+    kBaseFrequency,
+    0.0f,
+    0.5f,
+    soundtailor::modulators::kDestinationControlRate));
+  matrix.SetRoute(kSource, kDestination, 0.5f * kBaseFrequency);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    matrix.Process(kBlockSize);
+    soundtailor::ProcessBlock(&output[0], kBlockSize, generator);
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(MatrixModulatedOscillator)->Apply(BlockSizes);
+
+/// @brief Reference for the above: frequency updated for each Sample
+static void PerSampleModulatedOscillator(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  const float kBaseFrequency(0.01f);
+  std::vector<float> output(kBlockSize);
+  Lfo lfo;
+  lfo.SetFrequency(5.0f / 48000.0f);
+  SawtoothDPW generator;
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (std::size_t i(0); i < kBlockSize; i += SampleSize) {
+      const float kModulation(VectorMath::GetFirst(lfo()));
+      generator.SetFrequency(kBaseFrequency * (1.0f + 0.5f * kModulation));
+      VectorMath::Store(&output[i], generator());
+    }
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(PerSampleModulatedOscillator)->Apply(BlockSizes);
+
+/// @brief Parameter smoothing, for the smoothing type given as argument.
+/// Each iteration retargets the parameter, so that it is always moving
+static void SmoothedParameterBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  SmoothedParameter parameter(
+    static_cast<soundtailor::modulators::SmoothingType>(state.range(1)),
+    1.0f);
+  parameter.SetTime(100000.0f);
+  float target(2.0f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    parameter.SetTarget(target);
+    parameter.ProcessBlock(&output[0], kBlockSize);
+    target = 3.0f - target;
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(SmoothedParameterBlock)->ArgsProduct({
+  {64, 1024},
+  {soundtailor::modulators::kSmoothingLinear,
+   soundtailor::modulators::kSmoothingOnePole,
+   soundtailor::modulators::kSmoothingMultiplicative}});
+
+/// @brief Reference for the one pole smoothing: a per-sample scalar filter
+static void OnePoleScalarBlock(benchmark::State& state) {
+  const std::size_t kBlockSize(static_cast<std::size_t>(state.range(0)));
+  std::vector<float> output(kBlockSize);
+  const float kPole(static_cast<float>(std::exp(-1.0 / 100000.0)));
+  float value(1.0f);
+  float target(2.0f);
+  HardwareCounters counters;
+  for (auto _ : state) {
+    for (float& out : output) {
+      value = target + (value - target) * kPole;
+      out = value;
+    }
+    target = 3.0f - target;
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  SetSampleCounters(state, kBlockSize, &counters);
+}
+BENCHMARK(OnePoleScalarBlock)->Arg(64)->Arg(1024);
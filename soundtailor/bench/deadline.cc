@@ -0,0 +1,337 @@
+/// @file deadline.cc
+/// @brief Real-time deadline profiling of parameter-automated scenarios
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min, std::max
+#include <algorithm>
+// std::chrono
+#include <chrono>
+// std::exp, std::log
+#include <cmath>
+// std::strtof, std::strtoul
+#include <cstdlib>
+// std::strncmp
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "soundtailor/bench/deadline_profiler.h"
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/utilities.h"
+#include "soundtailor/src/filters/convolver.h"
+#include "soundtailor/src/filters/moog.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/generators/sawtooth_blit.h"
+#include "soundtailor/src/generators/white_noise.h"
+#include "soundtailor/src/modulators/adsd.h"
+
+using soundtailor::bench::DeadlineProfiler;
+
+using soundtailor::filters::Convolver;
+using soundtailor::filters::Moog;
+using soundtailor::filters::SecondOrderRaw;
+using soundtailor::filters::StateVariable;
+using soundtailor::generators::SawtoothBLIT;
+using soundtailor::generators::WhiteNoise;
+using soundtailor::modulators::Adsd;
+
+/// @brief Profiling settings, from the command line
+struct Settings {
+  std::size_t block_size;
+  float sampling_rate;
+  float duration;  ///< Rendered duration of each scenario, in seconds
+  bool histogram;  ///< Print the whole histogram of each scenario
+
+  std::size_t GetBlocksCount(void) const {
+    return static_cast<std::size_t>(duration * sampling_rate) / block_size;
+  }
+  /// @brief Time of the beginning of the given block, in seconds
+  float GetTime(const std::size_t block) const {
+    return static_cast<float>(block * block_size) / sampling_rate;
+  }
+};
+
+/// @brief Count of different input blocks, rendered beforehand
+static const std::size_t kInputBlocksCount(64);
+
+/// @brief Exponential sweep between the given frequencies (in Hz),
+/// back and forth every 2 seconds, normalized by the sampling rate
+static float Sweep(const Settings& settings,
+                   const std::size_t block,
+                   const float low,
+                   const float high) {
+  const float kPeriod(2.0f);
+  const float kPosition(std::fmod(settings.GetTime(block), 2.0f * kPeriod)
+                        / kPeriod);
+  const float kRatio(kPosition < 1.0f ? kPosition : 2.0f - kPosition);
+  return low * std::exp(kRatio * std::log(high / low))
+         / settings.sampling_rate;
+}
+
+/// @brief Frequency clamped within the given filter range
+template <typename FilterType>
+static float ClampFrequency(const float frequency) {
+  return std::min(std::max(frequency, FilterType::Meta().freq_min),
+                  FilterType::Meta().freq_max);
+}
+
+/// @brief Render the given scenario block by block, timing each one of them
+///
+/// The renderer is called with the current block index and output buffer;
+/// all parameters changes happening at this block have to be done within
+/// this call, since they are part of the block processing cost.
+template <typename Renderer>
+static void Profile(const char* name,
+                    const Settings& settings,
+                    Renderer&& render) {
+  DeadlineProfiler profiler(settings.block_size, settings.sampling_rate);
+  std::vector<float> out(settings.block_size);
+  float sink(0.0f);
+  for (std::size_t block(0); block < settings.GetBlocksCount(); ++block) {
+    const std::chrono::steady_clock::time_point kBegin(
+      std::chrono::steady_clock::now());
+    render(block, &out[0]);
+    const std::chrono::steady_clock::time_point kEnd(
+      std::chrono::steady_clock::now());
+    profiler.Record(static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        kEnd - kBegin).count()));
+    // Prevents the rendering from being optimized out
+    sink += out[block % settings.block_size];
+  }
+  profiler.PrintSummary(name, std::cout);
+  if (settings.histogram) {
+    profiler.PrintHistogram(std::cout);
+  }
+  if (sink == 42.0f) {
+    std::cerr << std::endl;
+  }
+}
+
+/// @brief Filter noise while its cutoff frequency is swept at each block
+template <typename FilterType>
+static void ProfileFilterSweep(const char* name,
+                               const Settings& settings,
+                               const std::vector<float>& input) {
+  FilterType filter;
+  const float kResonance(0.5f * (FilterType::Meta().res_min
+                                 + FilterType::Meta().res_max));
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    filter.SetParameters(
+      ClampFrequency<FilterType>(Sweep(settings, block, 20.0f, 8000.0f)),
+      kResonance);
+    soundtailor::ProcessBlock(
+      &input[(block % kInputBlocksCount) * settings.block_size],
+      out,
+      settings.block_size,
+      filter);
+  });
+}
+
+/// @brief Resonant filter excited by a short noise burst every second,
+/// then fed with silence: its decaying tail may go through denormals
+template <typename FilterType>
+static void ProfileFilterTail(const char* name,
+                              const Settings& settings,
+                              const std::vector<float>& input) {
+  FilterType filter;
+  filter.SetParameters(ClampFrequency<FilterType>(200.0f
+                                                  / settings.sampling_rate),
+                       0.9f * FilterType::Meta().res_max);
+  const std::vector<float> kSilence(settings.block_size, 0.0f);
+  const std::size_t kBlocksPerSecond(
+    static_cast<std::size_t>(settings.sampling_rate) / settings.block_size);
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    const bool kBurst(block % std::max(kBlocksPerSecond,
+                                       static_cast<std::size_t>(1)) == 0);
+    soundtailor::ProcessBlock(kBurst ? &input[0] : &kSilence[0],
+                              out,
+                              settings.block_size,
+                              filter);
+  });
+}
+
+/// @brief Short notes, triggered 8 times per second:
+/// all envelop sections are gone through
+static void ProfileEnvelopNotes(const char* name, const Settings& settings) {
+  Adsd envelop;
+  const unsigned int kMs(static_cast<unsigned int>(settings.sampling_rate
+                                                   / 1000.0f));
+  envelop.SetParameters(5 * kMs, 40 * kMs, 40 * kMs, 0.5f);
+  const std::size_t kNoteLength(
+    static_cast<std::size_t>(settings.sampling_rate / 8.0f));
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    const std::size_t kBegin(block * settings.block_size);
+    const std::size_t kEnd(kBegin + settings.block_size);
+    // Events are applied at the beginning of the block they fall into
+    if (kBegin / kNoteLength != kEnd / kNoteLength || block == 0) {
+      envelop.TriggerOn();
+    }
+    if ((kBegin + kNoteLength / 2) / kNoteLength
+        != (kEnd + kNoteLength / 2) / kNoteLength) {
+      envelop.TriggerOff();
+    }
+    soundtailor::ProcessBlock(out, settings.block_size, envelop);
+  });
+}
+
+/// @brief Oscillator with its frequency glided at each block
+static void ProfileOscillatorGlide(const char* name,
+                                   const Settings& settings) {
+  SawtoothBLIT oscillator;
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    oscillator.SetFrequency(Sweep(settings, block, 40.0f, 4000.0f));
+    soundtailor::ProcessBlock(out, settings.block_size, oscillator);
+  });
+}
+
+/// @brief Simple synthesizer voice: oscillator through a low pass filter,
+/// its cutoff frequency modulated by an envelop, notes 8 times per second
+static void ProfileVoice(const char* name, const Settings& settings) {
+  SawtoothBLIT oscillator;
+  Moog filter;
+  Adsd envelop;
+  const unsigned int kMs(static_cast<unsigned int>(settings.sampling_rate
+                                                   / 1000.0f));
+  envelop.SetParameters(2 * kMs, 60 * kMs, 60 * kMs, 0.2f);
+  oscillator.SetFrequency(110.0f / settings.sampling_rate);
+  const std::size_t kNoteLength(
+    static_cast<std::size_t>(settings.sampling_rate / 8.0f));
+  std::vector<float> modulation(settings.block_size);
+  std::vector<float> oscillation(settings.block_size);
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    const std::size_t kBegin(block * settings.block_size);
+    if (kBegin / kNoteLength
+        != (kBegin + settings.block_size) / kNoteLength || block == 0) {
+      envelop.TriggerOn();
+    }
+    soundtailor::ProcessBlock(&modulation[0], settings.block_size, envelop);
+    soundtailor::ProcessBlock(&oscillation[0],
+                              settings.block_size,
+                              oscillator);
+    // Control rate modulation: once per block
+    const float kCutoff((200.0f + 6000.0f * modulation[0])
+                        / settings.sampling_rate);
+    filter.SetParameters(ClampFrequency<Moog>(kCutoff), 2.0f);
+    soundtailor::ProcessBlock(&oscillation[0],
+                              out,
+                              settings.block_size,
+                              filter);
+  });
+}
+
+/// @brief Noise convolved by a 2 seconds reverberation impulse response
+///
+/// Biggest partitions are the most expensive to compute: their cost has to be
+/// spread across blocks for not to show up as periodic spikes
+static void ProfileConvolver(const char* name,
+                             const Settings& settings,
+                             const std::vector<float>& input) {
+  if (settings.block_size & (settings.block_size - 1)) {
+    std::cout << name << ": skipped (block size is not a power of 2)"
+              << std::endl;
+    return;
+  }
+  // Exponentially decaying noise, -60dB at its end
+  const std::size_t kImpulseSize(
+    static_cast<std::size_t>(2.0f * settings.sampling_rate)
+    / soundtailor::SampleSize * soundtailor::SampleSize);
+  std::vector<float> impulse(kImpulseSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&impulse[0], kImpulseSize, noise);
+  for (std::size_t i(0); i < kImpulseSize; ++i) {
+    impulse[i] *= std::exp(-6.9f * static_cast<float>(i) / kImpulseSize);
+  }
+  Convolver convolver(&impulse[0], kImpulseSize, settings.block_size);
+  Profile(name, settings, [&](const std::size_t block, float* out) {
+    convolver.ProcessBlock(
+      &input[(block % kInputBlocksCount) * settings.block_size],
+      out,
+      settings.block_size);
+  });
+}
+
+/// @brief Parse "--name=value" arguments, return false on any unknown one
+static bool ParseArguments(const int argc, char** argv, Settings* settings) {
+  for (int i(1); i < argc; ++i) {
+    const std::string kArgument(argv[i]);
+    const std::size_t kSeparator(kArgument.find('='));
+    const std::string kName(kArgument.substr(0, kSeparator));
+    const char* kValue(kSeparator == std::string::npos
+                       ? ""
+                       : argv[i] + kSeparator + 1);
+    if (kName == "--block_size") {
+      settings->block_size = std::strtoul(kValue, nullptr, 10);
+    } else if (kName == "--sampling_rate") {
+      settings->sampling_rate = std::strtof(kValue, nullptr);
+    } else if (kName == "--duration") {
+      settings->duration = std::strtof(kValue, nullptr);
+    } else if (kName == "--histogram") {
+      settings->histogram = true;
+    } else {
+      return false;
+    }
+  }
+  return settings->block_size > 0
+         && settings->block_size % soundtailor::SampleSize == 0
+         && settings->sampling_rate > 0.0f
+         && settings->GetBlocksCount() > 0;
+}
+
+int main(int argc, char** argv) {
+  Settings settings = {256, 48000.0f, 60.0f, false};
+  if (!ParseArguments(argc, argv, &settings)) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--block_size=256] [--sampling_rate=48000]"
+              << " [--duration=60] [--histogram]" << std::endl
+              << "Block size has to be a multiple of "
+              << soundtailor::SampleSize << std::endl;
+    return 1;
+  }
+
+  std::vector<float> input(kInputBlocksCount * settings.block_size);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], input.size(), noise);
+
+  DeadlineProfiler budget(settings.block_size, settings.sampling_rate);
+  std::cout << settings.block_size << " samples blocks at "
+            << settings.sampling_rate << "Hz, budget: "
+            << budget.GetBudget() * 1e-3 << "us, "
+            << settings.GetBlocksCount() << " blocks per scenario"
+            << std::endl
+            << "Scenario                               p50   (budget)"
+            << "         p99   (budget)       p99.9   (budget)"
+            << "         max   (budget) overruns" << std::endl;
+
+  ProfileFilterSweep<SecondOrderRaw>("SecondOrderRaw sweep", settings, input);
+  ProfileFilterSweep<StateVariable>("StateVariable sweep", settings, input);
+  ProfileFilterSweep<Moog>("Moog sweep", settings, input);
+  ProfileFilterTail<SecondOrderRaw>("SecondOrderRaw tail", settings, input);
+  ProfileFilterTail<StateVariable>("StateVariable tail", settings, input);
+  ProfileFilterTail<Moog>("Moog tail", settings, input);
+  ProfileEnvelopNotes("Adsd notes", settings);
+  ProfileOscillatorGlide("SawtoothBLIT glide", settings);
+  ProfileVoice("Voice", settings);
+  ProfileConvolver("Convolver 2s reverb", settings, input);
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+/// @file deadline_profiler.cc
+/// @brief Real-time deadline profiler - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min
+#include <algorithm>
+// std::log2, std::pow
+#include <cmath>
+// std::setw
+#include <iomanip>
+#include <ostream>
+
+#include "soundtailor/src/common.h"
+
+#include "soundtailor/bench/deadline_profiler.h"
+
+namespace soundtailor {
+namespace bench {
+
+DeadlineProfiler::DeadlineProfiler(const std::size_t block_size,
+                                   const float sampling_rate)
+    : budget_(1e9 * static_cast<double>(block_size) / sampling_rate),
+      histogram_(kBucketsPerOctave * kOctavesCount, 0),
+      blocks_count_(0),
+      overruns_count_(0),
+      max_(0) {
+  SOUNDTAILOR_ASSERT(block_size > 0);
+  SOUNDTAILOR_ASSERT(sampling_rate > 0.0f);
+}
+
+void DeadlineProfiler::Record(const std::uint64_t block_time) {
+  histogram_[GetBucket(block_time)] += 1;
+  blocks_count_ += 1;
+  if (block_time > budget_) {
+    overruns_count_ += 1;
+  }
+  if (block_time > max_) {
+    max_ = block_time;
+  }
+}
+
+void DeadlineProfiler::Reset(void) {
+  histogram_.assign(histogram_.size(), 0);
+  blocks_count_ = 0;
+  overruns_count_ = 0;
+  max_ = 0;
+}
+
+double DeadlineProfiler::GetPercentile(const double proportion) const {
+  SOUNDTAILOR_ASSERT(proportion >= 0.0);
+  SOUNDTAILOR_ASSERT(proportion <= 1.0);
+  if (blocks_count_ == 0) {
+    return 0.0;
+  }
+  // Rank of the wanted block, as if all of them were sorted
+  const double kRank(proportion * static_cast<double>(blocks_count_));
+  std::size_t count(0);
+  for (unsigned int bucket(0); bucket < histogram_.size(); ++bucket) {
+    count += histogram_[bucket];
+    if (static_cast<double>(count) >= kRank && count > 0) {
+      return std::min(GetBucketUpperBound(bucket),
+                      static_cast<double>(max_));
+    }
+  }
+  return static_cast<double>(max_);
+}
+
+std::uint64_t DeadlineProfiler::GetMax(void) const {
+  return max_;
+}
+
+double DeadlineProfiler::GetBudget(void) const {
+  return budget_;
+}
+
+std::size_t DeadlineProfiler::GetBlocksCount(void) const {
+  return blocks_count_;
+}
+
+std::size_t DeadlineProfiler::GetOverrunsCount(void) const {
+  return overruns_count_;
+}
+
+void DeadlineProfiler::PrintSummary(const char* name,
+                                    std::ostream& stream) const {
+  const double kPercentiles[] = {GetPercentile(0.5),
+                                 GetPercentile(0.99),
+                                 GetPercentile(0.999),
+                                 static_cast<double>(max_)};
+  stream << std::left << std::setw(32) << name << std::right;
+  for (const double percentile : kPercentiles) {
+    stream << std::fixed << std::setprecision(2)
+           << std::setw(10) << percentile * 1e-3 << "us"
+           << std::setw(8) << 100.0 * percentile / budget_ << "%";
+  }
+  stream << std::setw(8) << overruns_count_ << std::endl;
+}
+
+void DeadlineProfiler::PrintHistogram(std::ostream& stream) const {
+  for (unsigned int bucket(0); bucket < histogram_.size(); ++bucket) {
+    if (histogram_[bucket] > 0) {
+      const double kLowerBound(bucket > 0
+                               ? GetBucketUpperBound(bucket - 1)
+                               : 0.0);
+      stream << std::fixed << std::setprecision(0)
+             << kLowerBound << " " << GetBucketUpperBound(bucket)
+             << " " << histogram_[bucket] << std::endl;
+    }
+  }
+}
+
+unsigned int DeadlineProfiler::GetBucket(const std::uint64_t block_time) {
+  if (block_time <= 1) {
+    return 0;
+  }
+  const double kPosition(std::log2(static_cast<double>(block_time))
+                         * kBucketsPerOctave);
+  const unsigned int kBucket(static_cast<unsigned int>(kPosition));
+  return std::min(kBucket, kBucketsPerOctave * kOctavesCount - 1);
+}
+
+double DeadlineProfiler::GetBucketUpperBound(const unsigned int bucket) {
+  return std::pow(2.0, static_cast<double>(bucket + 1) / kBucketsPerOctave);
+}
+
+}  // namespace bench
+}  // namespace soundtailor
@@ -0,0 +1,89 @@
+/// @file deadline_profiler.h
+/// @brief Real-time deadline profiler: per-block processing time histogram
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_BENCH_DEADLINE_PROFILER_H_
+#define SOUNDTAILOR_BENCH_DEADLINE_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace soundtailor {
+namespace bench {
+
+/// @brief Record the processing time of each rendered block,
+/// and compare its distribution with the real-time budget
+///
+/// Times are stored in a log-scaled histogram: each octave is split into
+/// kBucketsPerOctave buckets, hence percentiles have a relative precision
+/// of about 9% whatever the magnitude. The maximum is kept exactly.
+class DeadlineProfiler {
+ public:
+  /// @brief Histogram resolution
+  static const unsigned int kBucketsPerOctave = 8;
+  /// @brief Recorded times are clamped to 2^kOctavesCount nanoseconds
+  static const unsigned int kOctavesCount = 36;
+
+  /// @brief Real-time budget is the duration of block_size samples
+  /// at the given sampling rate
+  DeadlineProfiler(const std::size_t block_size, const float sampling_rate);
+
+  /// @brief Record the processing time of one block, in nanoseconds
+  void Record(const std::uint64_t block_time);
+  /// @brief Clear all recorded times
+  void Reset(void);
+
+  /// @brief Block processing time below which lies the given proportion
+  /// (within [0.0 ; 1.0]) of all recorded blocks, in nanoseconds
+  ///
+  /// This is the upper bound of the matching histogram bucket
+  /// (or the maximum, if lower).
+  double GetPercentile(const double proportion) const;
+  /// @brief Worst case block processing time, in nanoseconds
+  std::uint64_t GetMax(void) const;
+  /// @brief Real-time budget for a single block, in nanoseconds
+  double GetBudget(void) const;
+  std::size_t GetBlocksCount(void) const;
+  /// @brief Count of blocks which took longer than the budget
+  std::size_t GetOverrunsCount(void) const;
+
+  /// @brief Write p50/p99/p99.9/max, both in microseconds
+  /// and as a proportion of the budget, on a single line
+  void PrintSummary(const char* name, std::ostream& stream) const;
+  /// @brief Write all non-empty buckets, one per line:
+  /// lower bound (ns), upper bound (ns), count
+  void PrintHistogram(std::ostream& stream) const;
+
+ private:
+  static unsigned int GetBucket(const std::uint64_t block_time);
+  static double GetBucketUpperBound(const unsigned int bucket);
+
+  double budget_;
+  std::vector<std::size_t> histogram_;
+  std::size_t blocks_count_;
+  std::size_t overruns_count_;
+  std::uint64_t max_;
+};
+
+}  // namespace bench
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_BENCH_DEADLINE_PROFILER_H_
@@ -0,0 +1,187 @@
+/// @file hardware_counters.cc
+/// @brief Hardware performance counters - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  // std::memset
+  #include <cstring>
+#endif  // defined(__linux__)
+
+#include "soundtailor/src/common.h"
+
+#include "soundtailor/bench/hardware_counters.h"
+
+namespace soundtailor {
+namespace bench {
+
+static bool enabled(false);
+
+#if defined(__linux__)
+
+/// @brief perf_event_open type and config of each event
+static const struct {
+  std::uint32_t type;
+  std::uint64_t config;
+} kEventsConfigs[HardwareCounters::kEventsCount] = {
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                       | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                       | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL
+                       | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                       | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+/// @brief Open a disabled counter for the given event on the calling thread,
+/// return -1 on failure
+static int OpenEvent(const HardwareCounters::Event event) {
+  perf_event_attr attributes;
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = kEventsConfigs[event].type;
+  attributes.config = kEventsConfigs[event].config;
+  attributes.disabled = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                           | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(__NR_perf_event_open,
+                                  &attributes,
+                                  0,  // Calling thread
+                                  -1,  // Any CPU
+                                  -1,  // No group
+                                  0));
+}
+
+#endif  // defined(__linux__)
+
+HardwareCounters::HardwareCounters()
+    : descriptors_(),
+      values_(),
+      stopped_(false) {
+  for (unsigned int event(0); event < kEventsCount; ++event) {
+    descriptors_[event] = -1;
+#if defined(__linux__)
+    if (enabled) {
+      descriptors_[event] = OpenEvent(static_cast<Event>(event));
+    }
+#endif  // defined(__linux__)
+  }
+#if defined(__linux__)
+  // Started as late (and all at once) as possible
+  for (const int descriptor : descriptors_) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif  // defined(__linux__)
+}
+
+HardwareCounters::~HardwareCounters() {
+#if defined(__linux__)
+  for (const int descriptor : descriptors_) {
+    if (descriptor >= 0) {
+      close(descriptor);
+    }
+  }
+#endif  // defined(__linux__)
+}
+
+void HardwareCounters::Stop(void) {
+  if (stopped_) {
+    return;
+  }
+  stopped_ = true;
+#if defined(__linux__)
+  for (const int descriptor : descriptors_) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (unsigned int event(0); event < kEventsCount; ++event) {
+    if (descriptors_[event] < 0) {
+      continue;
+    }
+    // Value, time enabled, time running
+    std::uint64_t data[3] = {0, 0, 0};
+    const ssize_t kRead(read(descriptors_[event], data, sizeof(data)));
+    if (kRead != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+      // Never actually counted, e.g. not supported by the hardware
+      close(descriptors_[event]);
+      descriptors_[event] = -1;
+      continue;
+    }
+    values_[event] = static_cast<double>(data[0])
+                     * static_cast<double>(data[1])
+                     / static_cast<double>(data[2]);
+  }
+#endif  // defined(__linux__)
+}
+
+bool HardwareCounters::IsAvailable(const Event event) const {
+  return descriptors_[event] >= 0;
+}
+
+double HardwareCounters::Get(const Event event) const {
+  SOUNDTAILOR_ASSERT(stopped_);
+  return values_[event];
+}
+
+const char* HardwareCounters::GetName(const Event event) {
+  switch (event) {
+    case(kCycles): {
+      return "cycles";
+    }
+    case(kInstructions): {
+      return "instructions";
+    }
+    case(kL1DataMisses): {
+      return "l1d_misses";
+    }
+    case(kLastLevelMisses): {
+      return "llc_misses";
+    }
+    case(kBranchMisses): {
+      return "branch_misses";
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      return "";
+    }
+  }  // switch(event)
+}
+
+void HardwareCounters::SetEnabled(const bool enable) {
+  enabled = enable;
+}
+
+bool HardwareCounters::IsEnabled(void) {
+  return enabled;
+}
+
+}  // namespace bench
+}  // namespace soundtailor
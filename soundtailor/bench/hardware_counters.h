@@ -0,0 +1,79 @@
+/// @file hardware_counters.h
+/// @brief Hardware performance counters, using Linux perf_event_open
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_BENCH_HARDWARE_COUNTERS_H_
+#define SOUNDTAILOR_BENCH_HARDWARE_COUNTERS_H_
+
+#include <cstdint>
+
+namespace soundtailor {
+namespace bench {
+
+/// @brief Count hardware events of the calling thread (user space only)
+/// from construction to Stop()
+///
+/// Only available on Linux, and when globally enabled (see SetEnabled()):
+/// otherwise, or if the kernel denies access to some event, the matching
+/// counters are reported as unavailable.
+/// Events are opened independently, hence if the hardware has to multiplex
+/// them their values are extrapolated to the whole counting duration.
+class HardwareCounters {
+ public:
+  enum Event {
+    kCycles = 0,
+    kInstructions,
+    kL1DataMisses,  ///< L1 data cache read misses
+    /// Last level cache read misses: there is no generic L2 event,
+    /// it matches L2 on processors without L3
+    kLastLevelMisses,
+    kBranchMisses,
+    kEventsCount
+  };
+
+  /// @brief Start counting all available events
+  HardwareCounters();
+  ~HardwareCounters();
+
+  /// @brief Stop counting, and read all counters values
+  void Stop(void);
+  bool IsAvailable(const Event event) const;
+  /// @brief Value of the given counter since construction,
+  /// only valid after Stop()
+  double Get(const Event event) const;
+
+  /// @brief Short name of the given event, e.g. "cycles"
+  static const char* GetName(const Event event);
+  /// @brief Globally enable counting - disabled by default
+  static void SetEnabled(const bool enabled);
+  static bool IsEnabled(void);
+
+ private:
+  HardwareCounters(const HardwareCounters&) = delete;
+  HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+  int descriptors_[kEventsCount];  ///< -1 for unavailable events
+  double values_[kEventsCount];
+  bool stopped_;
+};
+
+}  // namespace bench
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_BENCH_HARDWARE_COUNTERS_H_
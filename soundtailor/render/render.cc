@@ -0,0 +1,225 @@
+/// @file render.cc
+/// @brief Offline batch rendering of a score into float WAV files
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min, std::max
+#include <algorithm>
+#include <atomic>
+// std::chrono
+#include <chrono>
+// std::strtoul
+#include <cstdlib>
+#include <fstream>
+// std::cref
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "soundtailor/src/io/wave_file.h"
+
+#include "soundtailor/render/renderer.h"
+#include "soundtailor/render/score.h"
+
+using soundtailor::render::ParseScore;
+using soundtailor::render::Render;
+using soundtailor::render::Renderer;
+using soundtailor::render::Score;
+
+/// @brief Command line settings
+struct Settings {
+  unsigned int threads_count;
+  std::string output_directory;
+  std::string score_filename;
+  bool verbose;  ///< Print a line per render
+};
+
+/// @brief Outcome of one render
+struct Result {
+  bool written;
+  double audio_duration;  ///< Rendered duration, in seconds
+  double processing_duration;  ///< Time spent rendering, in seconds
+};
+
+/// @brief Write a mono 32 bits float WAV file
+static bool WriteWaveFile(const std::string& filename,
+                          const float* data,
+                          const std::size_t length,
+                          const float sampling_rate,
+                          soundtailor::io::WaveFileWriter* writer) {
+  const soundtailor::io::WaveFormat kFormat = {
+    soundtailor::io::kSampleFormatFloat32,
+    1,
+    static_cast<unsigned int>(sampling_rate)
+  };
+  if (!writer->Open(filename, kFormat)) {
+    return false;
+  }
+  const bool kWritten(writer->Write(data, length));
+  return writer->Close() && kWritten;
+}
+
+/// @brief Render and write scores renders until there is none left
+///
+/// Each worker takes the next render not yet taken by any other one:
+/// longer renders do not stall the others.
+static void RenderWorker(const Score& score,
+                         const Settings& settings,
+                         std::atomic<std::size_t>* next_render,
+                         std::vector<Result>* results) {
+  Renderer renderer(score.sampling_rate, score.block_size);
+  // Reused for all renders of this worker
+  soundtailor::io::WaveFileWriter writer;
+  std::vector<float> buffer;
+  std::size_t index(next_render->fetch_add(1));
+  while (index < score.renders.size()) {
+    const Render& render(score.renders[index]);
+    const std::chrono::steady_clock::time_point kBegin(
+      std::chrono::steady_clock::now());
+    const std::size_t kLength(renderer.Process(render, &buffer));
+    const std::chrono::duration<double> kDuration(
+      std::chrono::steady_clock::now() - kBegin);
+
+    const std::string kFilename(
+      (settings.output_directory.empty() || render.filename[0] == '/')
+      ? render.filename
+      : settings.output_directory + "/" + render.filename);
+    Result& result((*results)[index]);
+    result.written = WriteWaveFile(kFilename,
+                                   &buffer[0],
+                                   kLength,
+                                   score.sampling_rate,
+                                   &writer);
+    result.audio_duration = kLength / static_cast<double>(score.sampling_rate);
+    result.processing_duration = kDuration.count();
+    index = next_render->fetch_add(1);
+  }
+}
+
+/// @brief Parse "--name=value" arguments and the score filename,
+/// return false on any unknown or missing one
+static bool ParseArguments(const int argc, char** argv, Settings* settings) {
+  for (int i(1); i < argc; ++i) {
+    const std::string kArgument(argv[i]);
+    const std::size_t kSeparator(kArgument.find('='));
+    const std::string kName(kArgument.substr(0, kSeparator));
+    const char* kValue(kSeparator == std::string::npos
+                       ? ""
+                       : argv[i] + kSeparator + 1);
+    if (kName == "--threads") {
+      settings->threads_count = std::strtoul(kValue, nullptr, 10);
+    } else if (kName == "--output_dir") {
+      settings->output_directory = kValue;
+    } else if (kName == "--verbose") {
+      settings->verbose = true;
+    } else if (kName.compare(0, 2, "--") != 0
+               && settings->score_filename.empty()) {
+      settings->score_filename = kArgument;
+    } else {
+      return false;
+    }
+  }
+  return settings->threads_count > 0 && !settings->score_filename.empty();
+}
+
+int main(int argc, char** argv) {
+  Settings settings = {
+    std::max(std::thread::hardware_concurrency(), 1u),
+    "",
+    "",
+    false
+  };
+  if (!ParseArguments(argc, argv, &settings)) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--threads=" << settings.threads_count << "]"
+              << " [--output_dir=.] [--verbose] score_file" << std::endl;
+    return 1;
+  }
+
+  std::ifstream input(settings.score_filename.c_str());
+  if (!input) {
+    std::cerr << "Cannot open " << settings.score_filename << std::endl;
+    return 1;
+  }
+  Score score;
+  std::string error;
+  if (!ParseScore(input, &score, &error)) {
+    std::cerr << settings.score_filename << ", " << error << std::endl;
+    return 1;
+  }
+
+  if (score.renders.empty()) {
+    std::cerr << "Nothing to render" << std::endl;
+    return 0;
+  }
+
+  // No need for more threads than renders
+  const unsigned int kThreadsCount(static_cast<unsigned int>(
+    std::min(static_cast<std::size_t>(settings.threads_count),
+             score.renders.size())));
+  std::vector<Result> results(score.renders.size());
+  std::atomic<std::size_t> next_render(0);
+  const std::chrono::steady_clock::time_point kBegin(
+    std::chrono::steady_clock::now());
+  std::vector<std::thread> workers;
+  for (unsigned int i(0); i < kThreadsCount; ++i) {
+    workers.push_back(std::thread(RenderWorker,
+                                  std::cref(score),
+                                  std::cref(settings),
+                                  &next_render,
+                                  &results));
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  const std::chrono::duration<double> kWallDuration(
+    std::chrono::steady_clock::now() - kBegin);
+
+  double audio_duration(0.0);
+  double processing_duration(0.0);
+  unsigned int failures_count(0);
+  for (std::size_t i(0); i < results.size(); ++i) {
+    const Result& result(results[i]);
+    if (!result.written) {
+      std::cerr << "Cannot write " << score.renders[i].filename << std::endl;
+      failures_count += 1;
+    }
+    if (settings.verbose) {
+      std::cout << score.renders[i].filename << ": "
+                << result.audio_duration << "s rendered in "
+                << result.processing_duration << "s ("
+                << result.audio_duration / result.processing_duration
+                << "x realtime)" << std::endl;
+    }
+    audio_duration += result.audio_duration;
+    processing_duration += result.processing_duration;
+  }
+
+  std::cout << results.size() << " renders, " << audio_duration
+            << "s of audio in " << kWallDuration.count() << "s with "
+            << kThreadsCount << " threads: "
+            << audio_duration / kWallDuration.count() << "x realtime"
+            << std::endl
+            << "Rendering only (file writes excluded), per thread: "
+            << audio_duration / processing_duration << "x realtime"
+            << std::endl;
+
+  return failures_count > 0 ? 1 : 0;
+}
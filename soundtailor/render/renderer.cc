@@ -0,0 +1,192 @@
+/// @file renderer.cc
+/// @brief Offline renderer of a score - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min, std::max
+#include <algorithm>
+// std::pow, std::ceil
+#include <cmath>
+
+#include "soundtailor/src/utilities.h"
+#include "soundtailor/src/filters/moog.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/generators/sawtooth_blit.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/square_blit.h"
+#include "soundtailor/src/generators/triangle_dpw.h"
+#include "soundtailor/src/modulators/adsr.h"
+
+#include "soundtailor/render/renderer.h"
+
+namespace soundtailor {
+namespace render {
+
+/// @brief Highest oscillator frequency, relative to the sampling rate
+static const float kMaxFrequency(0.45f);
+
+Renderer::Renderer(const float sampling_rate, const std::size_t block_size)
+    : sampling_rate_(sampling_rate),
+      block_size_(block_size),
+      envelop_(block_size),
+      oscillation_(block_size),
+      filtered_(block_size) {
+  SOUNDTAILOR_ASSERT(sampling_rate > 0.0f);
+  SOUNDTAILOR_ASSERT(block_size > 0);
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+}
+
+std::size_t Renderer::Process(const Render& render, std::vector<float>* out) {
+  SOUNDTAILOR_ASSERT(out != nullptr);
+  const std::size_t kLength(GetLength(render.duration));
+  // Padding: voices always render whole Samples,
+  // from wherever their note begins
+  out->assign(kLength + block_size_, 0.0f);
+  for (const Note& note : render.notes) {
+    switch (render.patch.oscillator) {
+      case(kOscillatorSawtoothBLIT): {
+        SelectFilter<generators::SawtoothBLIT>(render.patch,
+                                               note,
+                                               kLength,
+                                               &(*out)[0]);
+        break;
+      }
+      case(kOscillatorSawtoothDPW): {
+        SelectFilter<generators::SawtoothDPW>(render.patch,
+                                              note,
+                                              kLength,
+                                              &(*out)[0]);
+        break;
+      }
+      case(kOscillatorSquareBLIT): {
+        SelectFilter<generators::SquareBLIT>(render.patch,
+                                             note,
+                                             kLength,
+                                             &(*out)[0]);
+        break;
+      }
+      case(kOscillatorTriangleDPW): {
+        SelectFilter<generators::TriangleDPW>(render.patch,
+                                              note,
+                                              kLength,
+                                              &(*out)[0]);
+        break;
+      }
+      default: {
+        // Should never happen
+        SOUNDTAILOR_ASSERT(false);
+      }
+    }  // switch(oscillator)
+  }
+  return kLength;
+}
+
+std::size_t Renderer::GetLength(const float duration) const {
+  return static_cast<std::size_t>(std::ceil(duration * sampling_rate_));
+}
+
+template <typename GeneratorType>
+void Renderer::SelectFilter(const Patch& patch,
+                            const Note& note,
+                            const std::size_t length,
+                            float* out) {
+  switch (patch.filter) {
+    case(kFilterMoog): {
+      ProcessNote<GeneratorType, filters::Moog>(patch, note, length, out);
+      break;
+    }
+    case(kFilterSecondOrderRaw): {
+      ProcessNote<GeneratorType, filters::SecondOrderRaw>(patch,
+                                                          note,
+                                                          length,
+                                                          out);
+      break;
+    }
+    case(kFilterStateVariable): {
+      ProcessNote<GeneratorType, filters::StateVariable>(patch,
+                                                         note,
+                                                         length,
+                                                         out);
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(filter)
+}
+
+template <typename GeneratorType, typename FilterModel>
+void Renderer::ProcessNote(const Patch& patch,
+                           const Note& note,
+                           const std::size_t length,
+                           float* out) {
+  const float kMs(sampling_rate_ / 1000.0f);
+  modulators::Adsr envelop;
+  envelop.SetParameters(static_cast<unsigned int>(patch.attack * kMs),
+                        static_cast<unsigned int>(patch.decay * kMs),
+                        static_cast<unsigned int>(patch.release * kMs),
+                        patch.sustain);
+  GeneratorType oscillator;
+  const float kFrequency(440.0f * std::pow(2.0f, (note.pitch - 69) / 12.0f));
+  oscillator.SetFrequency(std::min(kFrequency / sampling_rate_,
+                                   kMaxFrequency));
+  FilterModel filter;
+  const float kFreqMin(FilterModel::Meta().freq_min);
+  const float kFreqMax(std::min(FilterModel::Meta().freq_max, kMaxFrequency));
+  const float kAmplitude(patch.gain * note.velocity);
+
+  std::size_t position(GetLength(note.start));
+  const std::size_t kNoteOff(position + GetLength(note.length));
+  bool gate(true);
+  envelop.TriggerOn();
+  while (position < length) {
+    std::size_t chunk(block_size_);
+    if (gate) {
+      if (position >= kNoteOff) {
+        envelop.TriggerOff();
+        gate = false;
+      } else {
+        // Stops at the note off, rounded up to a whole Sample
+        const std::size_t kRemaining(kNoteOff - position);
+        chunk = std::min(chunk,
+                         (kRemaining + SampleSize - 1)
+                         / SampleSize * SampleSize);
+      }
+    } else if (modulators::kZero == envelop.GetCurrentSection()) {
+      break;
+    }
+
+    ProcessBlock(&envelop_[0], chunk, envelop);
+    ProcessBlock(&oscillation_[0], chunk, oscillator);
+    // Control rate cutoff modulation: once per chunk
+    const float kCutoff((patch.cutoff + patch.envelop_amount * envelop_[0])
+                        / sampling_rate_);
+    filter.SetParameters(std::min(std::max(kCutoff, kFreqMin), kFreqMax),
+                         patch.resonance);
+    ProcessBlock(&oscillation_[0], &filtered_[0], chunk, filter);
+    for (std::size_t i(0); i < chunk; ++i) {
+      out[position + i] += kAmplitude * envelop_[i] * filtered_[i];
+    }
+    position += chunk;
+  }
+}
+
+}  // namespace render
+}  // namespace soundtailor
@@ -0,0 +1,77 @@
+/// @file renderer.h
+/// @brief Offline renderer of a score
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_RENDER_RENDERER_H_
+#define SOUNDTAILOR_RENDER_RENDERER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "soundtailor/render/score.h"
+
+namespace soundtailor {
+namespace render {
+
+/// @brief Render each note of a Render with its own voice, mixed together
+///
+/// Parameters are updated at control rate: the filter cutoff follows the
+/// envelop once per block, note off events are quantized to SampleSize.
+/// Internal buffers are kept from one render to the other:
+/// one instance per thread is expected.
+class Renderer {
+ public:
+  Renderer(const float sampling_rate, const std::size_t block_size);
+
+  /// @brief Render all notes into the given buffer
+  ///
+  /// @param[in]  render   Notes and patch to render
+  /// @param[out]  out   Output buffer, resized as needed (and padded)
+  ///
+  /// @return Count of meaningful samples in the output buffer
+  std::size_t Process(const Render& render, std::vector<float>* out);
+
+  /// @brief Count of samples for the given duration
+  std::size_t GetLength(const float duration) const;
+
+ private:
+  /// @brief Render one note, added to the output
+  template <typename GeneratorType, typename FilterModel>
+  void ProcessNote(const Patch& patch,
+                   const Note& note,
+                   const std::size_t length,
+                   float* out);
+  /// @brief Instantiate the voice matching the patch filter
+  template <typename GeneratorType>
+  void SelectFilter(const Patch& patch,
+                    const Note& note,
+                    const std::size_t length,
+                    float* out);
+
+  float sampling_rate_;
+  std::size_t block_size_;
+  std::vector<float> envelop_;
+  std::vector<float> oscillation_;
+  std::vector<float> filtered_;
+};
+
+}  // namespace render
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_RENDER_RENDERER_H_
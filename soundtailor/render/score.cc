@@ -0,0 +1,321 @@
+/// @file score.cc
+/// @brief Patch and score description for offline rendering - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <istream>
+#include <map>
+#include <sstream>
+
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/filters/moog.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/state_variable.h"
+
+#include "soundtailor/render/score.h"
+
+namespace soundtailor {
+namespace render {
+
+/// @brief Current parsing context
+enum Block {
+  kBlockNone = 0,
+  kBlockPatch,
+  kBlockRender
+};
+
+/// @brief Named values, for keywords lookup
+template <typename Type>
+struct Keyword {
+  const char* name;
+  Type value;
+};
+
+static const Keyword<OscillatorType> kOscillators[] = {
+  {"sawtooth_blit", kOscillatorSawtoothBLIT},
+  {"sawtooth_dpw", kOscillatorSawtoothDPW},
+  {"square_blit", kOscillatorSquareBLIT},
+  {"triangle_dpw", kOscillatorTriangleDPW}
+};
+
+static const Keyword<FilterType> kFilters[] = {
+  {"moog", kFilterMoog},
+  {"secondorder_raw", kFilterSecondOrderRaw},
+  {"state_variable", kFilterStateVariable}
+};
+
+/// @brief Find the value of the given keyword, return false if unknown
+template <typename Type, std::size_t kCount>
+static bool Lookup(const Keyword<Type> (&keywords)[kCount],
+                   const std::string& name,
+                   Type* value) {
+  for (const Keyword<Type>& keyword : keywords) {
+    if (name == keyword.name) {
+      *value = keyword.value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief Resonance range of the given filter
+static void GetResonanceRange(const FilterType filter,
+                              float* min,
+                              float* max) {
+  switch (filter) {
+    case(kFilterMoog): {
+      *min = filters::Moog::Meta().res_min;
+      *max = filters::Moog::Meta().res_max;
+      break;
+    }
+    case(kFilterSecondOrderRaw): {
+      *min = filters::SecondOrderRaw::Meta().res_min;
+      *max = filters::SecondOrderRaw::Meta().res_max;
+      break;
+    }
+    case(kFilterStateVariable): {
+      *min = filters::StateVariable::Meta().res_min;
+      *max = filters::StateVariable::Meta().res_max;
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(filter)
+}
+
+/// @brief Read all remaining arguments of a line,
+/// return false if any is missing, invalid or in excess
+template <typename... Types>
+static bool ReadArguments(std::istringstream* line, Types*... values) {
+  const bool kRead[] = {static_cast<bool>(*line >> *values)...};
+  for (const bool read : kRead) {
+    if (!read) {
+      return false;
+    }
+  }
+  std::string excess;
+  return !(*line >> excess);
+}
+
+/// @brief Check the validity of a patch once fully defined
+static bool CheckPatch(const Patch& patch, std::string* error) {
+  float res_min(0.0f);
+  float res_max(0.0f);
+  GetResonanceRange(patch.filter, &res_min, &res_max);
+  if (patch.resonance < res_min || patch.resonance > res_max) {
+    std::ostringstream message;
+    message << "resonance out of the filter range [" << res_min
+            << " ; " << res_max << "]";
+    *error = message.str();
+    return false;
+  }
+  if (patch.cutoff <= 0.0f) {
+    *error = "cutoff frequency has to be positive";
+    return false;
+  }
+  if (patch.attack < 0.0f || patch.decay < 0.0f || patch.release < 0.0f) {
+    *error = "envelop times cannot be negative";
+    return false;
+  }
+  if (patch.sustain < 0.0f || patch.sustain > 1.0f) {
+    *error = "sustain level has to be within [0.0 ; 1.0]";
+    return false;
+  }
+  return true;
+}
+
+/// @brief Check the validity of a note
+static bool CheckNote(const Note& note, std::string* error) {
+  if (note.start < 0.0f || note.length < 0.0f) {
+    *error = "note start and length cannot be negative";
+    return false;
+  }
+  if (note.pitch < 0 || note.pitch > 127) {
+    *error = "note pitch has to be within [0 ; 127]";
+    return false;
+  }
+  if (note.velocity < 0.0f || note.velocity > 1.0f) {
+    *error = "note velocity has to be within [0.0 ; 1.0]";
+    return false;
+  }
+  return true;
+}
+
+/// @brief Parse one line of a patch definition
+static bool ParsePatchLine(const std::string& keyword,
+                           std::istringstream* line,
+                           Patch* patch,
+                           std::string* error) {
+  if (keyword == "oscillator") {
+    std::string name;
+    if (!ReadArguments(line, &name)
+        || !Lookup(kOscillators, name, &patch->oscillator)) {
+      *error = "unknown oscillator";
+      return false;
+    }
+  } else if (keyword == "filter") {
+    std::string name;
+    if (!ReadArguments(line, &name, &patch->cutoff, &patch->resonance)
+        || !Lookup(kFilters, name, &patch->filter)) {
+      *error = "expected: filter <type> <cutoff> <resonance>";
+      return false;
+    }
+  } else if (keyword == "envelop") {
+    if (!ReadArguments(line,
+                       &patch->attack,
+                       &patch->decay,
+                       &patch->sustain,
+                       &patch->release)) {
+      *error = "expected: envelop <attack> <decay> <sustain> <release>";
+      return false;
+    }
+  } else if (keyword == "envelop_amount") {
+    if (!ReadArguments(line, &patch->envelop_amount)) {
+      *error = "expected: envelop_amount <frequency>";
+      return false;
+    }
+  } else if (keyword == "gain") {
+    if (!ReadArguments(line, &patch->gain)) {
+      *error = "expected: gain <value>";
+      return false;
+    }
+  } else {
+    *error = "unknown patch parameter '" + keyword + "'";
+    return false;
+  }
+  return true;
+}
+
+Patch DefaultPatch(void) {
+  const Patch out = {
+    kOscillatorSawtoothBLIT,
+    kFilterMoog,
+    1000.0f,
+    0.0f,
+    5.0f,
+    100.0f,
+    1.0f,
+    100.0f,
+    0.0f,
+    1.0f
+  };
+  return out;
+}
+
+bool ParseScore(std::istream& input, Score* score, std::string* error) {
+  SOUNDTAILOR_ASSERT(score != nullptr);
+  SOUNDTAILOR_ASSERT(error != nullptr);
+
+  score->sampling_rate = 48000.0f;
+  score->block_size = 256;
+  score->renders.clear();
+  std::map<std::string, Patch> patches;
+  Block block(kBlockNone);
+  std::string patch_name;
+  Patch patch(DefaultPatch());
+  std::string line_content;
+  unsigned int line_index(0);
+  std::string line_error;
+  while (std::getline(input, line_content)) {
+    line_index += 1;
+    std::istringstream line(line_content.substr(0,
+                                                line_content.find('#')));
+    std::string keyword;
+    if (!(line >> keyword)) {
+      continue;
+    }
+    line_error.clear();
+    if (keyword == "end") {
+      if (block == kBlockPatch) {
+        if (CheckPatch(patch, &line_error)) {
+          patches[patch_name] = patch;
+        }
+      } else if (block == kBlockNone) {
+        line_error = "'end' outside of any patch or render";
+      }
+      block = kBlockNone;
+    } else if (block == kBlockPatch) {
+      ParsePatchLine(keyword, &line, &patch, &line_error);
+    } else if (block == kBlockRender) {
+      Note note = {0.0f, 0.0f, 0, 0.0f};
+      if (keyword != "note"
+          || !ReadArguments(&line,
+                            &note.start,
+                            &note.length,
+                            &note.pitch,
+                            &note.velocity)) {
+        line_error = "expected: note <start> <length> <pitch> <velocity>";
+      } else if (CheckNote(note, &line_error)) {
+        score->renders.back().notes.push_back(note);
+      }
+    } else if (keyword == "sampling_rate") {
+      if (!ReadArguments(&line, &score->sampling_rate)
+          || score->sampling_rate <= 0.0f) {
+        line_error = "expected: sampling_rate <positive value>";
+      }
+    } else if (keyword == "block_size") {
+      if (!ReadArguments(&line, &score->block_size)
+          || score->block_size == 0
+          || score->block_size % SampleSize != 0) {
+        std::ostringstream message;
+        message << "expected: block_size <multiple of " << SampleSize << ">";
+        line_error = message.str();
+      }
+    } else if (keyword == "patch") {
+      if (!ReadArguments(&line, &patch_name)) {
+        line_error = "expected: patch <name>";
+      }
+      patch = DefaultPatch();
+      block = kBlockPatch;
+    } else if (keyword == "render") {
+      Render render;
+      render.duration = 0.0f;
+      if (!ReadArguments(&line,
+                         &render.filename,
+                         &render.patch_name,
+                         &render.duration)
+          || render.duration <= 0.0f) {
+        line_error = "expected: render <file> <patch> <positive duration>";
+      } else if (patches.find(render.patch_name) == patches.end()) {
+        line_error = "undefined patch '" + render.patch_name + "'";
+      } else {
+        render.patch = patches[render.patch_name];
+        score->renders.push_back(render);
+        block = kBlockRender;
+      }
+    } else {
+      line_error = "unknown keyword '" + keyword + "'";
+    }
+    if (!line_error.empty()) {
+      std::ostringstream message;
+      message << "line " << line_index << ": " << line_error;
+      *error = message.str();
+      return false;
+    }
+  }
+  if (block != kBlockNone) {
+    *error = "missing 'end' at the end of the score";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace render
+}  // namespace soundtailor
@@ -0,0 +1,124 @@
+/// @file score.h
+/// @brief Patch and score description for offline rendering
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_RENDER_SCORE_H_
+#define SOUNDTAILOR_RENDER_SCORE_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace soundtailor {
+namespace render {
+
+/// @brief Available oscillators
+enum OscillatorType {
+  kOscillatorSawtoothBLIT = 0,
+  kOscillatorSawtoothDPW,
+  kOscillatorSquareBLIT,
+  kOscillatorTriangleDPW
+};
+
+/// @brief Available filters
+enum FilterType {
+  kFilterMoog = 0,
+  kFilterSecondOrderRaw,
+  kFilterStateVariable
+};
+
+/// @brief Simple subtractive synthesizer voice:
+/// oscillator through a filter, amplitude shaped by an envelop which
+/// also modulates the filter cutoff
+struct Patch {
+  OscillatorType oscillator;
+  FilterType filter;
+  float cutoff;  ///< Filter cutoff frequency, in Hz
+  float resonance;  ///< Filter resonance, within its own range
+  float attack;  ///< Envelop attack time, in ms
+  float decay;  ///< Envelop decay time, in ms
+  float sustain;  ///< Envelop sustain level, in [0.0 ; 1.0]
+  float release;  ///< Envelop release time, in ms
+  float envelop_amount;  ///< Cutoff modulation at full envelop, in Hz
+  float gain;  ///< Output gain
+};
+
+/// @brief One note of a render
+struct Note {
+  float start;  ///< Note on time, in seconds
+  float length;  ///< Time between note on and note off, in seconds
+  int pitch;  ///< MIDI note number, 69 being A4 (440Hz)
+  float velocity;  ///< In [0.0 ; 1.0]
+};
+
+/// @brief One output file: notes played with the given patch
+struct Render {
+  std::string filename;
+  std::string patch_name;
+  Patch patch;
+  float duration;  ///< Total duration, in seconds
+  std::vector<Note> notes;
+};
+
+/// @brief A whole score: settings shared by all independent renders
+struct Score {
+  float sampling_rate;
+  std::size_t block_size;
+  std::vector<Render> renders;
+};
+
+/// @brief Default patch parameters: plain sawtooth through an open
+/// Moog filter, short attack and release, full sustain
+Patch DefaultPatch(void);
+
+/// @brief Parse a score description, line by line
+///
+/// Empty lines and lines beginning with '#' are ignored.
+/// Global settings, patches and renders may be given in any order,
+/// but a patch has to be defined before any render using it:
+///
+///     sampling_rate 48000
+///     block_size 256
+///
+///     patch bass
+///       oscillator sawtooth_blit   # sawtooth_dpw, square_blit, triangle_dpw
+///       filter moog 800 2.0        # secondorder_raw, state_variable
+///       envelop 5 200 0.5 300      # attack, decay (ms), sustain, release (ms)
+///       envelop_amount 2000        # cutoff modulation (Hz)
+///       gain 0.5
+///     end
+///
+///     render bass_c2.wav bass 2.0  # output file, patch, duration (s)
+///       note 0.0 1.5 36 1.0        # start (s), length (s), pitch, velocity
+///     end
+///
+/// Unspecified patch parameters keep their DefaultPatch() value.
+///
+/// @param[in]  input   Score description
+/// @param[out]  score   Parsed score
+/// @param[out]  error   Description of the first error, if any
+///
+/// @return false on any syntax error or out of range value
+bool ParseScore(std::istream& input, Score* score, std::string* error);
+
+}  // namespace render
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_RENDER_SCORE_H_
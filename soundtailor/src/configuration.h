@@ -43,6 +43,19 @@
   #define _SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG 1
 #endif  // defined(NDEBUG) ?
 
+/// @brief Hot path instrumentation (counters and cycle timers),
+/// see instrumentation.h: disabled unless explicitly required
+#ifndef _SOUNDTAILOR_INSTRUMENTATION
+  #define _SOUNDTAILOR_INSTRUMENTATION 0
+#endif  // _SOUNDTAILOR_INSTRUMENTATION ?
+
+/// @brief Memory mapped files availability (POSIX mmap)
+#if(defined(__unix__) || defined(__APPLE__))
+  #define _SOUNDTAILOR_HAS_MMAP 1
+#else
+  #define _SOUNDTAILOR_HAS_MMAP 0
+#endif  // defined(__unix__) ?
+
 /// @brief Architecture detection - compiler specific preprocessor macros
 #if _SOUNDTAILOR__COMPILER_MSVC
   #if defined(_M_IX86)
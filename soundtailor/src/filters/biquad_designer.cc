@@ -0,0 +1,153 @@
+/// @file biquad_designer.cc
+/// @brief Second order sections coefficients design - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::sin, std::cos, std::pow, std::sqrt
+#include <cmath>
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/biquad_designer.h"
+
+namespace soundtailor {
+namespace filters {
+
+BiquadCoefficients BiquadIdentity(void) {
+  const BiquadCoefficients out = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  return out;
+}
+
+BiquadCoefficients DesignBiquad(const BiquadType type,
+                                const float frequency,
+                                const float resonance,
+                                const float gain) {
+  SOUNDTAILOR_ASSERT(frequency > 0.0f);
+  SOUNDTAILOR_ASSERT(frequency < 0.5f);
+  SOUNDTAILOR_ASSERT(resonance > 0.0f);
+
+  // Computations done in double since precision is crucial here
+  const double kAmplitude(std::pow(10.0, static_cast<double>(gain) / 40.0));
+  const double kOmega(2.0 * Pi * static_cast<double>(frequency));
+  const double kSinOmega(std::sin(kOmega));
+  const double kCosOmega(std::cos(kOmega));
+  const double kAlpha(kSinOmega / (2.0 * static_cast<double>(resonance)));
+  const double kShelfAlpha(2.0 * std::sqrt(kAmplitude) * kAlpha);
+
+  double b0(1.0);
+  double b1(0.0);
+  double b2(0.0);
+  double a0(1.0);
+  double a1(0.0);
+  double a2(0.0);
+  switch (type) {
+    case(kBiquadLowPass): {
+      b0 = (1.0 - kCosOmega) / 2.0;
+      b1 = 1.0 - kCosOmega;
+      b2 = (1.0 - kCosOmega) / 2.0;
+      a0 = 1.0 + kAlpha;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha;
+      break;
+    }
+    case(kBiquadHighPass): {
+      b0 = (1.0 + kCosOmega) / 2.0;
+      b1 = -(1.0 + kCosOmega);
+      b2 = (1.0 + kCosOmega) / 2.0;
+      a0 = 1.0 + kAlpha;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha;
+      break;
+    }
+    case(kBiquadBandPass): {
+      b0 = kAlpha;
+      b1 = 0.0;
+      b2 = -kAlpha;
+      a0 = 1.0 + kAlpha;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha;
+      break;
+    }
+    case(kBiquadNotch): {
+      b0 = 1.0;
+      b1 = -2.0 * kCosOmega;
+      b2 = 1.0;
+      a0 = 1.0 + kAlpha;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha;
+      break;
+    }
+    case(kBiquadAllPass): {
+      b0 = 1.0 - kAlpha;
+      b1 = -2.0 * kCosOmega;
+      b2 = 1.0 + kAlpha;
+      a0 = 1.0 + kAlpha;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha;
+      break;
+    }
+    case(kBiquadPeaking): {
+      b0 = 1.0 + kAlpha * kAmplitude;
+      b1 = -2.0 * kCosOmega;
+      b2 = 1.0 - kAlpha * kAmplitude;
+      a0 = 1.0 + kAlpha / kAmplitude;
+      a1 = -2.0 * kCosOmega;
+      a2 = 1.0 - kAlpha / kAmplitude;
+      break;
+    }
+    case(kBiquadLowShelf): {
+      const double kPlus(kAmplitude + 1.0);
+      const double kMinus(kAmplitude - 1.0);
+      b0 = kAmplitude * (kPlus - kMinus * kCosOmega + kShelfAlpha);
+      b1 = 2.0 * kAmplitude * (kMinus - kPlus * kCosOmega);
+      b2 = kAmplitude * (kPlus - kMinus * kCosOmega - kShelfAlpha);
+      a0 = kPlus + kMinus * kCosOmega + kShelfAlpha;
+      a1 = -2.0 * (kMinus + kPlus * kCosOmega);
+      a2 = kPlus + kMinus * kCosOmega - kShelfAlpha;
+      break;
+    }
+    case(kBiquadHighShelf): {
+      const double kPlus(kAmplitude + 1.0);
+      const double kMinus(kAmplitude - 1.0);
+      b0 = kAmplitude * (kPlus + kMinus * kCosOmega + kShelfAlpha);
+      b1 = -2.0 * kAmplitude * (kMinus + kPlus * kCosOmega);
+      b2 = kAmplitude * (kPlus + kMinus * kCosOmega - kShelfAlpha);
+      a0 = kPlus - kMinus * kCosOmega + kShelfAlpha;
+      a1 = 2.0 * (kMinus - kPlus * kCosOmega);
+      a2 = kPlus - kMinus * kCosOmega - kShelfAlpha;
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(type)
+
+  // Normalized coefficients
+  const BiquadCoefficients out = {
+    static_cast<float>(b0 / a0),
+    static_cast<float>(b1 / a0),
+    static_cast<float>(b2 / a0),
+    static_cast<float>(a1 / a0),
+    static_cast<float>(a2 / a0)
+  };
+  return out;
+}
+
+}  // namespace filters
+}  // namespace soundtailor
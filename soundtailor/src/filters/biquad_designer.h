@@ -0,0 +1,68 @@
+/// @file biquad_designer.h
+/// @brief Second order sections coefficients design (Audio EQ Cookbook)
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_BIQUAD_DESIGNER_H_
+#define SOUNDTAILOR_SRC_FILTERS_BIQUAD_DESIGNER_H_
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Available second order section responses
+enum BiquadType {
+  kBiquadLowPass = 0,
+  kBiquadHighPass,
+  kBiquadBandPass,  ///< Constant 0dB peak gain
+  kBiquadNotch,
+  kBiquadAllPass,
+  kBiquadPeaking,
+  kBiquadLowShelf,
+  kBiquadHighShelf
+};
+
+/// @brief Normalized second order section coefficients (a0 = 1), e.g.:
+///
+/// y(n) = b0 x(n) + b1 x(n-1) + b2 x(n-2) - a1 y(n-1) - a2 y(n-2)
+struct BiquadCoefficients {
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+};
+
+/// @brief Second order section letting the signal through, unchanged
+BiquadCoefficients BiquadIdentity(void);
+
+/// @brief Compute second order section coefficients
+/// based on Audio EQ Cookbook material
+///
+/// @param[in]  type   Section response
+/// @param[in]  frequency   Center or cutoff frequency (normalized)
+/// @param[in]  resonance   Quality factor
+/// @param[in]  gain   Gain in dB, only used by peaking and shelving filters
+BiquadCoefficients DesignBiquad(const BiquadType type,
+                                const float frequency,
+                                const float resonance,
+                                const float gain = 0.0f);
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_BIQUAD_DESIGNER_H_
@@ -0,0 +1,268 @@
+/// @file convolver.cc
+/// @brief Partitioned convolution - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::copy, std::fill, std::min, std::swap
+#include <algorithm>
+
+#include "soundtailor/src/filters/convolver.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Growth factor between two consecutive stages partition sizes
+static const std::size_t kStageGrowth(8);
+
+ConvolverStage::ConvolverStage(BlockIn segment,
+                               const std::size_t segment_size,
+                               const std::size_t partition_size,
+                               const std::size_t block_size)
+    : partition_size_(partition_size),
+      block_size_(block_size),
+      partitions_count_((segment_size + partition_size - 1) / partition_size),
+      steps_count_(partition_size / block_size),
+      partitions_per_step_((partitions_count_ + steps_count_ - 1)
+                           / steps_count_),
+      step_(steps_count_),
+      bins_(partition_size + SampleSize),
+      fft_(2 * partition_size),
+      filter_real_(partitions_count_ * bins_, 0.0f),
+      filter_imaginary_(partitions_count_ * bins_, 0.0f),
+      delay_line_real_(partitions_count_ * bins_, 0.0f),
+      delay_line_imaginary_(partitions_count_ * bins_, 0.0f),
+      delay_line_head_(0),
+      accumulator_real_(bins_, 0.0f),
+      accumulator_imaginary_(bins_, 0.0f),
+      window_(2 * partition_size, 0.0f),
+      window_fill_(0),
+      output_(2 * partition_size, 0.0f),
+      next_output_(2 * partition_size, 0.0f),
+      output_position_(partition_size) {
+  SOUNDTAILOR_ASSERT(segment_size > 0);
+  SOUNDTAILOR_ASSERT(partition_size % block_size == 0);
+  // Each partition is zero-padded to twice its size
+  std::vector<float> padded(2 * partition_size_, 0.0f);
+  for (std::size_t k(0); k < partitions_count_; ++k) {
+    const std::size_t kBegin(k * partition_size_);
+    const std::size_t kEnd(std::min(kBegin + partition_size_, segment_size));
+    std::fill(padded.begin(), padded.end(), 0.0f);
+    std::copy(&segment[kBegin], &segment[kEnd], padded.begin());
+    fft_.Forward(&padded[0],
+                 &filter_real_[k * bins_],
+                 &filter_imaginary_[k * bins_]);
+  }
+}
+
+void ConvolverStage::Process(BlockIn in, BlockOut out) {
+  if (step_ < steps_count_) {
+    ComputeStep();
+  }
+  if (output_position_ == 2 * partition_size_) {
+    // Current output entirely played: the next one is ready
+    std::swap(output_, next_output_);
+    output_position_ = partition_size_;
+  }
+  const float* SOUNDTAILOR_RESTRICT partition_out(&output_[output_position_]);
+  for (std::size_t i(0); i < block_size_; i += SampleSize) {
+    VectorMath::Store(&out[i],
+                      VectorMath::Add(VectorMath::Fill(&out[i]),
+                                      VectorMath::Fill(&partition_out[i])));
+  }
+  output_position_ += block_size_;
+  std::copy(&in[0],
+            &in[block_size_],
+            &window_[partition_size_ + window_fill_]);
+  window_fill_ += block_size_;
+  if (window_fill_ == partition_size_) {
+    // Computed during the next steps_count_ blocks
+    step_ = 0;
+  }
+}
+
+void ConvolverStage::Reset(void) {
+  std::fill(delay_line_real_.begin(), delay_line_real_.end(), 0.0f);
+  std::fill(delay_line_imaginary_.begin(), delay_line_imaginary_.end(), 0.0f);
+  delay_line_head_ = 0;
+  std::fill(window_.begin(), window_.end(), 0.0f);
+  window_fill_ = 0;
+  std::fill(output_.begin(), output_.end(), 0.0f);
+  std::fill(next_output_.begin(), next_output_.end(), 0.0f);
+  output_position_ = partition_size_;
+  step_ = steps_count_;
+}
+
+std::size_t ConvolverStage::GetPartitionSize(void) const {
+  return partition_size_;
+}
+
+std::size_t ConvolverStage::GetLatency(void) const {
+  return steps_count_ > 1 ? 2 * partition_size_ : partition_size_;
+}
+
+void ConvolverStage::ComputeStep(void) {
+  if (step_ == 0) {
+    delay_line_head_ = (delay_line_head_ + 1) % partitions_count_;
+    fft_.Forward(&window_[0],
+                 &delay_line_real_[delay_line_head_ * bins_],
+                 &delay_line_imaginary_[delay_line_head_ * bins_]);
+    std::copy(window_.begin() + partition_size_,
+              window_.end(),
+              window_.begin());
+    window_fill_ = 0;
+    std::fill(accumulator_real_.begin(), accumulator_real_.end(), 0.0f);
+    std::fill(accumulator_imaginary_.begin(),
+              accumulator_imaginary_.end(),
+              0.0f);
+  }
+
+  // Frequency domain multiply-accumulate of this step slice:
+  // the newest input spectrum goes with the first impulse partition
+  const std::size_t kBegin(std::min(step_ * partitions_per_step_,
+                                    partitions_count_));
+  const std::size_t kEnd(std::min(kBegin + partitions_per_step_,
+                                  partitions_count_));
+  for (std::size_t k(kBegin); k < kEnd; ++k) {
+    const std::size_t kSlot((delay_line_head_ + partitions_count_ - k)
+                            % partitions_count_);
+    const float* input_real(&delay_line_real_[kSlot * bins_]);
+    const float* input_imaginary(&delay_line_imaginary_[kSlot * bins_]);
+    const float* filter_real(&filter_real_[k * bins_]);
+    const float* filter_imaginary(&filter_imaginary_[k * bins_]);
+    for (std::size_t bin(0); bin < bins_; bin += SampleSize) {
+      const Sample kInputReal(VectorMath::Fill(&input_real[bin]));
+      const Sample kInputImaginary(VectorMath::Fill(&input_imaginary[bin]));
+      const Sample kFilterReal(VectorMath::Fill(&filter_real[bin]));
+      const Sample kFilterImaginary(VectorMath::Fill(&filter_imaginary[bin]));
+      const Sample kReal(
+        VectorMath::Sub(VectorMath::Mul(kInputReal, kFilterReal),
+                        VectorMath::Mul(kInputImaginary, kFilterImaginary)));
+      const Sample kImaginary(
+        VectorMath::Add(VectorMath::Mul(kInputReal, kFilterImaginary),
+                        VectorMath::Mul(kInputImaginary, kFilterReal)));
+      VectorMath::Store(
+        &accumulator_real_[bin],
+        VectorMath::Add(VectorMath::Fill(&accumulator_real_[bin]), kReal));
+      VectorMath::Store(
+        &accumulator_imaginary_[bin],
+        VectorMath::Add(VectorMath::Fill(&accumulator_imaginary_[bin]),
+                        kImaginary));
+    }
+  }
+
+  step_ += 1;
+  if (step_ == steps_count_) {
+    // Overlap-save: only the second half of the output is valid
+    fft_.Inverse(&accumulator_real_[0],
+                 &accumulator_imaginary_[0],
+                 &next_output_[0]);
+  }
+}
+
+Convolver::Convolver(BlockIn impulse,
+                     const std::size_t impulse_size,
+                     const std::size_t block_size,
+                     const std::size_t max_partition_size)
+    : impulse_size_(impulse_size),
+      block_size_(block_size),
+      head_(std::min(impulse_size, block_size)),
+      head_line_(),
+      history_size_(0),
+      stages_() {
+  SOUNDTAILOR_ASSERT(impulse_size > 0);
+  SOUNDTAILOR_ASSERT(block_size >= 2 * SampleSize);
+  SOUNDTAILOR_ASSERT((block_size & (block_size - 1)) == 0);
+  SOUNDTAILOR_ASSERT(max_partition_size >= block_size);
+
+  std::copy(&impulse[0], &impulse[head_.size()], head_.begin());
+  // Rounded up so that the current block stays aligned
+  history_size_ = ((head_.size() - 1 + SampleSize - 1) / SampleSize)
+                  * SampleSize;
+  head_line_.resize(history_size_ + block_size_, 0.0f);
+
+  // Each stage starts where its output delay is: one partition for the
+  // first one, two partitions for the following ones
+  std::size_t begin(block_size_);
+  for (std::size_t partition_size(block_size_);
+       begin < impulse_size_;
+       partition_size *= kStageGrowth) {
+    const std::size_t kNextSize(partition_size * kStageGrowth);
+    // The last stage takes care of all remaining taps
+    const std::size_t kEnd(kNextSize > max_partition_size
+                           ? impulse_size_
+                           : std::min(2 * kNextSize, impulse_size_));
+    stages_.push_back(ConvolverStage(&impulse[begin],
+                                     kEnd - begin,
+                                     partition_size,
+                                     block_size_));
+    SOUNDTAILOR_ASSERT(stages_.back().GetLatency() == begin);
+    begin = kEnd;
+  }
+}
+
+void Convolver::ProcessBlock(BlockIn in,
+                             BlockOut out,
+                             const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % block_size_ == 0);
+  for (std::size_t i(0); i < block_size; i += block_size_) {
+    ProcessOneBlock(&in[i], &out[i]);
+  }
+}
+
+void Convolver::Reset(void) {
+  std::fill(head_line_.begin(), head_line_.end(), 0.0f);
+  for (ConvolverStage& stage : stages_) {
+    stage.Reset();
+  }
+}
+
+std::size_t Convolver::GetImpulseSize(void) const {
+  return impulse_size_;
+}
+
+std::size_t Convolver::GetStagesCount(void) const {
+  return stages_.size();
+}
+
+void Convolver::ProcessOneBlock(BlockIn in, BlockOut out) {
+  std::copy(&in[0], &in[block_size_], &head_line_[history_size_]);
+
+  // Direct form head: SampleSize outputs at once, the input window
+  // being shifted back in time by one sample for each tap
+  const std::size_t kHeadSize(head_.size());
+  for (std::size_t i(0); i < block_size_; i += SampleSize) {
+    const float* current(&head_line_[history_size_ + i]);
+    Sample window(VectorMath::Fill(current));
+    Sample sum(VectorMath::MulConst(head_[0], window));
+    for (std::size_t tap(1); tap < kHeadSize; ++tap) {
+      window = VectorMath::RotateOnRight(window, *(current - tap));
+      sum = VectorMath::Add(sum, VectorMath::MulConst(head_[tap], window));
+    }
+    VectorMath::Store(&out[i], sum);
+  }
+  std::copy(&head_line_[block_size_],
+            &head_line_[block_size_ + history_size_],
+            &head_line_[0]);
+
+  for (ConvolverStage& stage : stages_) {
+    stage.Process(in, out);
+  }
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,161 @@
+/// @file convolver.h
+/// @brief Partitioned convolution, for long impulse responses
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_CONVOLVER_H_
+#define SOUNDTAILOR_SRC_FILTERS_CONVOLVER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/filters/fft.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Uniformly partitioned convolution (overlap-save with a frequency
+/// domain delay line) of an impulse response segment
+///
+/// Partitions as big as the processing blocks are computed at once
+/// as soon as the previous input partition is known: the output is delayed
+/// by one partition.
+/// Bigger partitions are computed over the partition_size / block_size
+/// blocks following it: the forward FFT along with the first slice
+/// of the frequency domain multiply-accumulate, the inverse FFT along with
+/// the last one. The output is then delayed by two partitions.
+/// This is the building block of Convolver, it is not meant
+/// to be used alone.
+class ConvolverStage {
+ public:
+  /// @param[in]  segment   Impulse response segment
+  /// @param[in]  segment_size   Segment length
+  /// @param[in]  partition_size   Has to be a power of 2
+  /// @param[in]  block_size   Processing block size, has to divide
+  /// the partition size
+  ConvolverStage(BlockIn segment,
+                 const std::size_t segment_size,
+                 const std::size_t partition_size,
+                 const std::size_t block_size);
+
+  /// @brief Push one input block and accumulate the matching output one
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[in,out]  out   Output block to accumulate into
+  void Process(BlockIn in, BlockOut out);
+  /// @brief Clear all input history
+  void Reset(void);
+
+  std::size_t GetPartitionSize(void) const;
+  /// @brief Output delay, in samples: where the segment has to begin
+  /// within the whole impulse response
+  std::size_t GetLatency(void) const;
+
+ private:
+  /// @brief Compute one slice of the next output partition
+  /// from the filled input one
+  void ComputeStep(void);
+
+  std::size_t partition_size_;
+  std::size_t block_size_;
+  std::size_t partitions_count_;
+  std::size_t steps_count_;  ///< Blocks the computation is spread over
+  std::size_t partitions_per_step_;
+  std::size_t step_;  ///< Next computation step, steps_count_ when idle
+  std::size_t bins_;  ///< Spectrum length, padded to SampleSize
+  RealFft fft_;
+  /// Impulse response partitions spectra, bins_ values each
+  std::vector<float> filter_real_;
+  std::vector<float> filter_imaginary_;
+  /// Frequency domain delay line: past input spectra, bins_ values each
+  std::vector<float> delay_line_real_;
+  std::vector<float> delay_line_imaginary_;
+  std::size_t delay_line_head_;  ///< Position of the newest spectrum
+  std::vector<float> accumulator_real_;  ///< Output spectrum
+  std::vector<float> accumulator_imaginary_;
+  std::vector<float> window_;  ///< Last two input partitions
+  std::size_t window_fill_;  ///< Filled length of the last one
+  std::vector<float> output_;  ///< Overlap-save output, second half valid
+  std::vector<float> next_output_;  ///< Being computed
+  std::size_t output_position_;
+};
+
+/// @brief Zero latency convolution with an arbitrary long impulse response
+///
+/// The first block_size taps are computed in direct form, the following
+/// ones by uniformly partitioned stages of growing sizes:
+/// block_size first, then each following stage is 8 times bigger than the
+/// previous one, up to max_partition_size.
+/// Setting max_partition_size to block_size yields a uniformly
+/// partitioned convolution.
+/// All memory is allocated at construction: processing never allocates.
+///
+/// Stages with partitions bigger than the block size spread their work
+/// across blocks (see ConvolverStage), hence start at twice their
+/// partition size within the impulse response.
+/// The worst case block cost is then, for each stage, one FFT of twice its
+/// partition size plus its multiply-accumulate of
+/// ceil(partitions count * block_size / partition_size) partitions
+/// (all of them for the first stage).
+class Convolver {
+ public:
+  /// @param[in]  impulse   Impulse response
+  /// @param[in]  impulse_size   Impulse response length
+  /// @param[in]  block_size   Processing block size, has to be a power of 2
+  /// at least 2 * SampleSize
+  /// @param[in]  max_partition_size   Biggest partition size,
+  /// has to be a power of 2 at least block_size
+  Convolver(BlockIn impulse,
+            const std::size_t impulse_size,
+            const std::size_t block_size,
+            const std::size_t max_partition_size = 4096);
+
+  /// @brief Filter a whole block
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of the block size
+  /// given at construction
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+  /// @brief Clear all input history
+  void Reset(void);
+
+  std::size_t GetImpulseSize(void) const;
+  std::size_t GetStagesCount(void) const;
+
+ private:
+  /// @brief Process one block of the size given at construction
+  void ProcessOneBlock(BlockIn in, BlockOut out);
+
+  std::size_t impulse_size_;
+  std::size_t block_size_;
+  /// Direct form part: first taps of the impulse response
+  std::vector<float> head_;
+  /// Head input: past samples (history_size_ long) followed by the current
+  /// block
+  std::vector<float> head_line_;
+  std::size_t history_size_;
+  std::vector<ConvolverStage> stages_;
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_CONVOLVER_H_
@@ -0,0 +1,186 @@
+/// @file fft.cc
+/// @brief Real-input Fast Fourier Transform - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::cos, std::sin
+#include <cmath>
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/fft.h"
+
+namespace soundtailor {
+namespace filters {
+
+RealFft::RealFft(const std::size_t size)
+    : size_(size),
+      half_size_(size / 2),
+      bit_reversed_(size / 2),
+      twiddles_real_(size / 2),
+      twiddles_imaginary_(size / 2),
+      post_real_(size / 2 + 1),
+      post_imaginary_(size / 2 + 1),
+      work_real_(size / 2),
+      work_imaginary_(size / 2) {
+  SOUNDTAILOR_ASSERT(size >= 2 * SampleSize);
+  SOUNDTAILOR_ASSERT((size & (size - 1)) == 0);
+
+  unsigned int bits(0);
+  while ((static_cast<std::size_t>(1) << bits) < half_size_) {
+    bits += 1;
+  }
+  for (unsigned int i(0); i < half_size_; ++i) {
+    unsigned int reversed(0);
+    for (unsigned int bit(0); bit < bits; ++bit) {
+      reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+    }
+    bit_reversed_[i] = reversed;
+  }
+  // Computations done in double since precision is crucial here
+  for (std::size_t half(1); half < half_size_; half *= 2) {
+    for (std::size_t j(0); j < half; ++j) {
+      const double kAngle(-Pi * static_cast<double>(j)
+                          / static_cast<double>(half));
+      twiddles_real_[half + j] = static_cast<float>(std::cos(kAngle));
+      twiddles_imaginary_[half + j] = static_cast<float>(std::sin(kAngle));
+    }
+  }
+  for (std::size_t k(0); k <= half_size_; ++k) {
+    const double kAngle(-2.0 * Pi * static_cast<double>(k)
+                        / static_cast<double>(size_));
+    post_real_[k] = static_cast<float>(std::cos(kAngle));
+    post_imaginary_[k] = static_cast<float>(std::sin(kAngle));
+  }
+}
+
+void RealFft::Forward(BlockIn in, float* real, float* imaginary) {
+  // Even samples as real parts, odd ones as imaginary parts
+  for (std::size_t n(0); n < half_size_; ++n) {
+    work_real_[bit_reversed_[n]] = in[2 * n];
+    work_imaginary_[bit_reversed_[n]] = in[2 * n + 1];
+  }
+  Transform();
+  // Splitting even and odd samples spectra back:
+  // X(k) = E(k) + exp(-2 i pi k / size) O(k)
+  for (std::size_t k(0); k <= half_size_; ++k) {
+    const std::size_t kIndex(k % half_size_);
+    const std::size_t kMirror((half_size_ - k) % half_size_);
+    const float kSumReal(0.5f * (work_real_[kIndex] + work_real_[kMirror]));
+    const float kSumImaginary(0.5f * (work_imaginary_[kIndex]
+                                      - work_imaginary_[kMirror]));
+    // (Z(k) - conj(Z(M - k))) / 2i
+    const float kDiffReal(0.5f * (work_imaginary_[kIndex]
+                                  + work_imaginary_[kMirror]));
+    const float kDiffImaginary(-0.5f * (work_real_[kIndex]
+                                        - work_real_[kMirror]));
+    real[k] = kSumReal
+              + post_real_[k] * kDiffReal
+              - post_imaginary_[k] * kDiffImaginary;
+    imaginary[k] = kSumImaginary
+                   + post_real_[k] * kDiffImaginary
+                   + post_imaginary_[k] * kDiffReal;
+  }
+}
+
+void RealFft::Inverse(const float* real, const float* imaginary, BlockOut out) {
+  // Merging even and odd samples spectra:
+  // Z(k) = E(k) + i O(k), conjugated for the inverse transform
+  for (std::size_t k(0); k < half_size_; ++k) {
+    const std::size_t kMirror(half_size_ - k);
+    const float kSumReal(0.5f * (real[k] + real[kMirror]));
+    const float kSumImaginary(0.5f * (imaginary[k] - imaginary[kMirror]));
+    const float kDiffReal(0.5f * (real[k] - real[kMirror]));
+    const float kDiffImaginary(0.5f * (imaginary[k] + imaginary[kMirror]));
+    // O(k) = (X(k) - conj(X(M - k))) exp(2 i pi k / size) / 2
+    const float kOddReal(kDiffReal * post_real_[k]
+                         + kDiffImaginary * post_imaginary_[k]);
+    const float kOddImaginary(kDiffImaginary * post_real_[k]
+                              - kDiffReal * post_imaginary_[k]);
+    work_real_[bit_reversed_[k]] = kSumReal - kOddImaginary;
+    work_imaginary_[bit_reversed_[k]] = -(kSumImaginary + kOddReal);
+  }
+  Transform();
+  const float kNormalization(1.0f / static_cast<float>(half_size_));
+  for (std::size_t n(0); n < half_size_; ++n) {
+    out[2 * n] = work_real_[n] * kNormalization;
+    out[2 * n + 1] = -work_imaginary_[n] * kNormalization;
+  }
+}
+
+std::size_t RealFft::GetSize(void) const {
+  return size_;
+}
+
+void RealFft::Transform(void) {
+  float* SOUNDTAILOR_RESTRICT data_real(&work_real_[0]);
+  float* SOUNDTAILOR_RESTRICT data_imaginary(&work_imaginary_[0]);
+  // First stages, too narrow to be vectorized
+  std::size_t half(1);
+  for (; half < SampleSize && half < half_size_; half *= 2) {
+    for (std::size_t start(0); start < half_size_; start += 2 * half) {
+      for (std::size_t j(0); j < half; ++j) {
+        const float kTwiddleReal(twiddles_real_[half + j]);
+        const float kTwiddleImaginary(twiddles_imaginary_[half + j]);
+        const std::size_t kTop(start + j);
+        const std::size_t kBottom(kTop + half);
+        const float kReal(data_real[kBottom] * kTwiddleReal
+                          - data_imaginary[kBottom] * kTwiddleImaginary);
+        const float kImaginary(data_real[kBottom] * kTwiddleImaginary
+                               + data_imaginary[kBottom] * kTwiddleReal);
+        data_real[kBottom] = data_real[kTop] - kReal;
+        data_imaginary[kBottom] = data_imaginary[kTop] - kImaginary;
+        data_real[kTop] += kReal;
+        data_imaginary[kTop] += kImaginary;
+      }
+    }
+  }
+  // Following ones process SampleSize butterflies at once
+  for (; half < half_size_; half *= 2) {
+    for (std::size_t start(0); start < half_size_; start += 2 * half) {
+      for (std::size_t j(0); j < half; j += SampleSize) {
+        const Sample kTwiddleReal(VectorMath::Fill(&twiddles_real_[half + j]));
+        const Sample kTwiddleImaginary(
+          VectorMath::Fill(&twiddles_imaginary_[half + j]));
+        float* top_real(&data_real[start + j]);
+        float* top_imaginary(&data_imaginary[start + j]);
+        float* bottom_real(top_real + half);
+        float* bottom_imaginary(top_imaginary + half);
+        const Sample kTopReal(VectorMath::Fill(top_real));
+        const Sample kTopImaginary(VectorMath::Fill(top_imaginary));
+        const Sample kBottomReal(VectorMath::Fill(bottom_real));
+        const Sample kBottomImaginary(VectorMath::Fill(bottom_imaginary));
+        const Sample kReal(
+          VectorMath::Sub(VectorMath::Mul(kBottomReal, kTwiddleReal),
+                          VectorMath::Mul(kBottomImaginary, kTwiddleImaginary)));
+        const Sample kImaginary(
+          VectorMath::Add(VectorMath::Mul(kBottomReal, kTwiddleImaginary),
+                          VectorMath::Mul(kBottomImaginary, kTwiddleReal)));
+        VectorMath::Store(top_real, VectorMath::Add(kTopReal, kReal));
+        VectorMath::Store(top_imaginary,
+                          VectorMath::Add(kTopImaginary, kImaginary));
+        VectorMath::Store(bottom_real, VectorMath::Sub(kTopReal, kReal));
+        VectorMath::Store(bottom_imaginary,
+                          VectorMath::Sub(kTopImaginary, kImaginary));
+      }
+    }
+  }
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,83 @@
+/// @file fft.h
+/// @brief Real-input Fast Fourier Transform
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_FFT_H_
+#define SOUNDTAILOR_SRC_FILTERS_FFT_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Fast Fourier Transform of real signals, through a complex
+/// radix-2 transform of half its size
+///
+/// Spectra are in split format: real and imaginary parts in separate arrays,
+/// holding size / 2 + 1 bins (DC to Nyquist).
+/// All memory is allocated at construction: transforms never allocate.
+class RealFft {
+ public:
+  /// @brief Prepare transforms of the given size
+  ///
+  /// @param[in]  size   Has to be a power of 2, at least 2 * SampleSize
+  explicit RealFft(const std::size_t size);
+
+  /// @brief Forward (unnormalized) transform
+  ///
+  /// @param[in]  in   Input signal, size long
+  /// @param[out]  real   Real parts, size / 2 + 1 long
+  /// @param[out]  imaginary   Imaginary parts, size / 2 + 1 long
+  void Forward(BlockIn in, float* real, float* imaginary);
+  /// @brief Inverse transform, normalized so that it exactly inverts Forward()
+  ///
+  /// @param[in]  real   Real parts, size / 2 + 1 long
+  /// @param[in]  imaginary   Imaginary parts, size / 2 + 1 long
+  /// @param[out]  out   Output signal, size long
+  void Inverse(const float* real, const float* imaginary, BlockOut out);
+
+  std::size_t GetSize(void) const;
+
+ private:
+  /// @brief In-place complex transform of the working buffers
+  void Transform(void);
+
+  std::size_t size_;
+  std::size_t half_size_;  ///< Size of the underlying complex transform
+  /// Bit-reversed indexes for the complex transform input
+  std::vector<unsigned int> bit_reversed_;
+  /// Complex transform twiddles, for a stage spanning "half" values:
+  /// exp(-i pi j / half) is stored at index (half + j)
+  std::vector<float> twiddles_real_;
+  std::vector<float> twiddles_imaginary_;
+  /// Real transform twiddles, exp(-2 i pi k / size)
+  std::vector<float> post_real_;
+  std::vector<float> post_imaginary_;
+  std::vector<float> work_real_;  ///< Complex transform working buffers
+  std::vector<float> work_imaginary_;
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_FFT_H_
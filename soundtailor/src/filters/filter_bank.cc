@@ -0,0 +1,260 @@
+/// @file filter_bank.cc
+/// @brief Band pass filter bank - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::exp, std::pow
+#include <cmath>
+
+#include "soundtailor/src/filters/filter_bank.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Compute a one pole smoothing coefficient from its time constant
+static float ComputeFollowerCoeff(const float time) {
+  SOUNDTAILOR_ASSERT(time >= 0.0f);
+  if (time <= 0.0f) {
+    return 1.0f;
+  }
+  return static_cast<float>(1.0 - std::exp(-1.0 / static_cast<double>(time)));
+}
+
+// Both Transpose() and the input broadcast below are written for 4 lanes
+static_assert(SampleSize == 4, "Filter bank only supports 4 lanes Samples");
+
+/// @brief Transpose the given SampleSize x SampleSize matrix, e.g.:
+/// rows[i] lane j becomes rows[j] lane i
+static void Transpose(Sample* rows) {
+  const Sample kRow0(rows[0]);
+  const Sample kRow1(rows[1]);
+  const Sample kRow2(rows[2]);
+  const Sample kRow3(rows[3]);
+  rows[0] = VectorMath::Fill(VectorMath::GetByIndex<0>(kRow0),
+                             VectorMath::GetByIndex<0>(kRow1),
+                             VectorMath::GetByIndex<0>(kRow2),
+                             VectorMath::GetByIndex<0>(kRow3));
+  rows[1] = VectorMath::Fill(VectorMath::GetByIndex<1>(kRow0),
+                             VectorMath::GetByIndex<1>(kRow1),
+                             VectorMath::GetByIndex<1>(kRow2),
+                             VectorMath::GetByIndex<1>(kRow3));
+  rows[2] = VectorMath::Fill(VectorMath::GetByIndex<2>(kRow0),
+                             VectorMath::GetByIndex<2>(kRow1),
+                             VectorMath::GetByIndex<2>(kRow2),
+                             VectorMath::GetByIndex<2>(kRow3));
+  rows[3] = VectorMath::Fill(VectorMath::GetByIndex<3>(kRow0),
+                             VectorMath::GetByIndex<3>(kRow1),
+                             VectorMath::GetByIndex<3>(kRow2),
+                             VectorMath::GetByIndex<3>(kRow3));
+}
+
+template <FilterBankFollower Follower>
+void FilterBank::Process(const float* in,
+                         float* bands,
+                         float* envelopes,
+                         const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size > 0);
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  const unsigned int kGroupsCount((bands_count_ + SampleSize - 1)
+                                  / SampleSize);
+  const bool kFollow(Follower != kFollowerNone);
+  const bool kRms(Follower == kFollowerRms);
+  // Followers states are kept up to date even if not output
+  const bool kOutputEnvelopes(kFollow && envelopes != nullptr);
+  const Sample kAttackCoeff(VectorMath::Fill(attack_coeff_));
+  const Sample kReleaseCoeff(VectorMath::Fill(release_coeff_));
+  const Sample kZero(VectorMath::Fill(0.0f));
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    // Each input Sample is read once, its values broadcast to all bands
+    const Sample kInput(VectorMath::Fill(&in[i]));
+    const Sample kBroadcast[SampleSize] = {
+      VectorMath::Fill(VectorMath::GetByIndex<0>(kInput)),
+      VectorMath::Fill(VectorMath::GetByIndex<1>(kInput)),
+      VectorMath::Fill(VectorMath::GetByIndex<2>(kInput)),
+      VectorMath::Fill(VectorMath::GetByIndex<3>(kInput))
+    };
+    for (unsigned int group(0); group < kGroupsCount; ++group) {
+      const unsigned int kFirst(group * SampleSize);
+      const Sample kB0(VectorMath::Fill(&b0_[kFirst]));
+      const Sample kB1(VectorMath::Fill(&b1_[kFirst]));
+      const Sample kB2(VectorMath::Fill(&b2_[kFirst]));
+      const Sample kA1(VectorMath::Fill(&a1_[kFirst]));
+      const Sample kA2(VectorMath::Fill(&a2_[kFirst]));
+      Sample s1(VectorMath::Fill(&s1_[kFirst]));
+      Sample s2(VectorMath::Fill(&s2_[kFirst]));
+      Sample envelope(VectorMath::Fill(&envelopes_[kFirst]));
+      // One Sample per time step, each lane being a different band
+      Sample outputs[SampleSize];
+      Sample followed[SampleSize];
+      for (unsigned int step(0); step < SampleSize; ++step) {
+        const Sample kCurrent(kBroadcast[step]);
+        const Sample kOut(VectorMath::Add(VectorMath::Mul(kB0, kCurrent), s1));
+        s1 = VectorMath::Add(
+          VectorMath::Sub(VectorMath::Mul(kB1, kCurrent),
+                          VectorMath::Mul(kA1, kOut)),
+          s2);
+        s2 = VectorMath::Sub(VectorMath::Mul(kB2, kCurrent),
+                             VectorMath::Mul(kA2, kOut));
+        outputs[step] = kOut;
+        if (kFollow) {
+          const Sample kDetected(kRms
+            ? VectorMath::Mul(kOut, kOut)
+            : VectorMath::Abs(kOut));
+          // Attack coefficient on rising lanes, release elsewhere
+          const Sample kDelta(VectorMath::Sub(kDetected, envelope));
+          envelope = VectorMath::Add(
+            envelope,
+            VectorMath::Add(
+              VectorMath::Mul(kAttackCoeff, VectorMath::Max(kDelta, kZero)),
+              VectorMath::Mul(kReleaseCoeff, VectorMath::Min(kDelta, kZero))));
+          if (kOutputEnvelopes) {
+            followed[step] = kRms ? VectorMath::Sqrt(envelope) : envelope;
+          }
+        }
+      }
+      VectorMath::Store(&s1_[kFirst], s1);
+      VectorMath::Store(&s2_[kFirst], s2);
+      VectorMath::Store(&envelopes_[kFirst], envelope);
+
+      // From (time step, band) to (band, time step) for planar outputs
+      Transpose(&outputs[0]);
+      if (kOutputEnvelopes) {
+        Transpose(&followed[0]);
+      }
+      for (unsigned int lane(0); lane < SampleSize; ++lane) {
+        const unsigned int kBand(kFirst + lane);
+        if (kBand < bands_count_) {
+          VectorMath::Store(&bands[kBand * block_size + i], outputs[lane]);
+          if (kOutputEnvelopes) {
+            VectorMath::Store(&envelopes[kBand * block_size + i],
+                              followed[lane]);
+          }
+        }
+      }
+    }
+  }
+}
+
+FilterBank::FilterBank(const unsigned int bands_count)
+    : bands_count_(bands_count),
+      follower_(kFollowerNone),
+      attack_coeff_(1.0f),
+      release_coeff_(1.0f),
+      b0_(),
+      b1_(),
+      b2_(),
+      a1_(),
+      a2_(),
+      s1_(),
+      s2_(),
+      envelopes_() {
+  SOUNDTAILOR_ASSERT(bands_count > 0);
+  SOUNDTAILOR_ASSERT(bands_count <= kMaxBands);
+  // Bands let the signal through until set, unused ones
+  // (completing the last group) are silent
+  for (unsigned int i(0); i < bands_count_; ++i) {
+    SetBand(i, BiquadIdentity());
+  }
+}
+
+void FilterBank::ProcessBlock(BlockIn in,
+                              BlockOut bands,
+                              const std::size_t block_size) {
+  switch (follower_) {
+    case(kFollowerPeak): {
+      Process<kFollowerPeak>(in, bands, nullptr, block_size);
+      break;
+    }
+    case(kFollowerRms): {
+      Process<kFollowerRms>(in, bands, nullptr, block_size);
+      break;
+    }
+    default: {
+      Process<kFollowerNone>(in, bands, nullptr, block_size);
+      break;
+    }
+  }  // switch(follower_)
+}
+
+void FilterBank::ProcessBlock(BlockIn in,
+                              BlockOut bands,
+                              BlockOut envelopes,
+                              const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(follower_ != kFollowerNone);
+  SOUNDTAILOR_ASSERT(envelopes != nullptr);
+  if (follower_ == kFollowerRms) {
+    Process<kFollowerRms>(in, bands, envelopes, block_size);
+  } else {
+    Process<kFollowerPeak>(in, bands, envelopes, block_size);
+  }
+}
+
+void FilterBank::SetBand(const unsigned int index,
+                         const float frequency,
+                         const float resonance) {
+  SetBand(index, DesignBiquad(kBiquadBandPass, frequency, resonance));
+}
+
+void FilterBank::SetBand(const unsigned int index,
+                         const BiquadCoefficients& coefficients) {
+  SOUNDTAILOR_ASSERT(index < bands_count_);
+  b0_[index] = coefficients.b0;
+  b1_[index] = coefficients.b1;
+  b2_[index] = coefficients.b2;
+  a1_[index] = coefficients.a1;
+  a2_[index] = coefficients.a2;
+}
+
+void FilterBank::SetBands(const float lowest,
+                          const float highest,
+                          const float resonance) {
+  SOUNDTAILOR_ASSERT(lowest > 0.0f);
+  SOUNDTAILOR_ASSERT(lowest <= highest);
+  const double kRatio(bands_count_ > 1
+    ? std::pow(static_cast<double>(highest) / static_cast<double>(lowest),
+               1.0 / (bands_count_ - 1))
+    : 1.0);
+  double frequency(lowest);
+  for (unsigned int i(0); i < bands_count_; ++i) {
+    SetBand(i, static_cast<float>(frequency), resonance);
+    frequency *= kRatio;
+  }
+}
+
+void FilterBank::SetFollower(const FilterBankFollower follower,
+                             const float attack,
+                             const float release) {
+  follower_ = follower;
+  attack_coeff_ = ComputeFollowerCoeff(attack);
+  release_coeff_ = ComputeFollowerCoeff(release);
+}
+
+unsigned int FilterBank::GetBandsCount(void) const {
+  return bands_count_;
+}
+
+void FilterBank::Reset(void) {
+  for (unsigned int i(0); i < kMaxBands; ++i) {
+    s1_[i] = 0.0f;
+    s2_[i] = 0.0f;
+    envelopes_[i] = 0.0f;
+  }
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,127 @@
+/// @file filter_bank.h
+/// @brief Band pass filter bank declaration
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_FILTER_BANK_H_
+#define SOUNDTAILOR_SRC_FILTERS_FILTER_BANK_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/filters/biquad_designer.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Available envelope followers for each band of a FilterBank
+enum FilterBankFollower {
+  kFollowerNone = 0,
+  kFollowerPeak,  ///< Rectified band output, smoothed
+  kFollowerRms  ///< Square root of the smoothed squared band output
+};
+
+/// @brief Bank of second order (transposed direct form II) filters
+/// sharing the same input, e.g. for vocoders or spectrum analysis
+///
+/// Each Sample lane holds a different band: all bands are processed
+/// by groups of SampleSize, each input sample being broadcast to all lanes.
+/// The input is thus read only once whatever the bands count.
+/// Outputs are planar: one block_size long buffer per band.
+/// Each band may be followed by an envelope follower with its own
+/// (planar as well) output.
+class FilterBank {
+ public:
+  /// @brief Maximum bands count
+  static const unsigned int kMaxBands = 64;
+
+  explicit FilterBank(const unsigned int bands_count);
+
+  /// @brief Filter a whole block through all bands
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  bands   Band outputs, band i being written
+  /// at [i * block_size ; (i + 1) * block_size)
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  ///
+  /// Envelope followers, if any, are updated as well (without output)
+  /// so that both methods may be used alternately
+  void ProcessBlock(BlockIn in, BlockOut bands, const std::size_t block_size);
+  /// @brief Same as above, also retrieving the envelope of each band
+  ///
+  /// @param[out]  envelopes   Envelope followers outputs,
+  /// same layout as the band outputs
+  void ProcessBlock(BlockIn in,
+                    BlockOut bands,
+                    BlockOut envelopes,
+                    const std::size_t block_size);
+
+  /// @brief Set the given band as a (constant 0dB peak gain) band pass
+  void SetBand(const unsigned int index,
+               const float frequency,
+               const float resonance);
+  /// @brief Set any coefficients for the given band,
+  /// e.g. as computed by DesignBiquad()
+  void SetBand(const unsigned int index,
+               const BiquadCoefficients& coefficients);
+  /// @brief Set all bands as band pass filters, with center frequencies
+  /// logarithmically spaced from lowest to highest
+  void SetBands(const float lowest,
+                const float highest,
+                const float resonance);
+  /// @brief Set the envelope followers behaviour, for all bands
+  ///
+  /// @param[in]  follower   Follower type
+  /// @param[in]  attack   Rising time constant, in samples
+  /// @param[in]  release   Falling time constant, in samples
+  void SetFollower(const FilterBankFollower follower,
+                   const float attack,
+                   const float release);
+  unsigned int GetBandsCount(void) const;
+  /// @brief Clear all filters and followers states
+  void Reset(void);
+
+ private:
+  /// @brief Actual processing, with the given follower
+  /// (envelopes not being output if null)
+  template <FilterBankFollower Follower>
+  void Process(const float* in,
+               float* bands,
+               float* envelopes,
+               const std::size_t block_size);
+
+  unsigned int bands_count_;
+  FilterBankFollower follower_;
+  float attack_coeff_;
+  float release_coeff_;
+  // One value per band, SampleSize consecutive bands per group
+  alignas(16) float b0_[kMaxBands];
+  alignas(16) float b1_[kMaxBands];
+  alignas(16) float b2_[kMaxBands];
+  alignas(16) float a1_[kMaxBands];
+  alignas(16) float a2_[kMaxBands];
+  alignas(16) float s1_[kMaxBands];  ///< First states
+  alignas(16) float s2_[kMaxBands];  ///< Second states
+  alignas(16) float envelopes_[kMaxBands];  ///< Followers states
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_FILTER_BANK_H_
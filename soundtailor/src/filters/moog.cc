@@ -18,6 +18,7 @@
 /// You should have received a copy of the GNU General Public License
 /// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "soundtailor/src/instrumentation.h"
 #include "soundtailor/src/maths.h"
 
 #include "soundtailor/src/filters/moog.h"
@@ -52,6 +53,7 @@ Sample Moog::operator()(SampleRead sample) {
 }
 
 void Moog::SetParameters(const float frequency, const float resonance) {
+  SOUNDTAILOR_TIME_SCOPE(kProbeMoogSetParameters);
   SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
   SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
   SOUNDTAILOR_ASSERT(resonance >= Meta().res_min);
@@ -21,10 +21,37 @@
 #include "soundtailor/src/maths.h"
 
 #include "soundtailor/src/filters/moog_lowaliasnonlinear.h"
+#include "soundtailor/src/filters/saturators.h"
 
 namespace soundtailor {
 namespace filters {
 
+/// @brief Zero coefficient of the FirstOrderPoleFixedZero filters
+static const float kZeroCoeff(0.3f);
+
+/// @brief Compute the actual poles frequency and feedback amount
+/// for the given parameters
+static void ComputeParameters(const float frequency,
+                              const float resonance,
+                              float* actual_frequency,
+                              float* actual_resonance) {
+  SOUNDTAILOR_ASSERT(frequency >= MoogLowAliasNonLinear::Meta().freq_min);
+  SOUNDTAILOR_ASSERT(frequency <= MoogLowAliasNonLinear::Meta().freq_max);
+  SOUNDTAILOR_ASSERT(resonance >= MoogLowAliasNonLinear::Meta().res_min);
+  SOUNDTAILOR_ASSERT(resonance <= MoogLowAliasNonLinear::Meta().res_max);
+  const float kActualResonance(resonance / 4.0f);
+  const float temp(frequency * (1.0f + 0.5787f * frequency
+                      * (1.0f - kActualResonance) * (1.0f - kActualResonance)));
+  const float kFrequency(1.25f * temp * (1.0f - 0.595f * temp
+                                         + 0.24f * temp * temp));
+  *actual_frequency = kFrequency;
+  *actual_resonance = kActualResonance * (
+    1.4f
+    + 0.108f * kFrequency
+    - 0.164f * kFrequency * kFrequency
+    - 0.069f * kFrequency * kFrequency * kFrequency);
+}
+
 MoogLowAliasNonLinear::MoogLowAliasNonLinear()
     : filters_(),
       frequency_(0.0f),
@@ -36,7 +63,7 @@ MoogLowAliasNonLinear::MoogLowAliasNonLinear()
 
 float MoogLowAliasNonLinear::operator()(float sample) {
   float actual_input(sample - resonance_ * last_);
-  float kCurrentSideFactor(Saturate(last_side_factor_));
+  float kCurrentSideFactor(HardClip(last_side_factor_));
 
   last_side_factor_ = actual_input * actual_input;
   last_side_factor_ *= 0.062f;
@@ -52,7 +79,7 @@ float MoogLowAliasNonLinear::operator()(float sample) {
   float tmp_filtered(actual_input);
   tmp_filtered = filters_[1](1.3f * filters_[0](1.3f * tmp_filtered));
 
-  tmp_filtered = ApplyNonLinearity(tmp_filtered);
+  tmp_filtered = SoftClipCubic(tmp_filtered);
 
   tmp_filtered = filters_[3](1.3f * filters_[2](1.3f * tmp_filtered));
 
@@ -69,7 +96,7 @@ Sample MoogLowAliasNonLinear::operator()(SampleRead sample) {
     const float current_sample = VectorMath::GetByIndex(direct_v, i);
     float actual_input(current_sample - resonance_ * last);
 
-    float kCurrentSideFactor(Saturate(last_side_factor_));
+    float kCurrentSideFactor(HardClip(last_side_factor_));
 
     last_side_factor_ = actual_input * actual_input;
     last_side_factor_ *= 0.062f;
@@ -85,7 +112,7 @@ Sample MoogLowAliasNonLinear::operator()(SampleRead sample) {
     float tmp_filtered(actual_input);
     tmp_filtered = filters_[1](2.0f * filters_[0](2.0f * tmp_filtered));
 
-    tmp_filtered = ApplyNonLinearity(tmp_filtered);
+    tmp_filtered = SoftClipCubic(tmp_filtered);
 
     tmp_filtered = filters_[3](2.0f * filters_[2](2.0f * tmp_filtered));
 
@@ -99,46 +126,12 @@ Sample MoogLowAliasNonLinear::operator()(SampleRead sample) {
 
 void MoogLowAliasNonLinear::SetParameters(const float frequency,
                                           const float resonance) {
-  SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
-  SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
-  SOUNDTAILOR_ASSERT(resonance >= Meta().res_min);
-  SOUNDTAILOR_ASSERT(resonance <= Meta().res_max);
-  const float kActualResonance(resonance / 4.0f);
-  const float temp(frequency * (1.0f + 0.5787f * frequency
-                      * (1.0f - kActualResonance) * (1.0f - kActualResonance)));
-  frequency_ = 1.25f * temp * (1.0f - 0.595f * temp + 0.24f * temp * temp);
-  resonance_ = kActualResonance * (
-    1.4f
-    + 0.108f * frequency_
-    - 0.164f * frequency_ * frequency_
-    - 0.069f * frequency_ * frequency_ * frequency_);
+  ComputeParameters(frequency, resonance, &frequency_, &resonance_);
   for (FirstOrderPoleFixedZero& filter : filters_) {
     filter.SetParameters(frequency_, resonance_);
   }
 }
 
-float MoogLowAliasNonLinear::Saturate(float sample) {
-  constexpr Sample lowerBound = { -1.0f, -1.0f, -1.0f, -1.0f };
-  constexpr Sample upperBound = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-  const Sample vecSample = VectorMath::Fill(sample);
-  const Sample result = VectorMath::Min(VectorMath::Max(vecSample, lowerBound), upperBound);
-  return VectorMath::GetFirst(result);
-}
-
-float MoogLowAliasNonLinear::ApplyNonLinearity(float sample) {
-  constexpr Sample threshold = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-  Sample vecSample = VectorMath::Fill(sample);
-  // TODO @gm: collapse predicate to mask
-  if (VectorMath::GetFirst(VectorMath::LessEqual(threshold, VectorMath::Abs(vecSample))) != 0.0f) {
-    const float kFactor(2.0f / 3.0f);
-    return kFactor * Saturate(sample);
-  } else {
-    return sample - sample * sample * sample / 3.0f;
-  }
-}
-
 const Filter_Meta& MoogLowAliasNonLinear::Meta(void) {
   static const Filter_Meta metas(1e-5f,
                                  1.0f,
@@ -151,5 +144,97 @@ const Filter_Meta& MoogLowAliasNonLinear::Meta(void) {
   return metas;
 }
 
+MoogLowAliasNonLinearParallel::MoogLowAliasNonLinearParallel()
+    : poles_(),
+      last_(VectorMath::Fill(0.0f)),
+      last_side_factor_(VectorMath::Fill(0.0f)),
+      pole_coeffs_(),
+      resonances_() {
+  Reset();
+}
+
+Sample MoogLowAliasNonLinearParallel::operator()(SampleRead frame) {
+  const Sample kPoleCoeffs(VectorMath::Fill(&pole_coeffs_[0]));
+  const Sample kResonances(VectorMath::Fill(&resonances_[0]));
+  // Same computations as FirstOrderPoleFixedZero, its 0.5 direct gain
+  // cancelling the 2.0 factor applied to each pole input
+  const Sample kFeedbackCoeffs(VectorMath::Sub(VectorMath::Fill(1.0f),
+                                               kPoleCoeffs));
+  const Sample kZeroCoeffs(VectorMath::Fill(kZeroCoeff));
+
+  const Sample kInputGains(VectorMath::Add(
+    VectorMath::Fill(0.18f),
+    VectorMath::MulConst(0.25f, kResonances)));
+  Sample actual_input(VectorMath::Sub(VectorMath::Mul(kInputGains, frame),
+                                      VectorMath::Mul(kResonances, last_)));
+
+  const Sample kCurrentSideFactor(HardClip(last_side_factor_));
+  last_side_factor_ = VectorMath::Add(
+    VectorMath::MulConst(0.062f, VectorMath::Mul(actual_input, actual_input)),
+    VectorMath::MulConst(0.993f, kCurrentSideFactor));
+  const Sample kSideGain(VectorMath::Add(
+    VectorMath::Sub(VectorMath::Fill(1.0f), kCurrentSideFactor),
+    VectorMath::MulConst(0.5f,
+                         VectorMath::Mul(kCurrentSideFactor,
+                                         kCurrentSideFactor))));
+  actual_input = VectorMath::Mul(actual_input, kSideGain);
+
+  Sample tmp_filtered(actual_input);
+  for (unsigned int pole(0); pole < 4; ++pole) {
+    const Sample kDirect(VectorMath::Mul(kPoleCoeffs, tmp_filtered));
+    tmp_filtered = VectorMath::Add(kDirect, poles_[pole]);
+    poles_[pole] = VectorMath::Add(VectorMath::Mul(tmp_filtered,
+                                                   kFeedbackCoeffs),
+                                   VectorMath::Mul(kZeroCoeffs, kDirect));
+    if (pole == 1) {
+      tmp_filtered = SoftClipCubic(tmp_filtered);
+    }
+  }
+  last_ = tmp_filtered;
+
+  return tmp_filtered;
+}
+
+void MoogLowAliasNonLinearParallel::ProcessBlock(BlockIn in,
+                                                 BlockOut out,
+                                                 const std::size_t length) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < length; ++i) {
+    VectorMath::Store(out_write, (*this)(VectorMath::Fill(in_ptr)));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+void MoogLowAliasNonLinearParallel::SetParameters(const float frequency,
+                                                  const float resonance) {
+  for (unsigned int voice(0); voice < SampleSize; ++voice) {
+    SetParameters(voice, frequency, resonance);
+  }
+}
+
+void MoogLowAliasNonLinearParallel::SetParameters(const unsigned int voice,
+                                                  const float frequency,
+                                                  const float resonance) {
+  SOUNDTAILOR_ASSERT(voice < SampleSize);
+  ComputeParameters(frequency,
+                    resonance,
+                    &pole_coeffs_[voice],
+                    &resonances_[voice]);
+}
+
+void MoogLowAliasNonLinearParallel::Reset(void) {
+  for (Sample& pole : poles_) {
+    pole = VectorMath::Fill(0.0f);
+  }
+  last_ = VectorMath::Fill(0.0f);
+  last_side_factor_ = VectorMath::Fill(0.0f);
+}
+
+const Filter_Meta& MoogLowAliasNonLinearParallel::Meta(void) {
+  return MoogLowAliasNonLinear::Meta();
+}
+
 }  // namespace filters
 }  // namespace soundtailor
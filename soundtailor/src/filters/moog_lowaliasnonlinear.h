@@ -21,6 +21,8 @@
 #ifndef SOUNDTAILOR_SRC_FILTERS_MOOG_LOWALIASNONLINEAR_H_
 #define SOUNDTAILOR_SRC_FILTERS_MOOG_LOWALIASNONLINEAR_H_
 
+#include <cstddef>
+
 #include "soundtailor/src/common.h"
 #include "soundtailor/src/filters/filter_base.h"
 #include "soundtailor/src/filters/firstorder_polefixedzero.h"
@@ -33,6 +35,9 @@ class MoogLowAliasNonLinear {
  public:
   MoogLowAliasNonLinear();
 
+  /// @brief Per-sample filtering, tuned for 2x oversampling
+  /// (see MoogOversampled): no input gain and lower stages gains,
+  /// hence it does not match the Sample version
   float operator()(float sample);
   Sample operator()(SampleRead sample);
   void SetParameters(const float frequency, const float resonance);
@@ -40,11 +45,6 @@ class MoogLowAliasNonLinear {
   static const Filter_Meta& Meta(void);
 
  private:
-  // @brief Helper for computing the internal saturation
-  float Saturate(float sample);
-  // @brief Helper for computing the internal nonlinearity
-  float ApplyNonLinearity(float sample);
-
   alignas(16) FirstOrderPoleFixedZero filters_[4];
   float frequency_;
   float resonance_;
@@ -52,6 +52,46 @@ class MoogLowAliasNonLinear {
   float last_side_factor_;
 };
 
+/// @brief Voice-parallel version of the MoogLowAliasNonLinear filter:
+/// each Sample lane holds a different voice, instead of a different time step
+///
+/// The feedback loop prevents any time-parallel vectorization, but voices are
+/// independent: the side chain saturation, the four poles and the
+/// nonlinearity are computed for all voices at once, without any branching.
+/// Each voice behaves as MoogLowAliasNonLinear::operator()(SampleRead).
+class MoogLowAliasNonLinearParallel {
+ public:
+  MoogLowAliasNonLinearParallel();
+
+  /// @brief Filter one time step of all voices
+  Sample operator()(SampleRead frame);
+  /// @brief Filter length time steps of all voices
+  ///
+  /// @param[in]  in   Input frames, SampleSize values per time step
+  /// (interleaved voices), length * SampleSize long
+  /// @param[out]  out   Output frames, same layout as the input
+  /// @param[in]  length   Number of time steps
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t length);
+
+  /// @brief Set the same parameters for all voices
+  void SetParameters(const float frequency, const float resonance);
+  /// @brief Set the parameters of the given voice only
+  void SetParameters(const unsigned int voice,
+                     const float frequency,
+                     const float resonance);
+  /// @brief Clear all voices states
+  void Reset(void);
+
+  static const Filter_Meta& Meta(void);
+
+ private:
+  Sample poles_[4];  ///< One pole low pass filters states
+  Sample last_;  ///< Last outputs, for the feedback
+  Sample last_side_factor_;
+  alignas(16) float pole_coeffs_[SampleSize];
+  alignas(16) float resonances_[SampleSize];
+};
+
 }  // namespace filters
 }  // namespace soundtailor
 
@@ -0,0 +1,112 @@
+/// @file moog_musicdsp.cc
+/// @brief Moog low pass filter, MusicDSP version - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::sin
+#include <cmath>
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/moog_musicdsp.h"
+
+namespace soundtailor {
+namespace filters {
+
+MoogMusicDSP::MoogMusicDSP()
+    : y1_(0.0f),
+      y2_(0.0f),
+      y3_(0.0f),
+      y4_(0.0f),
+      oldx_(0.0f),
+      oldy1_(0.0f),
+      oldy2_(0.0f),
+      oldy3_(0.0f),
+      r_(0.0f),
+      p_(0.0f),
+      k_(0.0f) {
+  // Nothing to do here for now
+}
+
+float MoogMusicDSP::operator()(float sample) {
+  const float x(sample - r_ * y4_);
+
+  // Four cascaded one pole filters (bilinear transform)
+  y1_ = x * p_ + oldx_ * p_ - k_ * y1_;
+  y2_ = y1_ * p_ + oldy1_ * p_ - k_ * y2_;
+  y3_ = y2_ * p_ + oldy2_ * p_ - k_ * y3_;
+  y4_ = y3_ * p_ + oldy3_ * p_ - k_ * y4_;
+
+  // Clipper band limited sigmoid
+  y4_ -= (y4_ * y4_ * y4_) / 6.0f;
+
+  oldx_ = x;
+  oldy1_ = y1_;
+  oldy2_ = y2_;
+  oldy3_ = y3_;
+
+  return y4_;
+}
+
+Sample MoogMusicDSP::operator()(SampleRead sample) {
+  float out_v[4];
+  for (unsigned int i = 0; i < SampleSize; ++i) {
+    out_v[i] = (*this)(VectorMath::GetByIndex(sample, i));
+  }
+  return VectorMath::Fill(out_v[0], out_v[1], out_v[2], out_v[3]);
+}
+
+void MoogMusicDSP::ProcessBlock(BlockIn in,
+                                BlockOut out,
+                                const std::size_t block_size) {
+  for (std::size_t i(0); i < block_size; ++i) {
+    out[i] = (*this)(in[i]);
+  }
+}
+
+void MoogMusicDSP::SetParameters(const float frequency,
+                                 const float resonance) {
+  SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
+  SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
+  SOUNDTAILOR_ASSERT(resonance >= Meta().res_min);
+  SOUNDTAILOR_ASSERT(resonance <= Meta().res_max);
+  p_ = frequency * (1.8f - 0.8f * frequency);
+  // A much better tuning than the original (2.0 * p - 1.0)
+  k_ = 2.0f * std::sin(frequency * static_cast<float>(Pi) * 0.5f) - 1.0f;
+
+  const float t1((1.0f - p_) * 1.386249f);
+  const float t2(12.0f + t1 * t1);
+  r_ = resonance * (t2 + 6.0f * t1) / (t2 - 6.0f * t1);
+}
+
+const Filter_Meta& MoogMusicDSP::Meta(void) {
+  // Pole and zero cancel each other out at Nyquist:
+  // staying slightly below for stability
+  static const Filter_Meta metas(1e-5f,
+                                 0.99f,
+                                 0.99f,
+                                 0.0f,
+                                 0.0f,
+                                 1.0f,
+                                 0,
+                                 1.0f);
+  return metas;
+}
+
+}  // namespace filters
+}  // namespace soundtailor
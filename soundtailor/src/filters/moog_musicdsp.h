@@ -0,0 +1,71 @@
+/// @file moog_musicdsp.h
+/// @brief Moog low pass filter, MusicDSP version
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_H_
+#define SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/filters/filter_base.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Moog low pass filter based on MusicDSP source:
+/// http://musicdsp.org/showArchiveComment.php?ArchiveID=24
+///
+/// Four cascaded one pole filters (bilinear transform) followed by
+/// a cubic clipper.
+/// Frequency is normalized to Nyquist, resonance within [0.0 ; 1.0]
+class MoogMusicDSP {
+ public:
+  MoogMusicDSP();
+
+  float operator()(float sample);
+  Sample operator()(SampleRead sample);
+  /// @brief Filter a whole block, without any per-Sample lanes shuffling
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Block length
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+  void SetParameters(const float frequency, const float resonance);
+
+  static const Filter_Meta& Meta(void);
+
+ private:
+  float y1_;  ///< One pole filters outputs
+  float y2_;
+  float y3_;
+  float y4_;
+  float oldx_;  ///< One pole filters inputs
+  float oldy1_;
+  float oldy2_;
+  float oldy3_;
+  float r_;  ///< Feedback amount
+  float p_;  ///< Zero coefficient
+  float k_;  ///< Pole coefficient
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_H_
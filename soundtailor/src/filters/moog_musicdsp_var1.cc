@@ -0,0 +1,102 @@
+/// @file moog_musicdsp_var1.cc
+/// @brief Moog low pass filter, MusicDSP variation 1 - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/moog_musicdsp_var1.h"
+
+namespace soundtailor {
+namespace filters {
+
+MoogMusicDSPVar1::MoogMusicDSPVar1()
+    : b0_(0.0f),
+      b1_(0.0f),
+      b2_(0.0f),
+      b3_(0.0f),
+      b4_(0.0f),
+      f_(0.0f),
+      p_(0.0f),
+      q_(0.0f) {
+  // Nothing to do here for now
+}
+
+float MoogMusicDSPVar1::operator()(float sample) {
+  // Feedback
+  const float input(sample - q_ * b4_);
+
+  float t1(b1_);
+  b1_ = (input + b0_) * p_ - b1_ * f_;
+  const float t2(b2_);
+  b2_ = (b1_ + t1) * p_ - b2_ * f_;
+  t1 = b3_;
+  b3_ = (b2_ + t2) * p_ - b3_ * f_;
+  b4_ = (b3_ + t1) * p_ - b4_ * f_;
+
+  // Clipping
+  b4_ -= b4_ * b4_ * b4_ * 0.166667f;
+  b0_ = input;
+
+  return b4_;
+}
+
+Sample MoogMusicDSPVar1::operator()(SampleRead sample) {
+  float out_v[4];
+  for (unsigned int i = 0; i < SampleSize; ++i) {
+    out_v[i] = (*this)(VectorMath::GetByIndex(sample, i));
+  }
+  return VectorMath::Fill(out_v[0], out_v[1], out_v[2], out_v[3]);
+}
+
+void MoogMusicDSPVar1::ProcessBlock(BlockIn in,
+                                    BlockOut out,
+                                    const std::size_t block_size) {
+  for (std::size_t i(0); i < block_size; ++i) {
+    out[i] = (*this)(in[i]);
+  }
+}
+
+void MoogMusicDSPVar1::SetParameters(const float frequency,
+                                     const float resonance) {
+  SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
+  SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
+  SOUNDTAILOR_ASSERT(resonance >= Meta().res_min);
+  SOUNDTAILOR_ASSERT(resonance <= Meta().res_max);
+  const float kFrequency(frequency / 2.0f);
+  const float kInverse(1.0f - kFrequency);
+  p_ = kFrequency + 0.8f * kFrequency * kInverse;
+  f_ = p_ + p_ - 1.0f;
+  q_ = resonance * (1.0f + 0.5f * kInverse * (1.0f - kInverse
+                                              + 5.6f * kInverse * kInverse));
+}
+
+const Filter_Meta& MoogMusicDSPVar1::Meta(void) {
+  static const Filter_Meta metas(1e-5f,
+                                 1.0f,
+                                 1.0f,
+                                 0.0f,
+                                 0.0f,
+                                 1.0f,
+                                 0,
+                                 1.0f);
+  return metas;
+}
+
+}  // namespace filters
+}  // namespace soundtailor
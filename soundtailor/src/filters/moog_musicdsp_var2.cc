@@ -0,0 +1,100 @@
+/// @file moog_musicdsp_var2.cc
+/// @brief Moog low pass filter, MusicDSP variation 2 - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/moog_musicdsp_var2.h"
+
+namespace soundtailor {
+namespace filters {
+
+MoogMusicDSPVar2::MoogMusicDSPVar2()
+    : out1_(0.0f),
+      out2_(0.0f),
+      out3_(0.0f),
+      out4_(0.0f),
+      in1_(0.0f),
+      in2_(0.0f),
+      in3_(0.0f),
+      in4_(0.0f),
+      f_(0.0f),
+      fb_(0.0f),
+      input_gain_(0.0f) {
+  // Nothing to do here for now
+}
+
+float MoogMusicDSPVar2::operator()(float sample) {
+  // Feedback
+  const float input((sample - out4_ * fb_) * input_gain_);
+  const float kPole(1.0f - f_);
+
+  out1_ = input + 0.3f * in1_ + kPole * out1_;
+  in1_ = input;
+  out2_ = out1_ + 0.3f * in2_ + kPole * out2_;
+  in2_ = out1_;
+  out3_ = out2_ + 0.3f * in3_ + kPole * out3_;
+  in3_ = out2_;
+  out4_ = out3_ + 0.3f * in4_ + kPole * out4_;
+  in4_ = out3_;
+
+  return out4_;
+}
+
+Sample MoogMusicDSPVar2::operator()(SampleRead sample) {
+  float out_v[4];
+  for (unsigned int i = 0; i < SampleSize; ++i) {
+    out_v[i] = (*this)(VectorMath::GetByIndex(sample, i));
+  }
+  return VectorMath::Fill(out_v[0], out_v[1], out_v[2], out_v[3]);
+}
+
+void MoogMusicDSPVar2::ProcessBlock(BlockIn in,
+                                    BlockOut out,
+                                    const std::size_t block_size) {
+  for (std::size_t i(0); i < block_size; ++i) {
+    out[i] = (*this)(in[i]);
+  }
+}
+
+void MoogMusicDSPVar2::SetParameters(const float frequency,
+                                     const float resonance) {
+  SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
+  SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
+  SOUNDTAILOR_ASSERT(resonance >= Meta().res_min);
+  SOUNDTAILOR_ASSERT(resonance <= Meta().res_max);
+  f_ = frequency * 1.16f;
+  fb_ = resonance * (1.0f - 0.15f * f_ * f_);
+  input_gain_ = 0.35013f * (f_ * f_) * (f_ * f_);
+}
+
+const Filter_Meta& MoogMusicDSPVar2::Meta(void) {
+  static const Filter_Meta metas(1e-5f,
+                                 1.0f,
+                                 1.0f,
+                                 0.0f,
+                                 0.0f,
+                                 3.9999f,
+                                 0,
+                                 1.0f);
+  return metas;
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,70 @@
+/// @file moog_musicdsp_var2.h
+/// @brief Moog low pass filter, MusicDSP variation 2
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_VAR2_H_
+#define SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_VAR2_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/filters/filter_base.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Moog low pass filter based on MusicDSP source:
+/// http://musicdsp.org/showArchiveComment.php?ArchiveID=26
+///
+/// Linear (no clipping at all), hence the cheapest of all Moog variants.
+/// Frequency is normalized to Nyquist, resonance within [0.0 ; 4.0]
+class MoogMusicDSPVar2 {
+ public:
+  MoogMusicDSPVar2();
+
+  float operator()(float sample);
+  Sample operator()(SampleRead sample);
+  /// @brief Filter a whole block, without any per-Sample lanes shuffling
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Block length
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+  void SetParameters(const float frequency, const float resonance);
+
+  static const Filter_Meta& Meta(void);
+
+ private:
+  float out1_;  ///< One pole filters outputs
+  float out2_;
+  float out3_;
+  float out4_;
+  float in1_;  ///< One pole filters inputs
+  float in2_;
+  float in3_;
+  float in4_;
+  float f_;  ///< Corrected frequency
+  float fb_;  ///< Feedback amount
+  float input_gain_;  ///< Compensates the low pass gain at DC
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_MOOG_MUSICDSP_VAR2_H_
@@ -0,0 +1,191 @@
+/// @file saturators.h
+/// @brief Branchless saturation functions, scalar and vectorized
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_SATURATORS_H_
+#define SOUNDTAILOR_SRC_FILTERS_SATURATORS_H_
+
+// std::min, std::max
+#include <algorithm>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/instrumentation.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Hard clipping: limit the input into [-limit ; limit]
+static inline float HardClip(const float sample, const float limit = 1.0f) {
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  if (sample < -limit || sample > limit) {
+    SOUNDTAILOR_COUNT(kProbeSaturatorClip);
+  }
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+  return std::min(std::max(sample, -limit), limit);
+}
+
+static inline Sample HardClip(SampleRead sample, const float limit = 1.0f) {
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    const float kLane(VectorMath::GetByIndex(sample, i));
+    if (kLane < -limit || kLane > limit) {
+      SOUNDTAILOR_COUNT(kProbeSaturatorClip);
+    }
+  }
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+  return VectorMath::Clamp(sample,
+                           VectorMath::Fill(-limit),
+                           VectorMath::Fill(limit));
+}
+
+/// @brief Cubic soft clipping: x - x^3 / 3 within [-1.0 ; 1.0],
+/// then constant (+/- 2 / 3) with a continuous first derivative
+static inline float SoftClipCubic(const float sample) {
+  const float kClipped(HardClip(sample));
+  return kClipped - kClipped * kClipped * kClipped / 3.0f;
+}
+
+static inline Sample SoftClipCubic(SampleRead sample) {
+  const Sample kClipped(HardClip(sample));
+  const Sample kCube(VectorMath::Mul(kClipped,
+                                     VectorMath::Mul(kClipped, kClipped)));
+  return VectorMath::Sub(kClipped, VectorMath::MulConst(1.0f / 3.0f, kCube));
+}
+
+/// @brief Rational approximation of the hyperbolic tangent:
+/// x (27 + x^2) / (27 + 9 x^2), reaching +/- 1 at +/- 3 then constant
+///
+/// Maximum error is below 0.025, and it is continuous up to its
+/// first derivative
+static inline float TanhRational(const float sample) {
+  const float kClipped(HardClip(sample, 3.0f));
+  const float kSquare(kClipped * kClipped);
+  return kClipped * (27.0f + kSquare) / (27.0f + 9.0f * kSquare);
+}
+
+static inline Sample TanhRational(SampleRead sample) {
+  const Sample kClipped(HardClip(sample, 3.0f));
+  const Sample kSquare(VectorMath::Mul(kClipped, kClipped));
+  const Sample kNumerator(VectorMath::Mul(
+    kClipped,
+    VectorMath::Add(VectorMath::Fill(27.0f), kSquare)));
+  const Sample kDenominator(VectorMath::Add(VectorMath::Fill(27.0f),
+                                            VectorMath::MulConst(9.0f,
+                                                                 kSquare)));
+  return VectorMath::Mul(kNumerator, VectorMath::Reciprocal(kDenominator));
+}
+
+/// @brief Hard clipping shape, for use with Adaa
+struct HardClipShape {
+  static Sample Apply(SampleRead sample) {
+    return HardClip(sample);
+  }
+
+  /// @brief Antiderivative: x^2 / 2 within [-1.0 ; 1.0], |x| - 1 / 2 beyond
+  static Sample AntiDerivative(SampleRead sample) {
+    // Branchless: F(c) + f(c) (x - c), c being the clipped input
+    const Sample kClipped(HardClip(sample));
+    return VectorMath::Sub(
+      VectorMath::Mul(kClipped, sample),
+      VectorMath::MulConst(0.5f, VectorMath::Mul(kClipped, kClipped)));
+  }
+};
+
+/// @brief Cubic soft clipping shape, for use with Adaa
+struct SoftClipCubicShape {
+  static Sample Apply(SampleRead sample) {
+    return SoftClipCubic(sample);
+  }
+
+  /// @brief Antiderivative: x^2 / 2 - x^4 / 12 within [-1.0 ; 1.0],
+  /// 2 |x| / 3 - 1 / 4 beyond
+  static Sample AntiDerivative(SampleRead sample) {
+    // Branchless: F(c) + f(c) (x - c), c being the clipped input
+    const Sample kClipped(HardClip(sample));
+    const Sample kSquare(VectorMath::Mul(kClipped, kClipped));
+    const Sample kInner(VectorMath::Sub(
+      VectorMath::MulConst(0.5f, kSquare),
+      VectorMath::MulConst(1.0f / 12.0f, VectorMath::Mul(kSquare, kSquare))));
+    return VectorMath::Add(
+      kInner,
+      VectorMath::Mul(SoftClipCubic(kClipped),
+                      VectorMath::Sub(sample, kClipped)));
+  }
+};
+
+/// @brief First order antiderivative anti-aliasing of the given shape:
+///
+/// y(n) = (F(x(n)) - F(x(n - 1))) / (x(n) - x(n - 1))
+///
+/// F being the shape antiderivative. It introduces a half sample delay.
+/// Consecutive inputs too close to each other fall back to
+/// f((x(n) + x(n - 1)) / 2), without any branching.
+template <typename ShapeType>
+class Adaa {
+ public:
+  Adaa()
+      : last_input_(0.0f),
+        last_antiderivative_(0.0f) {
+    // Nothing to do here for now
+  }
+
+  /// @brief Process SampleSize consecutive samples
+  Sample operator()(SampleRead sample) {
+    const Sample kAntiDerivative(ShapeType::AntiDerivative(sample));
+    const Sample kPrevious(VectorMath::RotateOnRight(sample, last_input_));
+    const Sample kPreviousAntiDerivative(
+      VectorMath::RotateOnRight(kAntiDerivative, last_antiderivative_));
+    last_input_ = VectorMath::GetLast(sample);
+    last_antiderivative_ = VectorMath::GetLast(kAntiDerivative);
+
+    const Sample kDifference(VectorMath::Sub(sample, kPrevious));
+    const Sample kEpsilon(VectorMath::Fill(1e-3f));
+    const Sample kAbsDifference(VectorMath::Abs(kDifference));
+    const Sample kIsSmall(VectorMath::LessThan(kAbsDifference, kEpsilon));
+    const Sample kIsLarge(VectorMath::LessEqual(kEpsilon, kAbsDifference));
+    // Avoiding a division by zero, the result being discarded anyway
+    const Sample kSafeDifference(VectorMath::Add(
+      kDifference,
+      VectorMath::ExtractValueFromMask(VectorMath::Fill(1.0f), kIsSmall)));
+    const Sample kAntiAliased(VectorMath::Mul(
+      VectorMath::Sub(kAntiDerivative, kPreviousAntiDerivative),
+      VectorMath::Reciprocal(kSafeDifference)));
+    const Sample kFallback(ShapeType::Apply(
+      VectorMath::MulConst(0.5f, VectorMath::Add(sample, kPrevious))));
+    return VectorMath::Add(
+      VectorMath::ExtractValueFromMask(kAntiAliased, kIsLarge),
+      VectorMath::ExtractValueFromMask(kFallback, kIsSmall));
+  }
+
+  /// @brief Clear the input history
+  void Reset(void) {
+    last_input_ = 0.0f;
+    last_antiderivative_ = 0.0f;
+  }
+
+ private:
+  float last_input_;
+  float last_antiderivative_;
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_SATURATORS_H_
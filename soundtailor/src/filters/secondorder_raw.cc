@@ -21,6 +21,7 @@
 // std::sin, std::cos
 #include <cmath>
 
+#include "soundtailor/src/instrumentation.h"
 #include "soundtailor/src/maths.h"
 
 #include "soundtailor/src/filters/secondorder_raw.h"
@@ -71,20 +72,9 @@ Sample SecondOrderRaw::operator()(SampleRead sample) {
   const Sample history(VectorMath::TakeEachRightHalf(sample, out));
   VectorMath::Store(&history_[0], history);
 #else
-  // @todo(gm) find out what's going wrong above
   float out_v[4];
   for (unsigned int i = 0; i < SampleSize; ++i) {
-    const float current_sample = VectorMath::GetByIndex(sample, i);
-    const float out(gain_ * current_sample
-                    + history_[0] * coeffs_[0]
-                    + history_[1] * coeffs_[1]
-                    + history_[2] * coeffs_[2]
-                    + history_[3] * coeffs_[3]);
-    history_[0] = history_[1];
-    history_[1] = current_sample;
-    history_[2] = history_[3];
-    history_[3] = out;
-    out_v[i] = out;
+    out_v[i] = (*this)(VectorMath::GetByIndex(sample, i));
   }
   const Sample out(VectorMath::Fill(out_v[0], out_v[1], out_v[2], out_v[3]));
 #endif  // 1
@@ -92,8 +82,22 @@ Sample SecondOrderRaw::operator()(SampleRead sample) {
   return out;
 }
 
+float SecondOrderRaw::operator()(float sample) {
+  const float out(VectorMath::GetByIndex<0>(gain_) * sample
+                  + history_[0] * coeffs_[0]
+                  + history_[1] * coeffs_[1]
+                  + history_[2] * coeffs_[2]
+                  + history_[3] * coeffs_[3]);
+  history_[0] = history_[1];
+  history_[1] = sample;
+  history_[2] = history_[3];
+  history_[3] = out;
+  return out;
+}
+
 void SecondOrderRaw::SetParameters(const float frequency,
                                    const float resonance) {
+  SOUNDTAILOR_TIME_SCOPE(kProbeSecondOrderRawSetParameters);
   // Based on Audio EQ Cookbook material
   SOUNDTAILOR_ASSERT(frequency >= Meta().freq_min);
   SOUNDTAILOR_ASSERT(frequency <= Meta().freq_max);
@@ -34,6 +34,8 @@ class SecondOrderRaw {
   SecondOrderRaw();
 
   Sample operator()(SampleRead sample);
+  /// @brief Scalar reference implementation
+  float operator()(float sample);
   void SetParameters(const float frequency, const float resonance);
 
   static const Filter_Meta& Meta(void);
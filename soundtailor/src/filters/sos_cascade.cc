@@ -0,0 +1,261 @@
+/// @file sos_cascade.cc
+/// @brief Cascade of second order sections, vectorized - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/sos_cascade.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Helper structure for holding one group of sections (or channels)
+struct SosGroup {
+  Sample b0;
+  Sample b1;
+  Sample b2;
+  Sample a1;
+  Sample a2;
+  Sample s1;
+  Sample s2;
+};
+
+/// @brief Transposed direct form II computation for one group,
+/// updating its states
+static inline Sample Tick(SampleRead input, SosGroup* group) {
+  const Sample kOutput(VectorMath::Add(VectorMath::Mul(group->b0, input),
+                                       group->s1));
+  group->s1 = VectorMath::Add(
+    VectorMath::Sub(VectorMath::Mul(group->b1, input),
+                    VectorMath::Mul(group->a1, kOutput)),
+    group->s2);
+  group->s2 = VectorMath::Sub(VectorMath::Mul(group->b2, input),
+                              VectorMath::Mul(group->a2, kOutput));
+  return kOutput;
+}
+
+/// @brief Same as above, only updating states of lanes in "active":
+/// "inactive" has to be its complement
+///
+/// Selection is done by adding masked values, one of them being zero:
+/// contrary to a blend it is exact
+static inline Sample TickMasked(SampleRead input,
+                                SampleRead active,
+                                SampleRead inactive,
+                                SosGroup* group) {
+  const Sample kPreviousS1(group->s1);
+  const Sample kPreviousS2(group->s2);
+  const Sample kOutput(Tick(input, group));
+  group->s1 = VectorMath::Add(
+    VectorMath::ExtractValueFromMask(group->s1, active),
+    VectorMath::ExtractValueFromMask(kPreviousS1, inactive));
+  group->s2 = VectorMath::Add(
+    VectorMath::ExtractValueFromMask(group->s2, active),
+    VectorMath::ExtractValueFromMask(kPreviousS2, inactive));
+  return kOutput;
+}
+
+SosCascade::SosCascade(const unsigned int sections_count)
+    : sections_count_(sections_count),
+      b0_(),
+      b1_(),
+      b2_(),
+      a1_(),
+      a2_(),
+      s1_(),
+      s2_() {
+  SOUNDTAILOR_ASSERT(sections_count > 0);
+  SOUNDTAILOR_ASSERT(sections_count <= kMaxSections);
+  for (unsigned int i(0); i < kMaxSections; ++i) {
+    SetSection(i, BiquadIdentity());
+  }
+}
+
+Sample SosCascade::operator()(SampleRead sample) {
+  alignas(16) float input[SampleSize];
+  alignas(16) float output[SampleSize];
+  VectorMath::Store(&input[0], sample);
+  ProcessBlock(&input[0], &output[0], SampleSize);
+  return VectorMath::Fill(&output[0]);
+}
+
+void SosCascade::ProcessBlock(BlockIn in,
+                              BlockOut out,
+                              const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size > 0);
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  const unsigned int kGroupsCount((sections_count_ + SampleSize - 1)
+                                  / SampleSize);
+  ProcessGroup(0, in, out, block_size);
+  // Following groups work in place
+  for (unsigned int group(1); group < kGroupsCount; ++group) {
+    ProcessGroup(group, out, out, block_size);
+  }
+}
+
+void SosCascade::SetSection(const unsigned int index,
+                            const BiquadCoefficients& coefficients) {
+  SOUNDTAILOR_ASSERT(index < kMaxSections);
+  b0_[index] = coefficients.b0;
+  b1_[index] = coefficients.b1;
+  b2_[index] = coefficients.b2;
+  a1_[index] = coefficients.a1;
+  a2_[index] = coefficients.a2;
+}
+
+unsigned int SosCascade::GetSectionsCount(void) const {
+  return sections_count_;
+}
+
+void SosCascade::Reset(void) {
+  for (unsigned int i(0); i < kMaxSections; ++i) {
+    s1_[i] = 0.0f;
+    s2_[i] = 0.0f;
+  }
+}
+
+void SosCascade::ProcessGroup(const unsigned int group,
+                              const float* in,
+                              float* out,
+                              const std::size_t block_size) {
+  // Input and output may alias: the output is always written behind
+  // the input being read
+  const unsigned int kOffset(group * SampleSize);
+  SosGroup sections = {
+    VectorMath::Fill(&b0_[kOffset]),
+    VectorMath::Fill(&b1_[kOffset]),
+    VectorMath::Fill(&b2_[kOffset]),
+    VectorMath::Fill(&a1_[kOffset]),
+    VectorMath::Fill(&a2_[kOffset]),
+    VectorMath::Fill(&s1_[kOffset]),
+    VectorMath::Fill(&s2_[kOffset])
+  };
+  const Sample kLanes(VectorMath::Fill(0.0f, 1.0f, 2.0f, 3.0f));
+  // Lane i processes sample (t - i) at time step t
+  const std::size_t kPipelineDelay(SampleSize - 1);
+  Sample outputs(VectorMath::Fill(0.0f));
+
+  // Pipeline filling: lanes > t are not processing anything yet
+  for (std::size_t t(0); t < kPipelineDelay; ++t) {
+    const Sample kStep(VectorMath::Fill(static_cast<float>(t)));
+    outputs = TickMasked(VectorMath::RotateOnRight(outputs, in[t]),
+                         VectorMath::LessEqual(kLanes, kStep),
+                         VectorMath::LessThan(kStep, kLanes),
+                         &sections);
+  }
+  // Steady state
+  for (std::size_t t(kPipelineDelay); t < block_size; ++t) {
+    outputs = Tick(VectorMath::RotateOnRight(outputs, in[t]), &sections);
+    out[t - kPipelineDelay] = VectorMath::GetByIndex<SampleSize - 1>(outputs);
+  }
+  // Pipeline draining: lanes <= (t - block_size) are done
+  for (std::size_t t(block_size); t < block_size + kPipelineDelay; ++t) {
+    const Sample kStep(VectorMath::Fill(static_cast<float>(t - block_size)));
+    outputs = TickMasked(VectorMath::RotateOnRight(outputs, 0.0f),
+                         VectorMath::LessThan(kStep, kLanes),
+                         VectorMath::LessEqual(kLanes, kStep),
+                         &sections);
+    out[t - kPipelineDelay] = VectorMath::GetByIndex<SampleSize - 1>(outputs);
+  }
+
+  VectorMath::Store(&s1_[kOffset], sections.s1);
+  VectorMath::Store(&s2_[kOffset], sections.s2);
+}
+
+SosCascadeParallel::SosCascadeParallel(const unsigned int sections_count)
+    : sections_count_(sections_count),
+      b0_(),
+      b1_(),
+      b2_(),
+      a1_(),
+      a2_(),
+      s1_(),
+      s2_() {
+  SOUNDTAILOR_ASSERT(sections_count > 0);
+  SOUNDTAILOR_ASSERT(sections_count <= kMaxSections);
+  for (unsigned int i(0); i < kMaxSections; ++i) {
+    SetSection(i, BiquadIdentity());
+  }
+}
+
+Sample SosCascadeParallel::operator()(SampleRead frame) {
+  Sample current(frame);
+  for (unsigned int i(0); i < sections_count_; ++i) {
+    const unsigned int kOffset(i * SampleSize);
+    SosGroup section = {
+      VectorMath::Fill(&b0_[kOffset]),
+      VectorMath::Fill(&b1_[kOffset]),
+      VectorMath::Fill(&b2_[kOffset]),
+      VectorMath::Fill(&a1_[kOffset]),
+      VectorMath::Fill(&a2_[kOffset]),
+      VectorMath::Fill(&s1_[kOffset]),
+      VectorMath::Fill(&s2_[kOffset])
+    };
+    current = Tick(current, &section);
+    VectorMath::Store(&s1_[kOffset], section.s1);
+    VectorMath::Store(&s2_[kOffset], section.s2);
+  }
+  return current;
+}
+
+void SosCascadeParallel::ProcessBlock(BlockIn in,
+                                      BlockOut out,
+                                      const std::size_t length) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < length; ++i) {
+    VectorMath::Store(out_write, (*this)(VectorMath::Fill(in_ptr)));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+void SosCascadeParallel::SetSection(const unsigned int index,
+                                    const BiquadCoefficients& coefficients) {
+  for (unsigned int channel(0); channel < SampleSize; ++channel) {
+    SetSection(channel, index, coefficients);
+  }
+}
+
+void SosCascadeParallel::SetSection(const unsigned int channel,
+                                    const unsigned int index,
+                                    const BiquadCoefficients& coefficients) {
+  SOUNDTAILOR_ASSERT(channel < SampleSize);
+  SOUNDTAILOR_ASSERT(index < kMaxSections);
+  const unsigned int kOffset(index * SampleSize);
+  b0_[kOffset + channel] = coefficients.b0;
+  b1_[kOffset + channel] = coefficients.b1;
+  b2_[kOffset + channel] = coefficients.b2;
+  a1_[kOffset + channel] = coefficients.a1;
+  a2_[kOffset + channel] = coefficients.a2;
+}
+
+unsigned int SosCascadeParallel::GetSectionsCount(void) const {
+  return sections_count_;
+}
+
+void SosCascadeParallel::Reset(void) {
+  for (unsigned int i(0); i < kMaxSections * SampleSize; ++i) {
+    s1_[i] = 0.0f;
+    s2_[i] = 0.0f;
+  }
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,137 @@
+/// @file sos_cascade.h
+/// @brief Cascade of second order sections, vectorized
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_SOS_CASCADE_H_
+#define SOUNDTAILOR_SRC_FILTERS_SOS_CASCADE_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/filters/biquad_designer.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Cascade of second order sections (transposed direct form II)
+/// for a single channel
+///
+/// Each Sample lane holds a different section: sections are processed
+/// by groups of SampleSize, pipelined across lanes. At each time step
+/// lane i processes the sample which lane (i - 1) processed at the
+/// previous step, so that all lanes do useful work at once.
+/// The pipeline is filled and drained within each block, hence there is
+/// no added latency: output matches a serial cascade.
+/// Unused sections let the signal through.
+class SosCascade {
+ public:
+  /// @brief Maximum sections count
+  static const unsigned int kMaxSections = 16;
+
+  explicit SosCascade(const unsigned int sections_count);
+
+  /// @brief Filter SampleSize consecutive samples
+  ///
+  /// Pipeline fill and drain make it much less efficient than ProcessBlock()
+  Sample operator()(SampleRead sample);
+  /// @brief Filter a whole block
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+
+  /// @brief Set coefficients of the given section,
+  /// e.g. as computed by DesignBiquad()
+  void SetSection(const unsigned int index,
+                  const BiquadCoefficients& coefficients);
+  unsigned int GetSectionsCount(void) const;
+  /// @brief Clear all sections states
+  void Reset(void);
+
+ private:
+  /// @brief Filter a whole block through sections
+  /// [group * SampleSize ; (group + 1) * SampleSize)
+  void ProcessGroup(const unsigned int group,
+                    const float* in,
+                    float* out,
+                    const std::size_t block_size);
+
+  unsigned int sections_count_;
+  // One value per section, SampleSize consecutive sections per group
+  alignas(16) float b0_[kMaxSections];
+  alignas(16) float b1_[kMaxSections];
+  alignas(16) float b2_[kMaxSections];
+  alignas(16) float a1_[kMaxSections];
+  alignas(16) float a2_[kMaxSections];
+  alignas(16) float s1_[kMaxSections];  ///< First states
+  alignas(16) float s2_[kMaxSections];  ///< Second states
+};
+
+/// @brief Cascade of second order sections for SampleSize channels:
+/// each Sample lane holds a different channel, instead of a different
+/// time step
+///
+/// Since there is no dependency between lanes, all computations
+/// are vectorized; each channel may have its own coefficients.
+class SosCascadeParallel {
+ public:
+  /// @brief Maximum sections count
+  static const unsigned int kMaxSections = SosCascade::kMaxSections;
+
+  explicit SosCascadeParallel(const unsigned int sections_count);
+
+  /// @brief Filter one time step of all channels
+  Sample operator()(SampleRead frame);
+  /// @brief Filter length time steps of all channels
+  ///
+  /// @param[in]  in   Input frames, SampleSize values per time step
+  /// (interleaved channels), length * SampleSize long
+  /// @param[out]  out   Output frames, same layout as the input
+  /// @param[in]  length   Number of time steps
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t length);
+
+  /// @brief Set coefficients of the given section for all channels
+  void SetSection(const unsigned int index,
+                  const BiquadCoefficients& coefficients);
+  /// @brief Set coefficients of the given section for one channel only
+  void SetSection(const unsigned int channel,
+                  const unsigned int index,
+                  const BiquadCoefficients& coefficients);
+  unsigned int GetSectionsCount(void) const;
+  /// @brief Clear all sections states
+  void Reset(void);
+
+ private:
+  unsigned int sections_count_;
+  // SampleSize values (one per channel) per section
+  alignas(16) float b0_[kMaxSections * SampleSize];
+  alignas(16) float b1_[kMaxSections * SampleSize];
+  alignas(16) float b2_[kMaxSections * SampleSize];
+  alignas(16) float a1_[kMaxSections * SampleSize];
+  alignas(16) float a2_[kMaxSections * SampleSize];
+  alignas(16) float s1_[kMaxSections * SampleSize];  ///< First states
+  alignas(16) float s2_[kMaxSections * SampleSize];  ///< Second states
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_SOS_CASCADE_H_
@@ -0,0 +1,308 @@
+/// @file state_variable.cc
+/// @brief Zero-delay feedback (TPT) state variable filters - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::tan
+#include <cmath>
+
+#include "soundtailor/src/instrumentation.h"
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/filters/state_variable.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Helper structure for holding one filter coefficients
+struct StateVariableCoefficients {
+  float a1;
+  float a2;
+  float a3;
+  float damping;
+};
+
+/// @brief Compute filter coefficients for the given parameters
+static StateVariableCoefficients ComputeCoefficients(const float frequency,
+                                                     const float resonance) {
+  SOUNDTAILOR_ASSERT(frequency >= StateVariable::Meta().freq_min);
+  SOUNDTAILOR_ASSERT(frequency <= StateVariable::Meta().freq_max);
+  SOUNDTAILOR_ASSERT(resonance >= StateVariable::Meta().res_min);
+  SOUNDTAILOR_ASSERT(resonance <= StateVariable::Meta().res_max);
+  // Computations done in double since precision is crucial here
+  // Prewarped integrators gain
+  const double kGain(std::tan(Pi * static_cast<double>(frequency)));
+  const double kDamping(1.0 / static_cast<double>(resonance));
+  const double kA1(1.0 / (1.0 + kGain * (kGain + kDamping)));
+  const double kA2(kGain * kA1);
+  const double kA3(kGain * kA2);
+  const StateVariableCoefficients out = {
+    static_cast<float>(kA1),
+    static_cast<float>(kA2),
+    static_cast<float>(kA3),
+    static_cast<float>(kDamping)
+  };
+  return out;
+}
+
+/// @brief Compute the output mix gains (input, band pass, low pass)
+/// for the given output
+static void ComputeOutputGains(const StateVariableOutput output,
+                               const float damping,
+                               float* input_gain,
+                               float* band_pass_gain,
+                               float* low_pass_gain) {
+  switch (output) {
+    case(kSvfLowPass): {
+      *input_gain = 0.0f;
+      *band_pass_gain = 0.0f;
+      *low_pass_gain = 1.0f;
+      break;
+    }
+    case(kSvfBandPass): {
+      *input_gain = 0.0f;
+      *band_pass_gain = 1.0f;
+      *low_pass_gain = 0.0f;
+      break;
+    }
+    case(kSvfHighPass): {
+      *input_gain = 1.0f;
+      *band_pass_gain = -damping;
+      *low_pass_gain = -1.0f;
+      break;
+    }
+    case(kSvfNotch): {
+      *input_gain = 1.0f;
+      *band_pass_gain = -damping;
+      *low_pass_gain = 0.0f;
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(output)
+}
+
+StateVariable::StateVariable(const StateVariableOutput output)
+    : ic1eq_(0.0f),
+      ic2eq_(0.0f),
+      a1_(0.0f),
+      a2_(0.0f),
+      a3_(0.0f),
+      damping_(0.0f),
+      input_gain_(0.0f),
+      band_pass_gain_(0.0f),
+      low_pass_gain_(0.0f),
+      output_(output) {
+  SetOutput(output);
+}
+
+Sample StateVariable::operator()(SampleRead sample) {
+  alignas(16) float out[SampleSize];
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    out[i] = ProcessOne(VectorMath::GetByIndex(sample, i));
+  }
+  return VectorMath::Fill(&out[0]);
+}
+
+void StateVariable::Process(SampleRead sample,
+                            Sample* low_pass,
+                            Sample* band_pass,
+                            Sample* high_pass) {
+  alignas(16) float low_pass_v[SampleSize];
+  alignas(16) float band_pass_v[SampleSize];
+  alignas(16) float high_pass_v[SampleSize];
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    const float v0(VectorMath::GetByIndex(sample, i));
+    Tick(v0, &band_pass_v[i], &low_pass_v[i]);
+    high_pass_v[i] = v0 - damping_ * band_pass_v[i] - low_pass_v[i];
+  }
+  *low_pass = VectorMath::Fill(&low_pass_v[0]);
+  *band_pass = VectorMath::Fill(&band_pass_v[0]);
+  *high_pass = VectorMath::Fill(&high_pass_v[0]);
+}
+
+void StateVariable::ProcessBlock(BlockIn in,
+                                 BlockOut out,
+                                 const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  // No need to go through Samples here, the recursion being sequential anyway
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < block_size; ++i) {
+    out_write[i] = ProcessOne(in_ptr[i]);
+  }
+}
+
+void StateVariable::SetParameters(const float frequency,
+                                  const float resonance) {
+  SOUNDTAILOR_TIME_SCOPE(kProbeStateVariableSetParameters);
+  const StateVariableCoefficients kCoefficients(
+    ComputeCoefficients(frequency, resonance));
+  a1_ = kCoefficients.a1;
+  a2_ = kCoefficients.a2;
+  a3_ = kCoefficients.a3;
+  damping_ = kCoefficients.damping;
+  SetOutput(output_);
+}
+
+void StateVariable::SetOutput(const StateVariableOutput output) {
+  output_ = output;
+  ComputeOutputGains(output_,
+                     damping_,
+                     &input_gain_,
+                     &band_pass_gain_,
+                     &low_pass_gain_);
+}
+
+const Filter_Meta& StateVariable::Meta(void) {
+  static const Filter_Meta metas(1e-5f,
+                                 0.4999f,
+                                 0.4999f,
+                                 0.01f,
+                                 0.7071f,
+                                 1000.0f,
+                                 0,
+                                 1.0f);
+  return metas;
+}
+
+float StateVariable::ProcessOne(const float sample) {
+  float band_pass;
+  float low_pass;
+  Tick(sample, &band_pass, &low_pass);
+  return input_gain_ * sample
+         + band_pass_gain_ * band_pass
+         + low_pass_gain_ * low_pass;
+}
+
+void StateVariable::Tick(const float sample,
+                         float* band_pass,
+                         float* low_pass) {
+  // Both integrators outputs are solved at once, without any delay
+  const float v3(sample - ic2eq_);
+  const float v1(a1_ * ic1eq_ + a2_ * v3);
+  const float v2(ic2eq_ + a2_ * ic1eq_ + a3_ * v3);
+  ic1eq_ = 2.0f * v1 - ic1eq_;
+  ic2eq_ = 2.0f * v2 - ic2eq_;
+  *band_pass = v1;
+  *low_pass = v2;
+}
+
+StateVariableParallel::StateVariableParallel(
+    const StateVariableOutput output)
+    : ic1eq_(VectorMath::Fill(0.0f)),
+      ic2eq_(VectorMath::Fill(0.0f)),
+      a1_(VectorMath::Fill(0.0f)),
+      a2_(VectorMath::Fill(0.0f)),
+      a3_(VectorMath::Fill(0.0f)),
+      input_gain_(VectorMath::Fill(0.0f)),
+      band_pass_gain_(VectorMath::Fill(0.0f)),
+      low_pass_gain_(VectorMath::Fill(0.0f)),
+      damping_(),
+      output_(output) {
+  SetOutput(output);
+}
+
+Sample StateVariableParallel::operator()(SampleRead frame) {
+  const Sample v3(VectorMath::Sub(frame, ic2eq_));
+  const Sample v1(VectorMath::Add(VectorMath::Mul(a1_, ic1eq_),
+                                  VectorMath::Mul(a2_, v3)));
+  const Sample v2(VectorMath::Add(
+    ic2eq_,
+    VectorMath::Add(VectorMath::Mul(a2_, ic1eq_),
+                    VectorMath::Mul(a3_, v3))));
+  ic1eq_ = VectorMath::Sub(VectorMath::MulConst(2.0f, v1), ic1eq_);
+  ic2eq_ = VectorMath::Sub(VectorMath::MulConst(2.0f, v2), ic2eq_);
+  return VectorMath::Add(
+    VectorMath::Mul(input_gain_, frame),
+    VectorMath::Add(VectorMath::Mul(band_pass_gain_, v1),
+                    VectorMath::Mul(low_pass_gain_, v2)));
+}
+
+void StateVariableParallel::ProcessBlock(BlockIn in,
+                                         BlockOut out,
+                                         const std::size_t length) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < length; ++i) {
+    VectorMath::Store(out_write, (*this)(VectorMath::Fill(in_ptr)));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+void StateVariableParallel::SetParameters(const float frequency,
+                                          const float resonance) {
+  const StateVariableCoefficients kCoefficients(
+    ComputeCoefficients(frequency, resonance));
+  a1_ = VectorMath::Fill(kCoefficients.a1);
+  a2_ = VectorMath::Fill(kCoefficients.a2);
+  a3_ = VectorMath::Fill(kCoefficients.a3);
+  for (unsigned int voice(0); voice < SampleSize; ++voice) {
+    damping_[voice] = kCoefficients.damping;
+  }
+  SetOutput(output_);
+}
+
+void StateVariableParallel::SetParameters(const unsigned int voice,
+                                          const float frequency,
+                                          const float resonance) {
+  SOUNDTAILOR_ASSERT(voice < SampleSize);
+  const StateVariableCoefficients kCoefficients(
+    ComputeCoefficients(frequency, resonance));
+  alignas(16) float a1[SampleSize];
+  alignas(16) float a2[SampleSize];
+  alignas(16) float a3[SampleSize];
+  VectorMath::Store(&a1[0], a1_);
+  VectorMath::Store(&a2[0], a2_);
+  VectorMath::Store(&a3[0], a3_);
+  a1[voice] = kCoefficients.a1;
+  a2[voice] = kCoefficients.a2;
+  a3[voice] = kCoefficients.a3;
+  a1_ = VectorMath::Fill(&a1[0]);
+  a2_ = VectorMath::Fill(&a2[0]);
+  a3_ = VectorMath::Fill(&a3[0]);
+  damping_[voice] = kCoefficients.damping;
+  SetOutput(output_);
+}
+
+void StateVariableParallel::SetOutput(const StateVariableOutput output) {
+  output_ = output;
+  alignas(16) float input_gain[SampleSize];
+  alignas(16) float band_pass_gain[SampleSize];
+  alignas(16) float low_pass_gain[SampleSize];
+  for (unsigned int voice(0); voice < SampleSize; ++voice) {
+    ComputeOutputGains(output_,
+                       damping_[voice],
+                       &input_gain[voice],
+                       &band_pass_gain[voice],
+                       &low_pass_gain[voice]);
+  }
+  input_gain_ = VectorMath::Fill(&input_gain[0]);
+  band_pass_gain_ = VectorMath::Fill(&band_pass_gain[0]);
+  low_pass_gain_ = VectorMath::Fill(&low_pass_gain[0]);
+}
+
+const Filter_Meta& StateVariableParallel::Meta(void) {
+  return StateVariable::Meta();
+}
+
+}  // namespace filters
+}  // namespace soundtailor
@@ -0,0 +1,138 @@
+/// @file state_variable.h
+/// @brief Zero-delay feedback (TPT) state variable filters
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_STATE_VARIABLE_H_
+#define SOUNDTAILOR_SRC_FILTERS_STATE_VARIABLE_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/filters/filter_base.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Available state variable filter outputs
+enum StateVariableOutput {
+  kSvfLowPass = 0,
+  kSvfBandPass,
+  kSvfHighPass,
+  kSvfNotch
+};
+
+/// @brief State variable filter using the topology-preserving transform
+/// (trapezoidal integrators, zero-delay feedback)
+///
+/// Contrary to the Chamberlin filter it is stable for all frequencies
+/// up to Nyquist, without requiring any oversampling.
+/// Frequency is normalized, resonance being the filter quality factor.
+class StateVariable {
+ public:
+  explicit StateVariable(const StateVariableOutput output = kSvfLowPass);
+
+  /// @brief Filter the input, returning the output chosen at construction
+  Sample operator()(SampleRead sample);
+  /// @brief Filter the input, retrieving all outputs at once
+  ///
+  /// The notch output is the sum of the low pass and high pass ones
+  void Process(SampleRead sample,
+               Sample* low_pass,
+               Sample* band_pass,
+               Sample* high_pass);
+  /// @brief Filter a whole block, returning the output chosen at construction
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+
+  void SetParameters(const float frequency, const float resonance);
+  void SetOutput(const StateVariableOutput output);
+
+  static const Filter_Meta& Meta(void);
+
+ private:
+  /// @brief Filter a single sample, the output chosen at construction
+  float ProcessOne(const float sample);
+  /// @brief Actual filter computation for a single sample
+  void Tick(const float sample, float* band_pass, float* low_pass);
+
+  float ic1eq_;  ///< First integrator state
+  float ic2eq_;  ///< Second integrator state
+  float a1_;  ///< Feedback resolution coefficients
+  float a2_;
+  float a3_;
+  float damping_;  ///< Inverse of the quality factor
+  /// Output mix, as gains applied to the input, band pass and low pass:
+  /// all outputs are linear combinations of these three
+  float input_gain_;
+  float band_pass_gain_;
+  float low_pass_gain_;
+  StateVariableOutput output_;
+};
+
+/// @brief Voice-parallel version of the StateVariable filter:
+/// each Sample lane holds a different voice (or channel),
+/// instead of a different time step
+///
+/// Since there is no dependency between lanes, all computations
+/// are vectorized; each voice has its own parameters.
+class StateVariableParallel {
+ public:
+  explicit StateVariableParallel(
+    const StateVariableOutput output = kSvfLowPass);
+
+  /// @brief Filter one time step of all voices
+  Sample operator()(SampleRead frame);
+  /// @brief Filter length time steps of all voices
+  ///
+  /// @param[in]  in   Input frames, SampleSize values per time step
+  /// (interleaved voices), length * SampleSize long
+  /// @param[out]  out   Output frames, same layout as the input
+  /// @param[in]  length   Number of time steps
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t length);
+
+  /// @brief Set the same parameters for all voices
+  void SetParameters(const float frequency, const float resonance);
+  /// @brief Set the parameters of the given voice only
+  void SetParameters(const unsigned int voice,
+                     const float frequency,
+                     const float resonance);
+  void SetOutput(const StateVariableOutput output);
+
+  static const Filter_Meta& Meta(void);
+
+ private:
+  Sample ic1eq_;  ///< First integrators states
+  Sample ic2eq_;  ///< Second integrators states
+  Sample a1_;  ///< Feedback resolution coefficients
+  Sample a2_;
+  Sample a3_;
+  Sample input_gain_;  ///< Output mix gains, see StateVariable
+  Sample band_pass_gain_;
+  Sample low_pass_gain_;
+  alignas(16) float damping_[SampleSize];  ///< Inverse of the quality factors
+  StateVariableOutput output_;
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_STATE_VARIABLE_H_
@@ -0,0 +1,94 @@
+/// @file waveshaper.cc
+/// @brief Static nonlinearity processor - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/filters/waveshaper.h"
+
+namespace soundtailor {
+namespace filters {
+
+Waveshaper::Waveshaper(const WaveshaperShape shape)
+    : hard_clip_adaa_(),
+      soft_clip_adaa_(),
+      shape_(shape),
+      drive_(1.0f),
+      anti_aliasing_(false) {
+  // Nothing to do here for now
+}
+
+Sample Waveshaper::operator()(SampleRead sample) {
+  const Sample kDriven(VectorMath::MulConst(drive_, sample));
+  switch (shape_) {
+    case(kWaveshaperHardClip): {
+      return anti_aliasing_ ? hard_clip_adaa_(kDriven) : HardClip(kDriven);
+    }
+    case(kWaveshaperSoftClipCubic): {
+      return anti_aliasing_ ? soft_clip_adaa_(kDriven)
+                            : SoftClipCubic(kDriven);
+    }
+    case(kWaveshaperTanh): {
+      return TanhRational(kDriven);
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      return kDriven;
+    }
+  }  // switch(shape_)
+}
+
+void Waveshaper::ProcessBlock(BlockIn in,
+                              BlockOut out,
+                              const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    VectorMath::Store(out_write, (*this)(VectorMath::Fill(in_ptr)));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+void Waveshaper::SetShape(const WaveshaperShape shape) {
+  SOUNDTAILOR_ASSERT(!anti_aliasing_ || shape != kWaveshaperTanh);
+  if (shape != shape_) {
+    // The previous shape state, if ever used, is stale
+    hard_clip_adaa_.Reset();
+    soft_clip_adaa_.Reset();
+  }
+  shape_ = shape;
+}
+
+void Waveshaper::SetDrive(const float drive) {
+  SOUNDTAILOR_ASSERT(drive > 0.0f);
+  drive_ = drive;
+}
+
+void Waveshaper::SetAntiAliasing(const bool enabled) {
+  SOUNDTAILOR_ASSERT(!enabled || shape_ != kWaveshaperTanh);
+  if (enabled && !anti_aliasing_) {
+    hard_clip_adaa_.Reset();
+    soft_clip_adaa_.Reset();
+  }
+  anti_aliasing_ = enabled;
+}
+
+}  // namespace filters
+}  // namespace soundtailor
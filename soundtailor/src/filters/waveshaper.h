@@ -0,0 +1,80 @@
+/// @file waveshaper.h
+/// @brief Static nonlinearity processor
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_FILTERS_WAVESHAPER_H_
+#define SOUNDTAILOR_SRC_FILTERS_WAVESHAPER_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/filters/saturators.h"
+
+namespace soundtailor {
+namespace filters {
+
+/// @brief Available waveshaper transfer functions
+enum WaveshaperShape {
+  kWaveshaperHardClip = 0,
+  kWaveshaperSoftClipCubic,
+  kWaveshaperTanh
+};
+
+/// @brief Waveshaper: amplify the input by the drive amount,
+/// then apply a saturating transfer function
+///
+/// Hard and cubic soft clipping optionally use antiderivative
+/// anti-aliasing, at the cost of a half sample delay.
+/// All computations are done on whole Samples, without any data-dependent
+/// branching.
+class Waveshaper {
+ public:
+  explicit Waveshaper(const WaveshaperShape shape = kWaveshaperSoftClipCubic);
+
+  Sample operator()(SampleRead sample);
+  /// @brief Process a whole block
+  ///
+  /// @param[in]  in   Input block, block_size long
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockIn in, BlockOut out, const std::size_t block_size);
+
+  /// @brief Change the transfer function, resetting anti-aliasing state
+  ///
+  /// Tanh cannot be selected while anti-aliasing is enabled
+  void SetShape(const WaveshaperShape shape);
+  /// @brief Set the input gain, has to be positive
+  void SetDrive(const float drive);
+  /// @brief Enable antiderivative anti-aliasing,
+  /// only available for hard and cubic soft clipping
+  void SetAntiAliasing(const bool enabled);
+
+ private:
+  Adaa<HardClipShape> hard_clip_adaa_;
+  Adaa<SoftClipCubicShape> soft_clip_adaa_;
+  WaveshaperShape shape_;
+  float drive_;
+  bool anti_aliasing_;
+};
+
+}  // namespace filters
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_FILTERS_WAVESHAPER_H_
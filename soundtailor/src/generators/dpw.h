@@ -0,0 +1,390 @@
+/// @file dpw.h
+/// @brief Sawtooth signal generator using higher-order DPW algorithm
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_GENERATORS_DPW_H_
+#define SOUNDTAILOR_SRC_GENERATORS_DPW_H_
+
+// std::max, std::min
+#include <algorithm>
+// std::fabs
+#include <cmath>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Polynomial to be applied on the raw sawtooth for each DPW order
+///
+/// Its (Order - 1)th derivative is Order! times the raw sawtooth,
+/// and all its lower derivatives are continuous at the wrap point
+template <unsigned int Order>
+struct DPWPolynomial;
+
+template <>
+struct DPWPolynomial<2> {
+  static inline double Compute(const double x) {
+    return x * x;
+  }
+};
+
+template <>
+struct DPWPolynomial<3> {
+  static inline double Compute(const double x) {
+    return x * (x * x - 1.0);
+  }
+};
+
+template <>
+struct DPWPolynomial<4> {
+  static inline double Compute(const double x) {
+    const double squared(x * x);
+    return squared * (squared - 2.0);
+  }
+};
+
+/// @brief Residual of the DPW output compared to the raw sawtooth,
+/// as a function of the time elapsed since a wrap (in samples)
+///
+/// At a constant frequency, DPW of any order is the raw sawtooth
+/// smoothed by a B-spline of degree (Order - 2): the residual is twice
+/// the complement of its cumulative distribution, which is zero after
+/// (Order - 1) samples.
+template <unsigned int Order>
+struct DPWResidual;
+
+template <>
+struct DPWResidual<2> {
+  static inline float Compute(const float elapsed) {
+    return std::max(1.0f - elapsed, 0.0f);
+  }
+  static inline Sample Compute(SampleRead elapsed) {
+    return VectorMath::Max(VectorMath::Sub(VectorMath::Fill(1.0f), elapsed),
+                           VectorMath::Fill(0.0f));
+  }
+};
+
+template <>
+struct DPWResidual<3> {
+  static inline float Compute(const float elapsed) {
+    const float a(std::max(1.0f - elapsed, 0.0f));
+    const float b(std::max(2.0f - elapsed, 0.0f));
+    return 0.5f * b * b - a * a;
+  }
+  static inline Sample Compute(SampleRead elapsed) {
+    const Sample kZero(VectorMath::Fill(0.0f));
+    const Sample a(VectorMath::Max(
+        VectorMath::Sub(VectorMath::Fill(1.0f), elapsed), kZero));
+    const Sample b(VectorMath::Max(
+        VectorMath::Sub(VectorMath::Fill(2.0f), elapsed), kZero));
+    return VectorMath::Sub(VectorMath::MulConst(0.5f, VectorMath::Mul(b, b)),
+                           VectorMath::Mul(a, a));
+  }
+};
+
+template <>
+struct DPWResidual<4> {
+  static inline float Compute(const float elapsed) {
+    const float a(std::max(1.0f - elapsed, 0.0f));
+    const float b(std::max(2.0f - elapsed, 0.0f));
+    const float c(std::max(3.0f - elapsed, 0.0f));
+    return (c * c * c - 3.0f * b * b * b + 3.0f * a * a * a) / 6.0f;
+  }
+  static inline Sample Compute(SampleRead elapsed) {
+    const Sample kZero(VectorMath::Fill(0.0f));
+    const Sample a(VectorMath::Max(
+        VectorMath::Sub(VectorMath::Fill(1.0f), elapsed), kZero));
+    const Sample b(VectorMath::Max(
+        VectorMath::Sub(VectorMath::Fill(2.0f), elapsed), kZero));
+    const Sample c(VectorMath::Max(
+        VectorMath::Sub(VectorMath::Fill(3.0f), elapsed), kZero));
+    const Sample kSum(VectorMath::Add(
+        VectorMath::Sub(VectorMath::Mul(c, VectorMath::Mul(c, c)),
+                        VectorMath::MulConst(3.0f,
+                                             VectorMath::Mul(b, VectorMath::Mul(b, b)))),
+        VectorMath::MulConst(3.0f, VectorMath::Mul(a, VectorMath::Mul(a, a)))));
+    return VectorMath::MulConst(1.0f / 6.0f, kSum);
+  }
+};
+
+/// @brief Sawtooth signal generator
+/// using Differentiated Polynomial Waveforms (DPW) of any supported order
+///
+/// The raw sawtooth is shaped by a polynomial of degree "Order",
+/// then differentiated (Order - 1) times: the higher the order, the lower
+/// the aliasing. DPW<2> is equivalent to SawtoothDPW.
+///
+/// At a constant frequency the differentiated polynomial is computed
+/// in closed form (see DPWResidual): the raw sawtooth delayed by
+/// (Order - 1) / 2 samples, corrected within (Order - 1) samples after
+/// each wrap. Unlike actual differentiations, which amplify single precision
+/// errors by the inverse of the frequency, this is accurate
+/// down to the lowest frequencies.
+///
+/// Under audio rate modulations, differentiation stages are actual divided
+/// differences in double precision, each one normalized by the phase span
+/// it covers: this keeps the output normalized whatever the per-sample
+/// increments.
+template <unsigned int Order>
+class DPW {
+  static_assert(Order >= 2 && Order <= 4, "Unsupported DPW order");
+
+ public:
+  explicit DPW(const float phase = 0.0f)
+      : phase_(0.0),
+        increment_(0.0),
+        span_(static_cast<float>(kMinSpan)),
+        inverse_span_(1.0 / kMinSpan),
+        period_(2.0 / kMinSpan),
+        applied_increment_(0.0),
+        last_offset_(0.0),
+        pending_span_(0.0),
+        last_output_(0.0),
+        spans_(),
+        lasts_(),
+        history_valid_(false) {
+    SOUNDTAILOR_ASSERT(phase <= 1.0f);
+    SOUNDTAILOR_ASSERT(phase >= -1.0f);
+    SetPhase(phase);
+  }
+
+  Sample operator()(void) {
+    // Time elapsed since the last wrap, in samples
+    const double kElapsed((phase_ + 1.0) * inverse_span_);
+    const Sample kZero(VectorMath::Fill(0.0f));
+    const Sample kLanes(VectorMath::FillIncremental(0.0f, 1.0f));
+    const Sample kPeriod(VectorMath::Fill(static_cast<float>(period_)));
+    // Time elapsed since the next wrap: positive for lanes past it only.
+    // Computed from the (small) time until this wrap, for precision's sake
+    Sample since_next(VectorMath::Sub(
+        kLanes,
+        VectorMath::Fill(static_cast<float>(period_ - kElapsed))));
+    // Very high frequencies may wrap twice within a Sample
+    since_next = VectorMath::Sub(
+        since_next,
+        VectorMath::ExtractValueFromMask(
+            kPeriod,
+            VectorMath::LessEqual(kPeriod, since_next)));
+    const Sample kElapsedLanes(VectorMath::Add(
+        VectorMath::ExtractValueFromMask(
+            since_next,
+            VectorMath::LessEqual(kZero, since_next)),
+        VectorMath::ExtractValueFromMask(
+            VectorMath::Add(VectorMath::Fill(static_cast<float>(kElapsed)),
+                            kLanes),
+            VectorMath::LessThan(since_next, kZero))));
+
+    Sample residual(DPWResidual<Order>::Compute(kElapsedLanes));
+    if (period_ < Order - 1) {
+      // Previous wrap not faded out yet
+      residual = VectorMath::Add(residual,
+                                 DPWResidual<Order>::Compute(
+                                     VectorMath::Add(kElapsedLanes, kPeriod)));
+    }
+    phase_ = Wrap(phase_ + SampleSize * increment_);
+    history_valid_ = false;
+    // Raw sawtooth, delayed
+    const Sample kSawtooth(VectorMath::Add(
+        VectorMath::MulConst(span_, kElapsedLanes),
+        VectorMath::Fill(-1.0f - 0.5f * (Order - 1) * span_)));
+    return VectorMath::Add(kSawtooth, VectorMath::MulConst(2.0f, residual));
+  }
+
+  /// @brief Audio rate frequency modulation, see PhaseAccumulator::ProcessFM()
+  Sample ProcessFM(SampleRead frequencies) {
+    RestoreHistory();
+    alignas(16) float frequencies_v[SampleSize];
+    VectorMath::Store(&frequencies_v[0], frequencies);
+    alignas(16) float out[SampleSize];
+    for (unsigned int i(0); i < SampleSize; ++i) {
+      out[i] = static_cast<float>(Differentiate(
+          DPWPolynomial<Order>::Compute(phase_),
+          applied_increment_));
+      Advance(2.0 * frequencies_v[i]);
+    }
+    return VectorMath::Fill(&out[0]);
+  }
+
+  /// @brief Audio rate phase modulation, see PhaseAccumulator::ProcessPM()
+  Sample ProcessPM(SampleRead phase_offsets) {
+    RestoreHistory();
+    alignas(16) float offsets_v[SampleSize];
+    VectorMath::Store(&offsets_v[0], phase_offsets);
+    alignas(16) float out[SampleSize];
+    for (unsigned int i(0); i < SampleSize; ++i) {
+      const double offset(offsets_v[i]);
+      // Actual phase span: the accumulated one plus the offsets derivative
+      const double span(applied_increment_ + Wrap(offset - last_offset_));
+      out[i] = static_cast<float>(Differentiate(
+          DPWPolynomial<Order>::Compute(Wrap(phase_ + offset)),
+          span));
+      Advance(increment_);
+      last_offset_ = offset;
+    }
+    return VectorMath::Fill(&out[0]);
+  }
+
+  void SetPhase(const float phase) {
+    SOUNDTAILOR_ASSERT(phase <= 1.0f);
+    SOUNDTAILOR_ASSERT(phase >= -1.0f);
+    phase_ = phase;
+    history_valid_ = false;
+  }
+
+  void SetFrequency(const float frequency) {
+    SOUNDTAILOR_ASSERT(frequency >= 0.0f);
+    SOUNDTAILOR_ASSERT(frequency <= 0.5f);
+
+    increment_ = 2.0 * frequency;
+    const double kSpan(std::max(increment_, kMinSpan));
+    span_ = static_cast<float>(kSpan);
+    inverse_span_ = 1.0 / kSpan;
+    period_ = 2.0 / kSpan;
+    history_valid_ = false;
+  }
+
+  float ProcessParameters(void) {
+    const float kElapsed(static_cast<float>((phase_ + 1.0) * inverse_span_));
+    float residual(DPWResidual<Order>::Compute(kElapsed));
+    if (period_ < Order - 1) {
+      residual += DPWResidual<Order>::Compute(
+          kElapsed + static_cast<float>(period_));
+    }
+    Advance(increment_);
+    last_offset_ = 0.0;
+    history_valid_ = false;
+    return span_ * kElapsed - 1.0f - 0.5f * (Order - 1) * span_
+           + 2.0f * residual;
+  }
+
+ private:
+  /// @brief Arbitrary lowest absolute span, about 0.01Hz @ 96kHz
+  static constexpr double kMinSpan = 2e-7;
+  /// @brief Lowest absolute phase span differentiated under modulations,
+  /// about 5Hz @ 96kHz: below that, higher order divided differences
+  /// are dominated by rounding errors
+  static constexpr double kMinModulatedSpan = 1e-4;
+
+  /// @brief Advance the phase by the given increment
+  void Advance(const double increment) {
+    phase_ = Wrap(phase_ + increment);
+    applied_increment_ = increment;
+  }
+
+  /// @brief Run all differentiation stages on the given polynomial value
+  ///
+  /// @param[in]  value   Polynomial value for the current phase
+  /// @param[in]  increment   Phase span since the previous value
+  ///
+  /// The (Order - 1)th divided difference of the polynomial
+  /// is Order times the raw sawtooth.
+  /// Time steps where the phase barely moved are merged into the next one,
+  /// the output being held meanwhile.
+  double Differentiate(const double value, const double increment) {
+    pending_span_ += increment;
+    if (std::fabs(pending_span_) < kMinModulatedSpan) {
+      return last_output_;
+    }
+    for (unsigned int i(Order - 2); i > 0; --i) {
+      spans_[i] = spans_[i - 1];
+    }
+    spans_[0] = pending_span_;
+    pending_span_ = 0.0;
+    double current(value);
+    double span(0.0);
+    for (unsigned int i(0); i < Order - 1; ++i) {
+      span += spans_[i];
+      const double diff((current - lasts_[i]) / ClampSpan(span));
+      lasts_[i] = current;
+      current = diff;
+    }
+    last_output_ = current / Order;
+    return last_output_;
+  }
+
+  /// @brief Keep the given (possibly negative) span away from zero
+  static inline double ClampSpan(const double span) {
+    return span < 0.0 ? std::min(span, -kMinModulatedSpan)
+                      : std::max(span, kMinModulatedSpan);
+  }
+
+  /// @brief Wrap the given phase into [-1.0 ; 1.0]
+  static inline double Wrap(const double phase) {
+    double out(phase);
+    while (out > 1.0) {
+      out -= 2.0;
+    }
+    while (out < -1.0) {
+      out += 2.0;
+    }
+    return out;
+  }
+
+  /// @brief Rebuild the differentiators history, if not up to date
+  /// (constant frequency processing does not maintain it),
+  /// as if the generator had always been running at the current phase
+  /// and frequency
+  ///
+  /// This prevents any transient when modulations begin
+  void RestoreHistory(void) {
+    if (history_valid_) {
+      return;
+    }
+    // History time steps are kept far enough apart to be differentiated
+    const double kStep(std::max(increment_, kMinModulatedSpan));
+    for (unsigned int i(0); i < Order - 1; ++i) {
+      spans_[i] = kStep;
+      lasts_[i] = 0.0;
+    }
+    pending_span_ = 0.0;
+    last_offset_ = 0.0;
+    for (unsigned int i(Order - 1); i > 0; --i) {
+      Differentiate(DPWPolynomial<Order>::Compute(Wrap(phase_ - i * kStep)),
+                    kStep);
+    }
+    // Span from the last history time step to the current phase
+    applied_increment_ = kStep;
+    history_valid_ = true;
+  }
+
+  double phase_;  ///< Instantaneous phase of the generator
+  double increment_;  ///< Increment to be accumulated at each sample
+  float span_;  ///< Increment, kept away from zero
+  double inverse_span_;  ///< 1 / span_
+  double period_;  ///< Period, in samples
+  double applied_increment_;  ///< Last increment actually accumulated
+  double last_offset_;  ///< Last phase offset, for phase modulation
+  double pending_span_;  ///< Phase span not differentiated yet
+  double last_output_;  ///< Last differentiated value
+  double spans_[Order - 1];  ///< Last increments, most recent first
+  double lasts_[Order - 1];  ///< Last input of each differentiation stage
+  bool history_valid_;  ///< Differentiators history is up to date
+};
+
+template <unsigned int Order>
+constexpr double DPW<Order>::kMinSpan;
+template <unsigned int Order>
+constexpr double DPW<Order>::kMinModulatedSpan;
+
+}  // namespace generators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_GENERATORS_DPW_H_
@@ -36,6 +36,99 @@ Sample PhaseAccumulator::operator()(void) {
   return out;
 }
 
+Sample PhaseAccumulator::ProcessFM(SampleRead frequencies) {
+  const Sample increments(VectorMath::MulConst(2.0f, frequencies));
+  // Increments accumulated before each time step, first one excluded
+  const Sample cumulated(VectorMath::PrefixSum(increments));
+  const Sample previous(VectorMath::RotateOnRight(cumulated, 0.0f));
+  const float base(VectorMath::GetFirst(phase_));
+  const Sample out(VectorMath::Wrap(VectorMath::Add(VectorMath::Fill(base),
+                                                    previous)));
+  // Phase of the next Sample, ready for both modulated and unmodulated calls
+  const float next_base(base + VectorMath::GetLast(cumulated));
+  phase_ = VectorMath::Wrap(VectorMath::FillIncremental(
+      next_base,
+      VectorMath::GetFirst(VectorMath::MulConst(0.25f, increment_))));
+  return out;
+}
+
+Sample PhaseAccumulator::ProcessPM(SampleRead phase_offsets) {
+  const Sample out(VectorMath::Wrap(VectorMath::Add(phase_, phase_offsets)));
+  phase_ = VectorMath::IncrementAndWrap(phase_, increment_);
+  return out;
+}
+
+Sample PhaseAccumulator::ProcessSyncMaster(
+    Sample* SOUNDTAILOR_RESTRICT sync_positions) {
+  const Sample out(phase_);
+  phase_ = VectorMath::IncrementAndWrap(phase_, increment_);
+  *sync_positions = ComputeSyncPositions(
+      out,
+      VectorMath::GetFirst(VectorMath::MulConst(0.25f, increment_)));
+  return out;
+}
+
+Sample PhaseAccumulator::ProcessSyncSlave(
+    SampleRead sync_positions,
+    const float reset_phase,
+    Sample* SOUNDTAILOR_RESTRICT reset_from) {
+  // Arbitrary value higher than any actual phase
+  const float kNoReset(8.0f);
+  const float increment(VectorMath::GetFirst(VectorMath::MulConst(0.25f,
+                                                                  increment_)));
+  const Sample kRamp(VectorMath::FillIncremental(0.0f, increment));
+  const Sample kZero(VectorMath::Fill(0.0f));
+  const Sample synced(IsSynced(sync_positions));
+  const Sample not_synced(VectorMath::LessThan(sync_positions, kZero));
+  // For each synced time step, the phase the first one would have had
+  // if the reset occurred before it: a later reset always yields a lower one
+  const Sample reset_bases(VectorMath::Sub(
+      VectorMath::Add(VectorMath::Fill(reset_phase),
+                      VectorMath::MulConst(increment, sync_positions)),
+      kRamp));
+  const Sample candidates(VectorMath::Add(
+      VectorMath::ExtractValueFromMask(reset_bases, synced),
+      VectorMath::ExtractValueFromMask(VectorMath::Fill(kNoReset), not_synced)));
+  // Prefix minimum: each time step gets the base of the latest reset so far
+  const Sample partial(VectorMath::Min(candidates,
+                                       VectorMath::RotateOnRight(candidates,
+                                                                 kNoReset)));
+  const Sample bases(VectorMath::Min(
+      partial,
+      VectorMath::RotateOnRight(VectorMath::RotateOnRight(partial, kNoReset),
+                                kNoReset)));
+  const Sample kNoResetV(VectorMath::Fill(kNoReset));
+  const Sample reset(VectorMath::LessThan(bases, kNoResetV));
+  const Sample not_reset(VectorMath::LessEqual(kNoResetV, bases));
+  const Sample out(VectorMath::Add(
+      VectorMath::ExtractValueFromMask(
+          VectorMath::Wrap(VectorMath::Add(bases, kRamp)),
+          reset),
+      VectorMath::ExtractValueFromMask(phase_, not_reset)));
+
+  // Phase reached right before each reset
+  float previous(VectorMath::GetFirst(phase_) - increment);
+  if (previous < -1.0f) {
+    previous += 2.0f;
+  }
+  const Sample previous_phases(VectorMath::RotateOnRight(out, previous));
+  *reset_from = VectorMath::Wrap(VectorMath::Add(
+      previous_phases,
+      VectorMath::MulConst(increment,
+                           VectorMath::Sub(VectorMath::Fill(1.0f),
+                                           sync_positions))));
+
+  const float last_base(VectorMath::GetLast(bases));
+  if (last_base < kNoReset) {
+    phase_ = VectorMath::Wrap(VectorMath::Add(
+        VectorMath::Fill(last_base + 4.0f * increment),
+        kRamp));
+  } else {
+    phase_ = VectorMath::IncrementAndWrap(phase_, increment_);
+  }
+  return out;
+}
+
 void PhaseAccumulator::SetPhase(const float phase) {
   SOUNDTAILOR_ASSERT(phase <= 1.0f);
   SOUNDTAILOR_ASSERT(phase >= -1.0f);
@@ -50,7 +143,14 @@ void PhaseAccumulator::SetFrequency(const float frequency) {
 
   const float base_increment(2.0f * frequency);
   increment_ = VectorMath::FillOnLength(base_increment);
-  phase_ = VectorMath::FillIncremental(VectorMath::GetByIndex<0>(phase_), base_increment);
+  phase_ = VectorMath::Wrap(
+      VectorMath::FillIncremental(VectorMath::GetByIndex<0>(phase_),
+                                  base_increment));
+}
+
+float PhaseAccumulator::GetFrequency(void) const {
+  // Each lane is incremented by 4 time steps worth of 2 * frequency
+  return VectorMath::GetFirst(increment_) * 0.125f;
 }
 
 float PhaseAccumulator::ProcessParameters(void) {
@@ -81,5 +181,47 @@ float Differentiator::ProcessParameters(float sample) {
   return after_diff;
 }
 
+Sample ComputeSyncPositions(SampleRead phases, const float increment) {
+  if (increment <= 0.0f) {
+    return VectorMath::Fill(-1.0f);
+  }
+  const Sample kOne(VectorMath::Fill(1.0f));
+  const Sample previous(VectorMath::Wrap(VectorMath::Sub(
+      phases,
+      VectorMath::Fill(increment))));
+  // A wrap occurred wherever the phase decreased
+  const Sample wrapped(VectorMath::LessThan(phases, previous));
+  // Time elapsed since the phase crossed 1.0, that is -1.0 once wrapped
+  const Sample elapsed(VectorMath::MulConst(1.0f / increment,
+                                            VectorMath::Add(phases, kOne)));
+  // Non-wrapped time steps are set to -1.0
+  return VectorMath::Sub(
+      VectorMath::ExtractValueFromMask(VectorMath::Add(elapsed, kOne), wrapped),
+      kOne);
+}
+
+Sample IsSynced(SampleRead sync_positions) {
+  return VectorMath::LessEqual(VectorMath::Fill(0.0f), sync_positions);
+}
+
+/// @brief Arbitrary lowest absolute frequency for DPW normalizations,
+/// about 0.01Hz @ 96kHz
+static const float kMinModulatedFrequency(1e-7f);
+
+Sample ComputeModulatedNormalization(SampleRead frequencies,
+                                     const float factor) {
+  const Sample kMinFrequency(VectorMath::Fill(kMinModulatedFrequency));
+  const Sample kFactor(VectorMath::Fill(factor));
+  const Sample clamped(VectorMath::Mul(
+      VectorMath::SgnNoZero(frequencies),
+      VectorMath::Max(VectorMath::Abs(frequencies), kMinFrequency)));
+  return VectorMath::Mul(kFactor, VectorMath::Reciprocal(clamped));
+}
+
+float ComputeModulatedNormalization(const float frequency, const float factor) {
+  const float kClamped(std::max(std::fabs(frequency), kMinModulatedFrequency));
+  return factor / (frequency < 0.0f ? -kClamped : kClamped);
+}
+
 }  // namespace generators
 }  // namespace soundtailor
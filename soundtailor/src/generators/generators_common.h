@@ -33,8 +33,39 @@ class PhaseAccumulator {
  public:
   explicit PhaseAccumulator(const float phase = 0.0f);
   Sample operator()(void);
+  /// @brief Audio rate frequency modulation
+  ///
+  /// Generate a Sample where each time step is accumulated with its own
+  /// frequency (normalized, same range as SetFrequency()), the increments
+  /// being integrated with a prefix sum.
+  /// The frequency set by SetFrequency() is kept for subsequent calls
+  /// to operator().
+  Sample ProcessFM(SampleRead frequencies);
+  /// @brief Audio rate phase modulation
+  ///
+  /// Generate a Sample where each time step is shifted by its own phase
+  /// offset, within [-1.0 ; 1.0] (a full period being 2.0).
+  /// The internal phase is not affected by the offsets.
+  Sample ProcessPM(SampleRead phase_offsets);
+  /// @brief Hard sync master: generate a Sample as operator() does,
+  /// also reporting where the phase wrapped
+  ///
+  /// @param[out]  sync_positions   For each time step, time elapsed since
+  /// the wrap in samples (within [0.0 ; 1.0[), negative if there was none
+  Sample ProcessSyncMaster(Sample* SOUNDTAILOR_RESTRICT sync_positions);
+  /// @brief Hard sync slave: generate a Sample as operator() does,
+  /// restarting from the given phase wherever the master wrapped
+  ///
+  /// @param[in]  sync_positions   As reported by the master
+  /// @param[in]  reset_phase   Phase to restart from
+  /// @param[out]  reset_from   For each synced time step, the phase reached
+  /// right before the reset (meaningless elsewhere)
+  Sample ProcessSyncSlave(SampleRead sync_positions,
+                          const float reset_phase,
+                          Sample* SOUNDTAILOR_RESTRICT reset_from);
   void SetPhase(const float phase);
   void SetFrequency(const float frequency);
+  float GetFrequency(void) const;
   float ProcessParameters(void);
 
  private:
@@ -54,6 +85,26 @@ class Differentiator {
   float last_;  ///< Last synthesized sample value
 };
 
+/// @brief Helper for hard sync masters: compute where the given naive
+/// sawtooth wrapped, see PhaseAccumulator::ProcessSyncMaster()
+///
+/// @param[in]  phases   Naive sawtooth, within [-1.0 ; 1.0]
+/// @param[in]  increment   Constant per-sample increment it was generated with
+Sample ComputeSyncPositions(SampleRead phases, const float increment);
+
+/// @brief Helper for hard sync slaves: mask of time steps being synced
+Sample IsSynced(SampleRead sync_positions);
+
+/// @brief Helper for DPW generators under audio rate modulation:
+/// compute the per-sample normalization factor "factor / frequency"
+///
+/// Frequencies too close to zero (which may happen, possibly with a negative
+/// sign, while phase modulating) are clamped so that it does not diverge
+Sample ComputeModulatedNormalization(SampleRead frequencies,
+                                     const float factor);
+/// @brief Same as above, for a single frequency
+float ComputeModulatedNormalization(const float frequency, const float factor);
+
 }  // namespace generators
 }  // namespace soundtailor
 
@@ -0,0 +1,85 @@
+/// @file pink_noise.cc
+/// @brief Pink noise generator - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/generators/pink_noise.h"
+
+namespace soundtailor {
+namespace generators {
+
+PinkNoise::PinkNoise(const unsigned int seed)
+    : white_(seed),
+      rows_(),
+      sum_(0.0f),
+      counter_(0) {
+  SetSeed(seed);
+}
+
+Sample PinkNoise::operator()(void) {
+  const unsigned int kCounterMask((1 << kRows) - 1);
+  alignas(16) float updates[SampleSize];
+  VectorMath::Store(&updates[0], white_());
+  const Sample white(white_());
+
+  alignas(16) float sums[SampleSize];
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    counter_ = (counter_ + 1) & kCounterMask;
+    if (counter_ == 0) {
+      // Once per cycle the running sum is computed from scratch,
+      // so that rounding errors do not accumulate
+      sum_ = 0.0f;
+      for (unsigned int row(0); row < kRows; ++row) {
+        sum_ += rows_[row];
+      }
+    } else {
+      // The row to be updated is given by the counter trailing zeros
+      unsigned int row(0);
+      unsigned int counter(counter_);
+      while ((counter & 1) == 0) {
+        counter >>= 1;
+        row += 1;
+      }
+      sum_ += updates[i] - rows_[row];
+      rows_[row] = updates[i];
+    }
+    sums[i] = sum_;
+  }
+  const float kNormalization(1.0f / (kRows + 1));
+  return VectorMath::MulConst(kNormalization,
+                              VectorMath::Add(VectorMath::Fill(&sums[0]), white));
+}
+
+void PinkNoise::SetSeed(const unsigned int seed) {
+  white_.SetSeed(seed);
+  alignas(16) float values[SampleSize];
+  for (unsigned int row(0); row < kRows; ++row) {
+    if (row % SampleSize == 0) {
+      VectorMath::Store(&values[0], white_());
+    }
+    rows_[row] = values[row % SampleSize];
+  }
+  sum_ = 0.0f;
+  for (unsigned int row(0); row < kRows; ++row) {
+    sum_ += rows_[row];
+  }
+  counter_ = 0;
+}
+
+}  // namespace generators
+}  // namespace soundtailor
@@ -0,0 +1,57 @@
+/// @file pink_noise.h
+/// @brief Pink noise generator
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_GENERATORS_PINK_NOISE_H_
+#define SOUNDTAILOR_SRC_GENERATORS_PINK_NOISE_H_
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Pink noise generator (Voss-McCartney algorithm),
+/// within [-1.0 ; 1.0]
+///
+/// The sum of kRows random values, the nth one being updated every 2^(n+1)
+/// samples, plus a white noise one: about -3dB/octave over kRows octaves.
+/// All random values are drawn a full Sample at a time.
+class PinkNoise {
+ public:
+  explicit PinkNoise(const unsigned int seed = 0);
+
+  Sample operator()(void);
+  /// @brief Restart the generator from the given seed
+  void SetSeed(const unsigned int seed);
+
+ private:
+  static const unsigned int kRows = 12;
+
+  WhiteNoise white_;  ///< Internal random values generator
+  float rows_[kRows];  ///< Current value of each row
+  float sum_;  ///< Running sum of all rows
+  unsigned int counter_;  ///< Sample counter, selecting rows to be updated
+};
+
+}  // namespace generators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_GENERATORS_PINK_NOISE_H_
@@ -0,0 +1,64 @@
+/// @file sample_and_hold_noise.cc
+/// @brief Sample and hold random generator - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/generators/sample_and_hold_noise.h"
+
+namespace soundtailor {
+namespace generators {
+
+SampleAndHoldNoise::SampleAndHoldNoise(const unsigned int seed)
+    : white_(seed),
+      clock_(),
+      held_(0.0f) {
+  SetSeed(seed);
+}
+
+Sample SampleAndHoldNoise::operator()(void) {
+  Sample sync;
+  clock_.ProcessSyncMaster(&sync);
+  const Sample candidates(white_());
+  alignas(16) float sync_v[SampleSize];
+  alignas(16) float candidates_v[SampleSize];
+  VectorMath::Store(&sync_v[0], sync);
+  VectorMath::Store(&candidates_v[0], candidates);
+
+  alignas(16) float out[SampleSize];
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    if (sync_v[i] >= 0.0f) {
+      held_ = candidates_v[i];
+    }
+    out[i] = held_;
+  }
+  return VectorMath::Fill(&out[0]);
+}
+
+void SampleAndHoldNoise::SetSeed(const unsigned int seed) {
+  white_.SetSeed(seed);
+  held_ = VectorMath::GetFirst(white_());
+}
+
+void SampleAndHoldNoise::SetFrequency(const float frequency) {
+  SOUNDTAILOR_ASSERT(frequency >= 0.0f);
+  SOUNDTAILOR_ASSERT(frequency <= 0.5f);
+  clock_.SetFrequency(frequency);
+}
+
+}  // namespace generators
+}  // namespace soundtailor
@@ -0,0 +1,55 @@
+/// @file sample_and_hold_noise.h
+/// @brief Sample and hold random generator
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_GENERATORS_SAMPLE_AND_HOLD_NOISE_H_
+#define SOUNDTAILOR_SRC_GENERATORS_SAMPLE_AND_HOLD_NOISE_H_
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/generators/generators_common.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Sample and hold random generator, within [-1.0 ; 1.0[
+///
+/// A new random value is drawn at each period of its internal clock,
+/// then held until the next one
+class SampleAndHoldNoise {
+ public:
+  explicit SampleAndHoldNoise(const unsigned int seed = 0);
+
+  Sample operator()(void);
+  /// @brief Restart the generator from the given seed
+  void SetSeed(const unsigned int seed);
+  /// @brief Set the rate at which random values are drawn (normalized)
+  void SetFrequency(const float frequency);
+
+ private:
+  WhiteNoise white_;  ///< Internal random values generator
+  PhaseAccumulator clock_;  ///< Internal clock, drawing on each wrap
+  float held_;  ///< Currently held value
+};
+
+}  // namespace generators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_GENERATORS_SAMPLE_AND_HOLD_NOISE_H_
@@ -18,6 +18,11 @@
 /// You should have received a copy of the GNU General Public License
 /// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
 
+// std::max
+#include <algorithm>
+
+#include "soundtailor/src/instrumentation.h"
+
 #include "soundtailor/src/generators/sawtooth_blit.h"
 
 namespace soundtailor {
@@ -38,13 +43,103 @@ Sample SawtoothBLIT::operator()(void) {
   const Sample phase(VectorMath::Fill(phase_));
   // Phase input here
   const Sample A(VectorMath::IncrementAndWrap(current, phase));
-  const Sample C(ReadTable(A));
+  const Sample C(ReadTable(A,
+                           VectorMath::Fill(alpha_),
+                           VectorMath::Fill(1.0f / alpha_)));
+  const Sample B(VectorMath::IncrementAndWrap(A, VectorMath::Fill(1.0)));
+  const Sample out(VectorMath::Add(B, C));
+
+  return out;
+}
+
+Sample SawtoothBLIT::ProcessFM(SampleRead frequencies) {
+  const Sample current(sawtooth_gen_.ProcessFM(frequencies));
+  const Sample phase(VectorMath::Fill(phase_));
+  const Sample A(VectorMath::IncrementAndWrap(current, phase));
+  // Each time step has its own table lookup threshold,
+  // kept away from zero so that its inverse does not diverge
+  const Sample alpha(VectorMath::Max(VectorMath::MulConst(4.0f, frequencies),
+                                     VectorMath::Fill(1e-7f)));
+  const Sample C(ReadTable(A, alpha, VectorMath::Reciprocal(alpha)));
+  const Sample B(VectorMath::IncrementAndWrap(A, VectorMath::Fill(1.0)));
+  const Sample out(VectorMath::Add(B, C));
+
+  return out;
+}
+
+Sample SawtoothBLIT::ProcessPM(SampleRead phase_offsets) {
+  const Sample current(sawtooth_gen_());
+  const Sample phase(VectorMath::Add(VectorMath::Fill(phase_), phase_offsets));
+  const Sample A(VectorMath::Wrap(VectorMath::Add(current, phase)));
+  const Sample C(ReadTable(A,
+                           VectorMath::Fill(alpha_),
+                           VectorMath::Fill(1.0f / alpha_)));
+  const Sample B(VectorMath::IncrementAndWrap(A, VectorMath::Fill(1.0)));
+  const Sample out(VectorMath::Add(B, C));
+
+  return out;
+}
+
+Sample SawtoothBLIT::ProcessSyncMaster(
+    Sample* SOUNDTAILOR_RESTRICT sync_positions) {
+  const Sample current(sawtooth_gen_());
+  const Sample phase(VectorMath::Fill(phase_));
+  const Sample A(VectorMath::IncrementAndWrap(current, phase));
+  const Sample C(ReadTable(A,
+                           VectorMath::Fill(alpha_),
+                           VectorMath::Fill(1.0f / alpha_)));
   const Sample B(VectorMath::IncrementAndWrap(A, VectorMath::Fill(1.0)));
   const Sample out(VectorMath::Add(B, C));
+  // The output period begins where its naive counterpart wraps
+  *sync_positions = ComputeSyncPositions(B, 0.5f * alpha_);
 
   return out;
 }
 
+Sample SawtoothBLIT::ProcessSyncSlave(SampleRead sync_positions) {
+  Sample reset_from;
+  // The internal sawtooth restarting from -1.0 makes the output restart
+  // from its initial phase
+  const Sample current(sawtooth_gen_.ProcessSyncSlave(sync_positions,
+                                                      -1.0f,
+                                                      &reset_from));
+  const Sample phase(VectorMath::Fill(phase_));
+  const Sample kOne(VectorMath::Fill(1.0f));
+  const Sample A(VectorMath::IncrementAndWrap(current, phase));
+  const Sample C(ReadTable(A,
+                           VectorMath::Fill(alpha_),
+                           VectorMath::Fill(1.0f / alpha_)));
+  const Sample B(VectorMath::IncrementAndWrap(A, kOne));
+  const Sample out(VectorMath::Add(B, C));
+
+  // Height of the naive output step at each reset
+  const Sample before(VectorMath::IncrementAndWrap(
+      VectorMath::IncrementAndWrap(reset_from, phase),
+      kOne));
+  const Sample after(VectorMath::IncrementAndWrap(
+      VectorMath::IncrementAndWrap(VectorMath::Fill(-1.0f), phase),
+      kOne));
+  const Sample steps(VectorMath::ExtractValueFromMask(
+      VectorMath::Sub(after, before),
+      IsSynced(sync_positions)));
+  // 2-points polynomial band-limited step (polyBLEP) residuals,
+  // for the time steps right after and right before each reset
+  const Sample remaining(VectorMath::Sub(kOne, sync_positions));
+  const Sample after_residuals(VectorMath::MulConst(
+      -0.5f,
+      VectorMath::Mul(steps, VectorMath::Mul(remaining, remaining))));
+  const Sample before_residuals(VectorMath::MulConst(
+      0.5f,
+      VectorMath::Mul(steps, VectorMath::Mul(sync_positions, sync_positions))));
+  // The time step before the first one is already gone:
+  // its residual is applied on the first one instead
+  const Sample before_shifted(VectorMath::Add(
+      VectorMath::RotateOnLeft(before_residuals, 0.0f),
+      VectorMath::Fill(VectorMath::GetFirst(before_residuals), 0.0f, 0.0f, 0.0f)));
+
+  return VectorMath::Add(out, VectorMath::Add(after_residuals, before_shifted));
+}
+
 void SawtoothBLIT::SetPhase(const float phase) {
   SOUNDTAILOR_ASSERT(phase <= 1.0f);
   SOUNDTAILOR_ASSERT(phase >= -1.0f);
@@ -61,10 +156,18 @@ void SawtoothBLIT::SetFrequency(const float frequency) {
 }
 
 float SawtoothBLIT::ProcessParameters(void) {
-  const float current(sawtooth_gen_.ProcessParameters());
-  //const float squared(current * current);
-  //return normalization_factor_ * differentiator_.ProcessParameters(squared);
-  return current;
+  const Sample current(VectorMath::Fill(sawtooth_gen_.ProcessParameters()));
+  const Sample phase(VectorMath::Fill(phase_));
+  const Sample A(VectorMath::IncrementAndWrap(current, phase));
+  // Same as operator(), with the lookup threshold kept away from zero
+  // (this is called from the constructor, before any frequency is set)
+  const float kAlpha(std::max(alpha_, 1e-7f));
+  const Sample C(ReadTable(A,
+                           VectorMath::Fill(kAlpha),
+                           VectorMath::Fill(1.0f / kAlpha)));
+  const Sample B(VectorMath::IncrementAndWrap(A, VectorMath::Fill(1.0)));
+
+  return VectorMath::GetFirst(VectorMath::Add(B, C));
 }
 
 const float* SawtoothBLIT::GetSegment() {
@@ -78,18 +181,19 @@ const float* SawtoothBLIT::GetSegment() {
   return &kSegment[0];
 }
 
-Sample SawtoothBLIT::ReadTable(SampleRead value) const {
+Sample SawtoothBLIT::ReadTable(SampleRead value,
+                               SampleRead alpha,
+                               SampleRead alpha_inverse) {
   const Sample abs_value(VectorMath::Abs(value));
   const Sample sign_value(VectorMath::Sgn(value));
   // @todo(gm) get rid of that hardcoded value
   // (whenever we actually compute the tables on the fly)
   const Sample kZero(VectorMath::Fill(0.0f));
   const Sample kHalfM(VectorMath::Fill(5400.0f));
-  const Sample kAlphaInverse(VectorMath::Fill(1.0f / alpha_));
 
   // relative_index = kHalfM * abs_value / alpha
   const Sample relative_index(VectorMath::Mul(kHalfM,
-                                              VectorMath::Mul(abs_value, kAlphaInverse)));
+                                              VectorMath::Mul(abs_value, alpha_inverse)));
   // index = kHalfM - relative_index - 1
   const Sample unbounded_index(VectorMath::Sub(kHalfM,
                                                VectorMath::Add(relative_index, VectorMath::Fill(1))));
@@ -104,11 +208,19 @@ Sample SawtoothBLIT::ReadTable(SampleRead value) const {
   tmp_v[3] = kTable[VectorMath::GetByIndex<3>(index)];
   const Sample tmp(VectorMath::Fill(&tmp_v[0]));
 
-  // if abs_value < alpha_
+  // if abs_value < alpha
   //  return sign_value * tmp
   // else
   //  return 0.0
-  const Sample mask(VectorMath::LessThan(abs_value, VectorMath::Fill(alpha_)));
+  const Sample mask(VectorMath::LessThan(abs_value, alpha));
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    if (!(VectorMath::GetByIndex(abs_value, i)
+          < VectorMath::GetByIndex(alpha, i))) {
+      SOUNDTAILOR_COUNT(kProbeBlitTableClamp);
+    }
+  }
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
   const Sample factor(VectorMath::ExtractValueFromMask(sign_value, mask));
   const Sample out(VectorMath::Mul(factor, tmp));
   return out;
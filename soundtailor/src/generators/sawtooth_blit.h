@@ -34,6 +34,15 @@ public:
   explicit SawtoothBLIT(const float phase = 0.0f);
 
   Sample operator()(void);
+  /// @brief Audio rate frequency modulation, see PhaseAccumulator::ProcessFM()
+  Sample ProcessFM(SampleRead frequencies);
+  /// @brief Audio rate phase modulation, see PhaseAccumulator::ProcessPM()
+  Sample ProcessPM(SampleRead phase_offsets);
+  /// @brief Hard sync master, see PhaseAccumulator::ProcessSyncMaster()
+  Sample ProcessSyncMaster(Sample* SOUNDTAILOR_RESTRICT sync_positions);
+  /// @brief Hard sync slave, restarting from the beginning of its period
+  /// wherever the master wrapped
+  Sample ProcessSyncSlave(SampleRead sync_positions);
   void SetPhase(const float phase);
   void SetFrequency(const float frequency);
   float ProcessParameters(void);
@@ -41,7 +50,10 @@ public:
 private:
   /// @brief The left side of a band limited sawtooth segment
   static const float* GetSegment();
-  Sample ReadTable(SampleRead value) const;
+  /// @brief Read the segment table, each lane with its own lookup threshold
+  static Sample ReadTable(SampleRead value,
+                          SampleRead alpha,
+                          SampleRead alpha_inverse);
 
   PhaseAccumulator sawtooth_gen_;  //< Internal basic sawtooth signal generator
   float alpha_;  //< Table lookup threshold
@@ -27,7 +27,9 @@ namespace generators {
 SawtoothDPW::SawtoothDPW(const float phase)
     : sawtooth_gen_(),
       differentiator_(),
-      normalization_factor_(0.0f) {
+      offsets_differentiator_(),
+      normalization_factor_(0.0f),
+      applied_frequency_(0.0f) {
   SOUNDTAILOR_ASSERT(phase <= 1.0f);
   SOUNDTAILOR_ASSERT(phase >= -1.0f);
   SetPhase(phase);
@@ -41,7 +43,61 @@ Sample SawtoothDPW::operator()(void) {
   const Sample squared(VectorMath::Mul(current, current));
   // Differentiation & Normalization
   const Sample diff(differentiator_(squared));
-  return VectorMath::MulConst(normalization_factor_, diff);
+  return Normalize(diff);
+}
+
+Sample SawtoothDPW::ProcessFM(SampleRead frequencies) {
+  const Sample current(sawtooth_gen_.ProcessFM(frequencies));
+  const Sample squared(VectorMath::Mul(current, current));
+  const Sample diff(differentiator_(squared));
+  // Each time step phase moved by the previous time step frequency
+  const Sample steps(VectorMath::RotateOnRight(frequencies,
+                                               applied_frequency_));
+  applied_frequency_ = VectorMath::GetLast(frequencies);
+  return VectorMath::Mul(ComputeModulatedNormalization(steps, 0.25f), diff);
+}
+
+Sample SawtoothDPW::ProcessPM(SampleRead phase_offsets) {
+  const Sample current(sawtooth_gen_.ProcessPM(phase_offsets));
+  const Sample squared(VectorMath::Mul(current, current));
+  const Sample diff(differentiator_(squared));
+  // Instantaneous frequency: the base one plus the phase offsets derivative,
+  // the first time step phase having moved by the previous frequency
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  const Sample offsets_diff(
+      VectorMath::Wrap(offsets_differentiator_(phase_offsets)));
+  const Sample frequencies(VectorMath::Add(
+      VectorMath::RotateOnRight(VectorMath::Fill(kFrequency),
+                                applied_frequency_),
+      VectorMath::MulConst(0.5f, offsets_diff)));
+  applied_frequency_ = kFrequency;
+  return VectorMath::Mul(ComputeModulatedNormalization(frequencies, 0.25f),
+                         diff);
+}
+
+Sample SawtoothDPW::ProcessSyncMaster(
+    Sample* SOUNDTAILOR_RESTRICT sync_positions) {
+  const Sample current(sawtooth_gen_.ProcessSyncMaster(sync_positions));
+  const Sample squared(VectorMath::Mul(current, current));
+  const Sample diff(differentiator_(squared));
+  return Normalize(diff);
+}
+
+Sample SawtoothDPW::ProcessSyncSlave(SampleRead sync_positions) {
+  Sample reset_from;
+  const Sample current(sawtooth_gen_.ProcessSyncSlave(sync_positions,
+                                                      -1.0f,
+                                                      &reset_from));
+  const Sample squared(VectorMath::Mul(current, current));
+  const Sample diff(differentiator_(squared));
+  // Synced time steps are integrated over both segments: up to the phase
+  // reached before the reset, then from the reset phase on.
+  // This is the same box filtering DPW applies to its own discontinuities.
+  const Sample correction(VectorMath::ExtractValueFromMask(
+      VectorMath::Sub(VectorMath::Mul(reset_from, reset_from),
+                      VectorMath::Fill(1.0f)),
+      IsSynced(sync_positions)));
+  return Normalize(VectorMath::Add(diff, correction));
 }
 
 void SawtoothDPW::SetPhase(const float phase) {
@@ -61,7 +117,28 @@ void SawtoothDPW::SetFrequency(const float frequency) {
 float SawtoothDPW::ProcessParameters(void) {
   const float current(sawtooth_gen_.ProcessParameters());
   const float squared(current * current);
-  return normalization_factor_ * differentiator_.ProcessParameters(squared);
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  // This time step phase moved by the previous frequency
+  const float kNormalization(
+      applied_frequency_ == kFrequency
+      ? normalization_factor_
+      : ComputeModulatedNormalization(applied_frequency_, 0.25f));
+  applied_frequency_ = kFrequency;
+  return kNormalization * differentiator_.ProcessParameters(squared);
+}
+
+Sample SawtoothDPW::Normalize(SampleRead diff) {
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  // Most common case: same frequency as for the previous time steps
+  if (applied_frequency_ == kFrequency) {
+    return VectorMath::MulConst(normalization_factor_, diff);
+  }
+  // Right after a frequency change or a modulation: the first time step
+  // phase moved by the previous frequency
+  const Sample steps(VectorMath::RotateOnRight(VectorMath::Fill(kFrequency),
+                                               applied_frequency_));
+  applied_frequency_ = kFrequency;
+  return VectorMath::Mul(ComputeModulatedNormalization(steps, 0.25f), diff);
 }
 
 }  // namespace generators
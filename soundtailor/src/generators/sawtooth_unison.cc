@@ -0,0 +1,200 @@
+/// @file sawtooth_unison.cc
+/// @brief Unison of detuned sawtooth signal generators - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::sin, std::cos
+#include <cmath>
+// std::min
+#include <algorithm>
+
+#include "soundtailor/src/generators/sawtooth_unison.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Relative detune of the outermost oscillators (about a semitone)
+static const float kMaxDetune(0.06f);
+
+/// @brief Wrap the given phase into [-1.0 ; 1.0]
+static inline float WrapPhase(const float phase) {
+  float out(phase);
+  while (out > 1.0f) {
+    out -= 2.0f;
+  }
+  while (out < -1.0f) {
+    out += 2.0f;
+  }
+  return out;
+}
+
+SawtoothUnison::SawtoothUnison(const unsigned int voices_count)
+    : phases_(),
+      increments_(),
+      last_(),
+      normalizations_(),
+      gains_left_(),
+      gains_right_(),
+      voices_count_(voices_count),
+      groups_count_((voices_count + SampleSize - 1) / SampleSize),
+      frequency_(0.0f),
+      detune_(0.0f),
+      phase_spread_(0.0f),
+      stereo_spread_(0.0f) {
+  SOUNDTAILOR_ASSERT(voices_count > 0);
+  SOUNDTAILOR_ASSERT(voices_count <= kMaxVoices);
+  UpdateIncrements();
+  UpdatePhases();
+  UpdateGains();
+}
+
+void SawtoothUnison::ProcessBlock(BlockOut left,
+                                  BlockOut right,
+                                  std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  float* SOUNDTAILOR_RESTRICT left_write(left);
+  float* SOUNDTAILOR_RESTRICT right_write(right);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    alignas(16) float left_v[SampleSize];
+    alignas(16) float right_v[SampleSize];
+    for (unsigned int time_idx(0); time_idx < SampleSize; ++time_idx) {
+      Sample left_sum(VectorMath::Fill(0.0f));
+      Sample right_sum(VectorMath::Fill(0.0f));
+      for (unsigned int group(0); group < groups_count_; ++group) {
+        const Sample current(phases_[group]);
+        // Parabolization
+        const Sample squared(VectorMath::Mul(current, current));
+        // Differentiation & Normalization, each lane against its own history
+        const Sample diff(VectorMath::Sub(squared, last_[group]));
+        const Sample out(VectorMath::Mul(normalizations_[group], diff));
+        last_[group] = squared;
+        phases_[group] = VectorMath::IncrementAndWrap(current,
+                                                      increments_[group]);
+        left_sum = VectorMath::Add(left_sum,
+                                   VectorMath::Mul(gains_left_[group], out));
+        right_sum = VectorMath::Add(right_sum,
+                                    VectorMath::Mul(gains_right_[group], out));
+      }
+      left_v[time_idx] = VectorMath::AddHorizontal(left_sum);
+      right_v[time_idx] = VectorMath::AddHorizontal(right_sum);
+    }
+    VectorMath::Store(left_write, VectorMath::Fill(&left_v[0]));
+    VectorMath::Store(right_write, VectorMath::Fill(&right_v[0]));
+    left_write += SampleSize;
+    right_write += SampleSize;
+  }
+}
+
+void SawtoothUnison::SetFrequency(const float frequency) {
+  SOUNDTAILOR_ASSERT(frequency >= 0.0f);
+  SOUNDTAILOR_ASSERT(frequency <= 0.5f);
+  frequency_ = frequency;
+  UpdateIncrements();
+}
+
+void SawtoothUnison::SetDetune(const float detune) {
+  SOUNDTAILOR_ASSERT(detune >= 0.0f);
+  SOUNDTAILOR_ASSERT(detune <= 1.0f);
+  detune_ = detune;
+  UpdateIncrements();
+}
+
+void SawtoothUnison::SetPhaseSpread(const float spread) {
+  SOUNDTAILOR_ASSERT(spread >= 0.0f);
+  SOUNDTAILOR_ASSERT(spread <= 1.0f);
+  phase_spread_ = spread;
+  UpdatePhases();
+}
+
+void SawtoothUnison::SetStereoSpread(const float spread) {
+  SOUNDTAILOR_ASSERT(spread >= 0.0f);
+  SOUNDTAILOR_ASSERT(spread <= 1.0f);
+  stereo_spread_ = spread;
+  UpdateGains();
+}
+
+unsigned int SawtoothUnison::GetVoicesCount(void) const {
+  return voices_count_;
+}
+
+float SawtoothUnison::ComputeSpreadPosition(const unsigned int voice) const {
+  if (voices_count_ < 2) {
+    return 0.0f;
+  }
+  return 2.0f * static_cast<float>(voice) / (voices_count_ - 1) - 1.0f;
+}
+
+void SawtoothUnison::UpdateIncrements(void) {
+  alignas(16) float increments[kMaxVoices] = { 0.0f };
+  alignas(16) float normalizations[kMaxVoices] = { 0.0f };
+  for (unsigned int voice(0); voice < voices_count_; ++voice) {
+    const float detune_factor(1.0f + kMaxDetune * detune_
+                                     * ComputeSpreadPosition(voice));
+    const float frequency(std::min(frequency_ * detune_factor, 0.5f));
+    increments[voice] = 2.0f * frequency;
+    // Silent oscillators are kept silent instead of diverging
+    normalizations[voice] = frequency > 0.0f ? 1.0f / (4.0f * frequency)
+                                             : 0.0f;
+  }
+  for (unsigned int group(0); group < kMaxGroups; ++group) {
+    increments_[group] = VectorMath::Fill(&increments[group * SampleSize]);
+    normalizations_[group] = VectorMath::Fill(&normalizations[group * SampleSize]);
+  }
+}
+
+void SawtoothUnison::UpdatePhases(void) {
+  alignas(16) float phases[kMaxVoices] = { 0.0f };
+  alignas(16) float last[kMaxVoices] = { 0.0f };
+  alignas(16) float increments[kMaxVoices];
+  for (unsigned int group(0); group < kMaxGroups; ++group) {
+    VectorMath::Store(&increments[group * SampleSize], increments_[group]);
+  }
+  for (unsigned int voice(0); voice < voices_count_; ++voice) {
+    const float phase(WrapPhase(2.0f * phase_spread_ * voice / voices_count_));
+    // The history is filled as if the oscillator was already running:
+    // no transient at the beginning
+    const float previous(WrapPhase(phase - increments[voice]));
+    phases[voice] = phase;
+    last[voice] = previous * previous;
+  }
+  for (unsigned int group(0); group < kMaxGroups; ++group) {
+    phases_[group] = VectorMath::Fill(&phases[group * SampleSize]);
+    last_[group] = VectorMath::Fill(&last[group * SampleSize]);
+  }
+}
+
+void SawtoothUnison::UpdateGains(void) {
+  alignas(16) float gains_left[kMaxVoices] = { 0.0f };
+  alignas(16) float gains_right[kMaxVoices] = { 0.0f };
+  // Normalization so that the mix never gets out of [-1.0 ; 1.0]
+  const float kMixGain(1.0f / voices_count_);
+  for (unsigned int voice(0); voice < voices_count_; ++voice) {
+    const float position(stereo_spread_ * ComputeSpreadPosition(voice));
+    // Constant power panning
+    const double angle((position + 1.0) * Pi / 4.0);
+    gains_left[voice] = kMixGain * static_cast<float>(std::cos(angle));
+    gains_right[voice] = kMixGain * static_cast<float>(std::sin(angle));
+  }
+  for (unsigned int group(0); group < kMaxGroups; ++group) {
+    gains_left_[group] = VectorMath::Fill(&gains_left[group * SampleSize]);
+    gains_right_[group] = VectorMath::Fill(&gains_right[group * SampleSize]);
+  }
+}
+
+}  // namespace generators
+}  // namespace soundtailor
@@ -0,0 +1,98 @@
+/// @file sawtooth_unison.h
+/// @brief Unison of detuned sawtooth signal generators (DPW algorithm)
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_GENERATORS_SAWTOOTH_UNISON_H_
+#define SOUNDTAILOR_SRC_GENERATORS_SAWTOOTH_UNISON_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Unison ("supersaw") generator: many detuned sawtooth oscillators
+/// mixed down to a stereo output
+///
+/// Contrary to all other generators, each Sample lane holds a different
+/// oscillator instead of a different time step: SampleSize oscillators are
+/// computed at the cost of one.
+/// Each oscillator uses the same DPW algorithm as SawtoothDPW.
+class SawtoothUnison {
+ public:
+  /// @brief Maximum number of oscillators
+  static const unsigned int kMaxVoices = 16;
+
+  explicit SawtoothUnison(const unsigned int voices_count = 7);
+
+  /// @brief Generate a stereo block
+  ///
+  /// @param[out]  left   Left channel output, block_size long
+  /// @param[out]  right   Right channel output, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockOut left, BlockOut right, std::size_t block_size);
+
+  /// @brief Set the center frequency of all oscillators
+  void SetFrequency(const float frequency);
+  /// @brief Set the frequency spread of the oscillators, in [0.0 ; 1.0]
+  ///
+  /// Outermost oscillators are detuned by about a semitone at max spread
+  void SetDetune(const float detune);
+  /// @brief Set the initial phase spread of the oscillators, in [0.0 ; 1.0]
+  ///
+  /// At max spread oscillators phases are evenly distributed over a period.
+  /// Setting it restarts all oscillators.
+  void SetPhaseSpread(const float spread);
+  /// @brief Set the stereo width of the oscillators, in [0.0 ; 1.0]
+  ///
+  /// At max width outermost oscillators are hard panned left and right
+  void SetStereoSpread(const float spread);
+
+  unsigned int GetVoicesCount(void) const;
+
+ private:
+  /// @brief Number of Samples required to hold all oscillators
+  static const unsigned int kMaxGroups = kMaxVoices / SampleSize;
+
+  /// @brief Relative position of the given oscillator, in [-1.0 ; 1.0]
+  float ComputeSpreadPosition(const unsigned int voice) const;
+  void UpdateIncrements(void);
+  void UpdatePhases(void);
+  void UpdateGains(void);
+
+  Sample phases_[kMaxGroups];  ///< Instantaneous phase of each oscillator
+  Sample increments_[kMaxGroups];  ///< Increment of each oscillator
+  Sample last_[kMaxGroups];  ///< Last parabolized value of each oscillator
+  Sample normalizations_[kMaxGroups];  ///< DPW normalization of each oscillator
+  Sample gains_left_[kMaxGroups];  ///< Left channel gain of each oscillator
+  Sample gains_right_[kMaxGroups];  ///< Right channel gain of each oscillator
+  unsigned int voices_count_;
+  unsigned int groups_count_;  ///< Actual number of Samples in use
+  float frequency_;
+  float detune_;
+  float phase_spread_;
+  float stereo_spread_;
+};
+
+}  // namespace generators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_GENERATORS_SAWTOOTH_UNISON_H_
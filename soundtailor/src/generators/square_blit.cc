@@ -41,6 +41,39 @@ Sample SquareBLIT::operator()(void) {
   return out;
 }
 
+Sample SquareBLIT::ProcessFM(SampleRead frequencies) {
+  const Sample reference(sawtooth1_.ProcessFM(frequencies));
+  const Sample phased(sawtooth2_.ProcessFM(frequencies));
+  const Sample out(VectorMath::Add(reference, VectorMath::MulConst(-1.0f, phased)));
+
+  return out;
+}
+
+Sample SquareBLIT::ProcessPM(SampleRead phase_offsets) {
+  const Sample reference(sawtooth1_.ProcessPM(phase_offsets));
+  const Sample phased(sawtooth2_.ProcessPM(phase_offsets));
+  const Sample out(VectorMath::Add(reference, VectorMath::MulConst(-1.0f, phased)));
+
+  return out;
+}
+
+Sample SquareBLIT::ProcessSyncMaster(
+    Sample* SOUNDTAILOR_RESTRICT sync_positions) {
+  const Sample reference(sawtooth1_.ProcessSyncMaster(sync_positions));
+  const Sample phased(sawtooth2_());
+  const Sample out(VectorMath::Add(reference, VectorMath::MulConst(-1.0f, phased)));
+
+  return out;
+}
+
+Sample SquareBLIT::ProcessSyncSlave(SampleRead sync_positions) {
+  const Sample reference(sawtooth1_.ProcessSyncSlave(sync_positions));
+  const Sample phased(sawtooth2_.ProcessSyncSlave(sync_positions));
+  const Sample out(VectorMath::Add(reference, VectorMath::MulConst(-1.0f, phased)));
+
+  return out;
+}
+
 void SquareBLIT::SetPhase(const float phase) {
   SOUNDTAILOR_ASSERT(phase <= 1.0f);
   SOUNDTAILOR_ASSERT(phase >= -1.0f);
@@ -60,7 +93,7 @@ void SquareBLIT::SetFrequency(const float frequency) {
 float SquareBLIT::ProcessParameters(void) {
   const float out1(sawtooth1_.ProcessParameters());
   const float out2(sawtooth2_.ProcessParameters());
-  return out1 + out2;
+  return out1 - out2;
 }
 
 }  // namespace generators
@@ -34,6 +34,15 @@ public:
   explicit SquareBLIT(const float phase = 0.0f);
 
   Sample operator()(void);
+  /// @brief Audio rate frequency modulation, see PhaseAccumulator::ProcessFM()
+  Sample ProcessFM(SampleRead frequencies);
+  /// @brief Audio rate phase modulation, see PhaseAccumulator::ProcessPM()
+  Sample ProcessPM(SampleRead phase_offsets);
+  /// @brief Hard sync master, see PhaseAccumulator::ProcessSyncMaster()
+  Sample ProcessSyncMaster(Sample* SOUNDTAILOR_RESTRICT sync_positions);
+  /// @brief Hard sync slave, restarting from the beginning of its period
+  /// wherever the master wrapped
+  Sample ProcessSyncSlave(SampleRead sync_positions);
   void SetPhase(const float phase);
   void SetFrequency(const float frequency);
   float ProcessParameters(void);
@@ -30,7 +30,9 @@ namespace generators {
 TriangleDPW::TriangleDPW(const float phase)
     : sawtooth_gen_(),
       differentiator_(),
-      normalization_factor_(0.0f) {
+      offsets_differentiator_(),
+      normalization_factor_(0.0f),
+      applied_frequency_(0.0f) {
   SOUNDTAILOR_ASSERT(phase <= 1.0f);
   SOUNDTAILOR_ASSERT(phase >= -1.0f);
   SetPhase(phase);
@@ -46,7 +48,70 @@ Sample TriangleDPW::operator()(void) {
   const Sample minus(VectorMath::Sub(current, squared));
   // Differentiation & Normalization
   const Sample diff(differentiator_(minus));
-  return VectorMath::MulConst(normalization_factor_, diff);
+  return Normalize(diff);
+}
+
+Sample TriangleDPW::ProcessFM(SampleRead frequencies) {
+  const Sample current(sawtooth_gen_.ProcessFM(frequencies));
+  const Sample current_abs(VectorMath::Abs(current));
+  const Sample squared(VectorMath::Mul(current, current_abs));
+  const Sample minus(VectorMath::Sub(current, squared));
+  const Sample diff(differentiator_(minus));
+  // Each time step phase moved by the previous time step frequency
+  const Sample steps(VectorMath::RotateOnRight(frequencies,
+                                               applied_frequency_));
+  applied_frequency_ = VectorMath::GetLast(frequencies);
+  return VectorMath::Mul(ComputeModulatedNormalization(steps, 0.5f), diff);
+}
+
+Sample TriangleDPW::ProcessPM(SampleRead phase_offsets) {
+  const Sample current(sawtooth_gen_.ProcessPM(phase_offsets));
+  const Sample current_abs(VectorMath::Abs(current));
+  const Sample squared(VectorMath::Mul(current, current_abs));
+  const Sample minus(VectorMath::Sub(current, squared));
+  const Sample diff(differentiator_(minus));
+  // Instantaneous frequency: the base one plus the phase offsets derivative,
+  // the first time step phase having moved by the previous frequency
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  const Sample offsets_diff(
+      VectorMath::Wrap(offsets_differentiator_(phase_offsets)));
+  const Sample frequencies(VectorMath::Add(
+      VectorMath::RotateOnRight(VectorMath::Fill(kFrequency),
+                                applied_frequency_),
+      VectorMath::MulConst(0.5f, offsets_diff)));
+  applied_frequency_ = kFrequency;
+  return VectorMath::Mul(ComputeModulatedNormalization(frequencies, 0.5f),
+                         diff);
+}
+
+Sample TriangleDPW::ProcessSyncMaster(
+    Sample* SOUNDTAILOR_RESTRICT sync_positions) {
+  const Sample current(sawtooth_gen_.ProcessSyncMaster(sync_positions));
+  const Sample current_abs(VectorMath::Abs(current));
+  const Sample squared(VectorMath::Mul(current, current_abs));
+  const Sample minus(VectorMath::Sub(current, squared));
+  const Sample diff(differentiator_(minus));
+  return Normalize(diff);
+}
+
+Sample TriangleDPW::ProcessSyncSlave(SampleRead sync_positions) {
+  Sample reset_from;
+  const Sample current(sawtooth_gen_.ProcessSyncSlave(sync_positions,
+                                                      -1.0f,
+                                                      &reset_from));
+  const Sample current_abs(VectorMath::Abs(current));
+  const Sample squared(VectorMath::Mul(current, current_abs));
+  const Sample minus(VectorMath::Sub(current, squared));
+  const Sample diff(differentiator_(minus));
+  // Synced time steps are integrated over both segments: up to the phase
+  // reached before the reset, then from the reset phase on
+  // (the polynomial is null at the reset phase)
+  const Sample reset_from_squared(
+      VectorMath::Mul(reset_from, VectorMath::Abs(reset_from)));
+  const Sample correction(VectorMath::ExtractValueFromMask(
+      VectorMath::Sub(reset_from, reset_from_squared),
+      IsSynced(sync_positions)));
+  return Normalize(VectorMath::Add(diff, correction));
 }
 
 void TriangleDPW::SetPhase(const float phase) {
@@ -71,7 +136,28 @@ float TriangleDPW::ProcessParameters(void) {
   const float current_abs(std::fabs(current));
   const float squared(current * current_abs);
   const float minus(current - squared);
-  return normalization_factor_ * differentiator_.ProcessParameters(minus);
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  // This time step phase moved by the previous frequency
+  const float kNormalization(
+      applied_frequency_ == kFrequency
+      ? normalization_factor_
+      : ComputeModulatedNormalization(applied_frequency_, 0.5f));
+  applied_frequency_ = kFrequency;
+  return kNormalization * differentiator_.ProcessParameters(minus);
+}
+
+Sample TriangleDPW::Normalize(SampleRead diff) {
+  const float kFrequency(sawtooth_gen_.GetFrequency());
+  // Most common case: same frequency as for the previous time steps
+  if (applied_frequency_ == kFrequency) {
+    return VectorMath::MulConst(normalization_factor_, diff);
+  }
+  // Right after a frequency change or a modulation: the first time step
+  // phase moved by the previous frequency
+  const Sample steps(VectorMath::RotateOnRight(VectorMath::Fill(kFrequency),
+                                               applied_frequency_));
+  applied_frequency_ = kFrequency;
+  return VectorMath::Mul(ComputeModulatedNormalization(steps, 0.5f), diff);
 }
 
 }  // namespace generators
@@ -34,14 +34,30 @@ class TriangleDPW {
   explicit TriangleDPW(const float phase = 0.0f);
 
   Sample operator()(void);
+  /// @brief Audio rate frequency modulation, see PhaseAccumulator::ProcessFM()
+  Sample ProcessFM(SampleRead frequencies);
+  /// @brief Audio rate phase modulation, see PhaseAccumulator::ProcessPM()
+  Sample ProcessPM(SampleRead phase_offsets);
+  /// @brief Hard sync master, see PhaseAccumulator::ProcessSyncMaster()
+  Sample ProcessSyncMaster(Sample* SOUNDTAILOR_RESTRICT sync_positions);
+  /// @brief Hard sync slave, restarting from the beginning of its period
+  /// wherever the master wrapped
+  Sample ProcessSyncSlave(SampleRead sync_positions);
   void SetPhase(const float phase);
   void SetFrequency(const float frequency);
   float ProcessParameters(void);
 
  private:
+  /// @brief Normalize the differentiated signal, each time step according
+  /// to the frequency its phase moved by
+  Sample Normalize(SampleRead diff);
+
   PhaseAccumulator sawtooth_gen_;  //< Internal basic sawtooth signal generator
   Differentiator differentiator_;  //< Internal basic differentiator
+  Differentiator offsets_differentiator_;  //< Phase offsets derivative
   float normalization_factor_;  //< To be applied on the signal after synthesis
+  /// @brief Frequency the phase moved by, up to the next time step
+  float applied_frequency_;
 };
 
 }  // namespace generators
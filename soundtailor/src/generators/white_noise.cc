@@ -0,0 +1,75 @@
+/// @file white_noise.cc
+/// @brief White noise generator - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::memcpy
+#include <cstring>
+
+#include "soundtailor/src/generators/white_noise.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief Integer hash (bijective, "lowbias32"), used for seeding:
+/// close seeds yield uncorrelated states
+static inline std::uint32_t Hash(const std::uint32_t value) {
+  std::uint32_t out(value);
+  out ^= out >> 16;
+  out *= 0x7feb352dU;
+  out ^= out >> 15;
+  out *= 0x846ca68bU;
+  out ^= out >> 16;
+  return out;
+}
+
+WhiteNoise::WhiteNoise(const unsigned int seed)
+    : states_() {
+  SetSeed(seed);
+}
+
+Sample WhiteNoise::operator()(void) {
+  alignas(16) std::uint32_t bits[SampleSize];
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    // xorshift32
+    std::uint32_t state(states_[i]);
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    states_[i] = state;
+    // Highest bits as the mantissa of a float within [1.0 ; 2.0[
+    bits[i] = (state >> 9) | 0x3f800000U;
+  }
+  alignas(16) float values[SampleSize];
+  std::memcpy(&values[0], &bits[0], sizeof(values));
+  // [1.0 ; 2.0[ -> [-1.0 ; 1.0[
+  return VectorMath::Sub(VectorMath::MulConst(2.0f, VectorMath::Fill(&values[0])),
+                         VectorMath::Fill(3.0f));
+}
+
+void WhiteNoise::SetSeed(const unsigned int seed) {
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    const std::uint32_t state(Hash(static_cast<std::uint32_t>(seed)
+                                   * SampleSize + i + 1));
+    // xorshift state is not allowed to be null
+    states_[i] = state != 0 ? state : 0x9e3779b9U;
+  }
+}
+
+}  // namespace generators
+}  // namespace soundtailor
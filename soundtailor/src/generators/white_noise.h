@@ -0,0 +1,53 @@
+/// @file white_noise.h
+/// @brief White noise generator
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_GENERATORS_WHITE_NOISE_H_
+#define SOUNDTAILOR_SRC_GENERATORS_WHITE_NOISE_H_
+
+#include <cstdint>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace generators {
+
+/// @brief White noise generator, uniformly distributed within [-1.0 ; 1.0[
+///
+/// Each Sample lane runs its own xorshift pseudo-random generator:
+/// a full Sample is generated per call with lane-independent integer
+/// operations only, which are easily vectorized.
+/// Identical seeds yield identical sequences on all platforms.
+class WhiteNoise {
+ public:
+  explicit WhiteNoise(const unsigned int seed = 0);
+
+  Sample operator()(void);
+  /// @brief Restart the generator from the given seed
+  void SetSeed(const unsigned int seed);
+
+ private:
+  alignas(16) std::uint32_t states_[SampleSize];  ///< Per-lane generator state
+};
+
+}  // namespace generators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_GENERATORS_WHITE_NOISE_H_
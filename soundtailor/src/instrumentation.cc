@@ -0,0 +1,98 @@
+/// @file instrumentation.cc
+/// @brief Optional hot path instrumentation - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "soundtailor/src/common.h"
+
+#include "soundtailor/src/instrumentation.h"
+
+namespace soundtailor {
+namespace instrumentation {
+
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+
+/// @brief Slots of all threads, statically allocated so that no
+/// allocation ever happens within an instrumented thread
+///
+/// The last one is a sink for threads above kMaxThreads; it is written
+/// to concurrently, and never read.
+static ThreadSlots slots_pool[kMaxThreads + 1];
+static std::atomic<unsigned int> threads_count(0);
+
+ThreadSlots* RegisterThread(void) {
+  const unsigned int kIndex(threads_count.fetch_add(1,
+                                                    std::memory_order_acq_rel));
+  return &slots_pool[kIndex < kMaxThreads ? kIndex : kMaxThreads];
+}
+
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+
+const char* GetProbeName(const Probe probe) {
+  switch (probe) {
+    case(kProbeAdsdTrigger): {
+      return "Adsd::Trigger";
+    }
+    case(kProbeAdsdSectionTransition): {
+      return "Adsd::SectionTransition";
+    }
+    case(kProbeSaturatorClip): {
+      return "Saturators::Clip";
+    }
+    case(kProbeBlitTableClamp): {
+      return "SawtoothBLIT::ReadTableClamp";
+    }
+    case(kProbeSecondOrderRawSetParameters): {
+      return "SecondOrderRaw::SetParameters";
+    }
+    case(kProbeMoogSetParameters): {
+      return "Moog::SetParameters";
+    }
+    case(kProbeStateVariableSetParameters): {
+      return "StateVariable::SetParameters";
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      return "";
+    }
+  }  // switch(probe)
+}
+
+Snapshot TakeSnapshot(void) {
+  Snapshot out = {};
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  const unsigned int kThreadsCount(
+    threads_count.load(std::memory_order_acquire));
+  out.threads_count = kThreadsCount;
+  for (unsigned int thread(0);
+       thread < kThreadsCount && thread < kMaxThreads;
+       ++thread) {
+    for (unsigned int probe(0); probe < kProbesCount; ++probe) {
+      out.counts[probe] += slots_pool[thread].counts[probe].load(
+        std::memory_order_relaxed);
+      out.cycles[probe] += slots_pool[thread].cycles[probe].load(
+        std::memory_order_relaxed);
+    }
+  }
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+  return out;
+}
+
+}  // namespace instrumentation
+}  // namespace soundtailor
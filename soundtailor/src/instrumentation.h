@@ -0,0 +1,178 @@
+/// @file instrumentation.h
+/// @brief Optional hot path instrumentation: counters and cycle timers
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_INSTRUMENTATION_H_
+#define SOUNDTAILOR_SRC_INSTRUMENTATION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "soundtailor/src/configuration.h"
+
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  #include <atomic>
+  #if (_SOUNDTAILOR_COMPILER_MSVC)
+    #include <intrin.h>
+  #elif (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+  #else
+    #include <chrono>
+  #endif  // _SOUNDTAILOR_COMPILER_ ?
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+
+namespace soundtailor {
+namespace instrumentation {
+
+/// @brief All instrumented hot path locations
+enum Probe {
+  kProbeAdsdTrigger = 0,  ///< Adsd note on/off events
+  kProbeAdsdSectionTransition,  ///< Adsd sections changes within processing
+  kProbeSaturatorClip,  ///< Saturators samples clipped (HardClip)
+  kProbeBlitTableClamp,  ///< SawtoothBLIT table reads out of range
+  kProbeSecondOrderRawSetParameters,  ///< Timed
+  kProbeMoogSetParameters,  ///< Timed
+  kProbeStateVariableSetParameters,  ///< Timed
+  kProbesCount
+};
+
+/// @brief Whether instrumentation was enabled at compile time
+/// (see SOUNDTAILOR_ENABLE_INSTRUMENTATION cmake option)
+static const bool kEnabled = (_SOUNDTAILOR_INSTRUMENTATION != 0);
+
+/// @brief Maximum count of instrumented threads: events happening in
+/// any further thread are dropped
+static const unsigned int kMaxThreads = 64;
+
+/// @brief Totals of all instrumented threads since their start
+struct Snapshot {
+  /// @brief Events count (or timed scopes count) per probe
+  std::uint64_t counts[kProbesCount];
+  /// @brief Cycles spent within timed scopes per probe:
+  /// time stamp counter ticks on x86, nanoseconds otherwise
+  std::uint64_t cycles[kProbesCount];
+  /// @brief Count of threads which went through any probe
+  unsigned int threads_count;
+};
+
+/// @brief Human readable name of the given probe
+const char* GetProbeName(const Probe probe);
+
+/// @brief Read all counters; may be called from any thread
+/// (typically not the audio one) without ever blocking instrumented threads
+///
+/// Counters are never reset: compute the difference of two snapshots
+/// in order to get the activity of a given period.
+/// All zeros if instrumentation is disabled.
+Snapshot TakeSnapshot(void);
+
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+
+/// @brief Counters of a single thread
+///
+/// Each instance is only ever written to by its owning thread, hence
+/// the plain load/store updates, and read by TakeSnapshot().
+/// Aligned on cache lines so that threads do not share any.
+struct alignas(64) ThreadSlots {
+  std::atomic<std::uint64_t> counts[kProbesCount];
+  std::atomic<std::uint64_t> cycles[kProbesCount];
+};
+
+/// @brief Allocate slots for the calling thread: lock-free,
+/// only done once per thread
+ThreadSlots* RegisterThread(void);
+
+/// @brief Slots of the calling thread
+inline ThreadSlots& GetThreadSlots(void) {
+  static thread_local ThreadSlots* slots(RegisterThread());
+  return *slots;
+}
+
+/// @brief Single writer increment: no need for an atomic read-modify-write
+inline void Accumulate(std::atomic<std::uint64_t>* slot,
+                       const std::uint64_t value) {
+  slot->store(slot->load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+}
+
+inline void Count(const Probe probe, const std::uint64_t count) {
+  Accumulate(&GetThreadSlots().counts[probe], count);
+}
+
+/// @brief Current cycle counter value (time stamp counter on x86,
+/// nanoseconds elsewhere)
+inline std::uint64_t ReadCycles(void) {
+#if (_SOUNDTAILOR_COMPILER_MSVC || defined(__x86_64__) || defined(__i386__))
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// @brief Count and time the enclosing scope
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const Probe probe)
+      : probe_(probe),
+        begin_(ReadCycles()) {
+  }
+  ~ScopedTimer() {
+    const std::uint64_t kEnd(ReadCycles());
+    ThreadSlots& slots(GetThreadSlots());
+    Accumulate(&slots.counts[probe_], 1);
+    Accumulate(&slots.cycles[probe_], kEnd - begin_);
+  }
+
+ private:
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  const Probe probe_;
+  const std::uint64_t begin_;
+};
+
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+
+}  // namespace instrumentation
+}  // namespace soundtailor
+
+/// @brief Instrumentation macros: expand to nothing when disabled
+///
+/// SOUNDTAILOR_COUNT(probe): count one event
+/// SOUNDTAILOR_COUNT_N(probe, count): count several events at once
+/// SOUNDTAILOR_TIME_SCOPE(probe): count and time the enclosing scope
+#if (_SOUNDTAILOR_INSTRUMENTATION)
+  #define SOUNDTAILOR_COUNT(_probe_) \
+    ::soundtailor::instrumentation::Count( \
+      ::soundtailor::instrumentation::_probe_, 1)
+  #define SOUNDTAILOR_COUNT_N(_probe_, _count_) \
+    ::soundtailor::instrumentation::Count( \
+      ::soundtailor::instrumentation::_probe_, (_count_))
+  #define SOUNDTAILOR_TIME_SCOPE(_probe_) \
+    const ::soundtailor::instrumentation::ScopedTimer \
+      soundtailor_scoped_timer_(::soundtailor::instrumentation::_probe_)
+#else
+  #define SOUNDTAILOR_COUNT(_probe_)
+  #define SOUNDTAILOR_COUNT_N(_probe_, _count_)
+  #define SOUNDTAILOR_TIME_SCOPE(_probe_)
+#endif  // (_SOUNDTAILOR_INSTRUMENTATION)
+
+#endif  // SOUNDTAILOR_SRC_INSTRUMENTATION_H_
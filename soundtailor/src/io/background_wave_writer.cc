@@ -0,0 +1,131 @@
+/// @file background_wave_writer.cc
+/// @brief Wave file writer running in its own thread - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min
+#include <algorithm>
+// std::chrono
+#include <chrono>
+
+#include "soundtailor/src/common.h"
+
+#include "soundtailor/src/io/background_wave_writer.h"
+
+namespace soundtailor {
+namespace io {
+
+const unsigned int BackgroundWaveWriter::kPollingPeriodMs;
+
+BackgroundWaveWriter::BackgroundWaveWriter(const std::size_t capacity)
+    : ring_(capacity),
+      writer_(),
+      buffer_(WaveFileWriter::kChunkSize),
+      channels_count_(1),
+      thread_(),
+      running_(false),
+      failed_(false),
+      frames_count_(0) {
+  // Nothing to do here for now
+}
+
+BackgroundWaveWriter::~BackgroundWaveWriter() {
+  Close();
+}
+
+bool BackgroundWaveWriter::Open(const std::string& filename,
+                                const WaveFormat& format) {
+  Close();
+  // At least one whole frame has to fit in the ring and the buffer
+  SOUNDTAILOR_ASSERT(format.channels_count <= buffer_.size());
+  SOUNDTAILOR_ASSERT(format.channels_count <= ring_.GetCapacity());
+  if (!writer_.Open(filename, format)) {
+    return false;
+  }
+  channels_count_ = format.channels_count;
+  failed_.store(false);
+  frames_count_.store(0);
+  running_.store(true);
+  thread_ = std::thread(&BackgroundWaveWriter::Run, this);
+  return true;
+}
+
+std::size_t BackgroundWaveWriter::Push(const float* frames,
+                                       const std::size_t frames_count) {
+  SOUNDTAILOR_ASSERT(IsOpen());
+  const std::size_t kFrames(std::min(
+    frames_count,
+    ring_.GetWriteAvailable() / channels_count_));
+  const std::size_t kPushed(ring_.Push(frames, kFrames * channels_count_));
+  SOUNDTAILOR_ASSERT(kPushed == kFrames * channels_count_);
+  IGNORE(kPushed);
+  return kFrames;
+}
+
+bool BackgroundWaveWriter::Close(void) {
+  if (!thread_.joinable()) {
+    return !failed_.load();
+  }
+  running_.store(false, std::memory_order_release);
+  thread_.join();
+  if (!writer_.Close()) {
+    failed_.store(true);
+  }
+  return !failed_.load();
+}
+
+bool BackgroundWaveWriter::IsOpen(void) const {
+  return thread_.joinable();
+}
+
+std::size_t BackgroundWaveWriter::GetFramesCount(void) const {
+  return frames_count_.load(std::memory_order_relaxed);
+}
+
+void BackgroundWaveWriter::Run(void) {
+  while (running_.load(std::memory_order_acquire)) {
+    if (Drain() == 0) {
+      std::this_thread::sleep_for(
+        std::chrono::milliseconds(kPollingPeriodMs));
+    }
+  }
+  // Everything pushed before closing is now visible: flushing it
+  while (Drain() > 0) {
+    // Nothing else to do here
+  }
+}
+
+std::size_t BackgroundWaveWriter::Drain(void) {
+  const std::size_t kAvailable(std::min(ring_.GetReadAvailable(),
+                                        buffer_.size()));
+  const std::size_t kCount(kAvailable - kAvailable % channels_count_);
+  if (0 == kCount) {
+    return 0;
+  }
+  ring_.Pop(&buffer_[0], kCount);
+  if (!writer_.Write(&buffer_[0], kCount / channels_count_)) {
+    failed_.store(true);
+  } else {
+    frames_count_.fetch_add(kCount / channels_count_,
+                            std::memory_order_relaxed);
+  }
+  return kCount;
+}
+
+}  // namespace io
+}  // namespace soundtailor
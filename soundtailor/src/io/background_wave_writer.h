@@ -0,0 +1,102 @@
+/// @file background_wave_writer.h
+/// @brief Wave file writer running in its own thread
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_IO_BACKGROUND_WAVE_WRITER_H_
+#define SOUNDTAILOR_SRC_IO_BACKGROUND_WAVE_WRITER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "soundtailor/src/io/ring_buffer.h"
+#include "soundtailor/src/io/wave_file.h"
+#include "soundtailor/src/io/wave_format.h"
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Wave file writer decoupling the rendering thread from the disk
+///
+/// Frames pushed by the rendering thread go through a lock-free ring;
+/// a background thread drains it into a WaveFileWriter. Pushing never
+/// blocks, nor allocates: if the disk cannot keep up and the ring gets
+/// full, only part of the frames are accepted and the caller decides
+/// what to do with the others (retry later, drop them...).
+///
+/// The background thread polls the ring, sleeping kPollingPeriodMs
+/// whenever it is empty: the ring has to hold at least this duration.
+class BackgroundWaveWriter {
+ public:
+  /// @param[in]  capacity   Ring capacity, in values
+  explicit BackgroundWaveWriter(const std::size_t capacity = 1 << 18);
+  ~BackgroundWaveWriter();
+
+  /// @brief Create the given file and start the background thread,
+  /// closing any previous file
+  ///
+  /// @return false if the file could not be created
+  bool Open(const std::string& filename, const WaveFormat& format);
+  /// @brief Queue frames for writing (rendering thread only)
+  ///
+  /// @param[in]  frames   Interleaved frames, frames_count * channels long
+  /// @param[in]  frames_count   Count of frames to write
+  ///
+  /// @return Count of frames actually queued: whole frames only
+  std::size_t Push(const float* frames, const std::size_t frames_count);
+  /// @brief Write all queued frames, stop the background thread and close
+  /// the file (automatically done when destroyed)
+  ///
+  /// @return false if any write error happened since opening
+  bool Close(void);
+
+  bool IsOpen(void) const;
+  /// @brief Count of frames written to disk so far
+  std::size_t GetFramesCount(void) const;
+
+  /// @brief Background thread sleep duration when the ring is empty
+  static const unsigned int kPollingPeriodMs = 1;
+
+ private:
+  BackgroundWaveWriter(const BackgroundWaveWriter&) = delete;
+  BackgroundWaveWriter& operator=(const BackgroundWaveWriter&) = delete;
+
+  /// @brief Background thread loop
+  void Run(void);
+  /// @brief Write whatever is available in the ring, by whole frames
+  ///
+  /// @return Count of values written
+  std::size_t Drain(void);
+
+  RingBuffer ring_;
+  WaveFileWriter writer_;
+  std::vector<float> buffer_;  ///< Values popped from the ring
+  unsigned int channels_count_;
+  std::thread thread_;
+  std::atomic<bool> running_;
+  std::atomic<bool> failed_;
+  std::atomic<std::size_t> frames_count_;
+};
+
+}  // namespace io
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_IO_BACKGROUND_WAVE_WRITER_H_
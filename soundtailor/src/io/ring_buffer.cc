@@ -0,0 +1,91 @@
+/// @file ring_buffer.cc
+/// @brief Lock-free single producer, single consumer ring - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min
+#include <algorithm>
+// std::memcpy
+#include <cstring>
+
+#include "soundtailor/src/common.h"
+
+#include "soundtailor/src/io/ring_buffer.h"
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Lowest power of 2 above the given value
+static std::size_t NextPowerOfTwo(const std::size_t value) {
+  std::size_t out(1);
+  while (out < value) {
+    out *= 2;
+  }
+  return out;
+}
+
+RingBuffer::RingBuffer(const std::size_t capacity)
+    : data_(NextPowerOfTwo(capacity)),
+      mask_(data_.size() - 1),
+      write_index_(0),
+      padding_(),
+      read_index_(0) {
+  SOUNDTAILOR_ASSERT(capacity > 0);
+}
+
+std::size_t RingBuffer::Push(const float* values, const std::size_t count) {
+  const std::size_t kWrite(write_index_.load(std::memory_order_relaxed));
+  const std::size_t kRead(read_index_.load(std::memory_order_acquire));
+  const std::size_t kCount(std::min(count,
+                                    data_.size() - (kWrite - kRead)));
+  // At most two contiguous parts: up to the buffer end, then from its start
+  const std::size_t kBegin(kWrite & mask_);
+  const std::size_t kFirst(std::min(kCount, data_.size() - kBegin));
+  std::memcpy(&data_[kBegin], values, kFirst * sizeof(float));
+  std::memcpy(&data_[0], values + kFirst, (kCount - kFirst) * sizeof(float));
+  write_index_.store(kWrite + kCount, std::memory_order_release);
+  return kCount;
+}
+
+std::size_t RingBuffer::Pop(float* values, const std::size_t count) {
+  const std::size_t kRead(read_index_.load(std::memory_order_relaxed));
+  const std::size_t kWrite(write_index_.load(std::memory_order_acquire));
+  const std::size_t kCount(std::min(count, kWrite - kRead));
+  const std::size_t kBegin(kRead & mask_);
+  const std::size_t kFirst(std::min(kCount, data_.size() - kBegin));
+  std::memcpy(values, &data_[kBegin], kFirst * sizeof(float));
+  std::memcpy(values + kFirst, &data_[0], (kCount - kFirst) * sizeof(float));
+  read_index_.store(kRead + kCount, std::memory_order_release);
+  return kCount;
+}
+
+std::size_t RingBuffer::GetReadAvailable(void) const {
+  return write_index_.load(std::memory_order_acquire)
+         - read_index_.load(std::memory_order_acquire);
+}
+
+std::size_t RingBuffer::GetWriteAvailable(void) const {
+  return data_.size() - GetReadAvailable();
+}
+
+std::size_t RingBuffer::GetCapacity(void) const {
+  return data_.size();
+}
+
+}  // namespace io
+}  // namespace soundtailor
@@ -0,0 +1,75 @@
+/// @file ring_buffer.h
+/// @brief Lock-free single producer, single consumer ring buffer
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_IO_RING_BUFFER_H_
+#define SOUNDTAILOR_SRC_IO_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Lock-free ring buffer of floats, for exactly one producer thread
+/// and one consumer thread
+///
+/// Neither Push() nor Pop() ever block or allocate: they only transfer
+/// what fits, or what is available. Each index is only written by its
+/// own side, and published with release semantics.
+class RingBuffer {
+ public:
+  /// @param[in]  capacity   Minimum capacity, rounded up to a power of 2
+  explicit RingBuffer(const std::size_t capacity);
+
+  /// @brief Append values (producer thread only)
+  ///
+  /// @return Count of values actually appended
+  std::size_t Push(const float* values, const std::size_t count);
+  /// @brief Remove the oldest values (consumer thread only)
+  ///
+  /// @return Count of values actually removed
+  std::size_t Pop(float* values, const std::size_t count);
+
+  /// @brief Values which may be popped (exact from the consumer thread)
+  std::size_t GetReadAvailable(void) const;
+  /// @brief Values which may be pushed (exact from the producer thread)
+  std::size_t GetWriteAvailable(void) const;
+  std::size_t GetCapacity(void) const;
+
+ private:
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  /// @brief Cache line size, to prevent false sharing between both indexes
+  static const std::size_t kCacheLineSize = 64;
+
+  std::vector<float> data_;
+  const std::size_t mask_;
+  // Both indexes are ever increasing, wrapped on access only
+  std::atomic<std::size_t> write_index_;
+  char padding_[kCacheLineSize];
+  std::atomic<std::size_t> read_index_;
+};
+
+}  // namespace io
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_IO_RING_BUFFER_H_
@@ -0,0 +1,251 @@
+/// @file wave_file.cc
+/// @brief Wave files writer and (memory mapped) reader - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "soundtailor/src/common.h"
+
+#if (_SOUNDTAILOR_HAS_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // (_SOUNDTAILOR_HAS_MMAP)
+
+#include "soundtailor/src/io/wave_file.h"
+
+namespace soundtailor {
+namespace io {
+
+const std::size_t WaveFileWriter::kChunkSize;
+
+WaveFileWriter::WaveFileWriter()
+    : file_(nullptr),
+      format_(),
+      header_size_(0),
+      frames_count_(0),
+      buffer_(),
+      failed_(false) {
+  // Nothing to do here for now
+}
+
+WaveFileWriter::~WaveFileWriter() {
+  Close();
+}
+
+bool WaveFileWriter::Open(const std::string& filename,
+                          const WaveFormat& format) {
+  SOUNDTAILOR_ASSERT(format.channels_count > 0);
+  Close();
+  file_ = std::fopen(filename.c_str(), "wb");
+  if (!file_) {
+    return false;
+  }
+  format_ = format;
+  frames_count_ = 0;
+  failed_ = false;
+  buffer_.resize(kChunkSize * GetBytesPerSample(format.sample_format));
+  // Placeholder header, rewritten on closing
+  unsigned char header[kMaxWaveHeaderSize];
+  header_size_ = WriteWaveHeader(format_, 0, &header[0]);
+  failed_ = std::fwrite(&header[0], 1, header_size_, file_) != header_size_;
+  return !failed_;
+}
+
+bool WaveFileWriter::Write(const float* frames,
+                           const std::size_t frames_count) {
+  SOUNDTAILOR_ASSERT(IsOpen());
+  SOUNDTAILOR_ASSERT(frames != nullptr || frames_count == 0);
+  const std::size_t kFrameSize(GetBytesPerFrame(format_));
+  const std::size_t kMaxFrames(
+    (std::numeric_limits<std::uint32_t>::max() - header_size_) / kFrameSize);
+  if (failed_ || frames_count > kMaxFrames - frames_count_) {
+    return false;
+  }
+  const std::size_t kBytesPerSample(GetBytesPerSample(format_.sample_format));
+  const std::size_t kCount(frames_count * format_.channels_count);
+  for (std::size_t i(0); i < kCount; i += kChunkSize) {
+    const std::size_t kChunk(std::min(kChunkSize, kCount - i));
+    ConvertFromFloat(&frames[i], kChunk, format_.sample_format, &buffer_[0]);
+    if (std::fwrite(&buffer_[0], kBytesPerSample, kChunk, file_) != kChunk) {
+      failed_ = true;
+      return false;
+    }
+  }
+  frames_count_ += frames_count;
+  return true;
+}
+
+bool WaveFileWriter::Close(void) {
+  if (!file_) {
+    return true;
+  }
+  unsigned char header[kMaxWaveHeaderSize];
+  const std::size_t kHeaderSize(WriteWaveHeader(
+    format_,
+    static_cast<std::uint32_t>(frames_count_),
+    &header[0]));
+  SOUNDTAILOR_ASSERT(kHeaderSize == header_size_);
+  if (std::fseek(file_, 0, SEEK_SET) != 0
+      || std::fwrite(&header[0], 1, kHeaderSize, file_) != kHeaderSize) {
+    failed_ = true;
+  }
+  if (std::fclose(file_) != 0) {
+    failed_ = true;
+  }
+  file_ = nullptr;
+  return !failed_;
+}
+
+bool WaveFileWriter::IsOpen(void) const {
+  return file_ != nullptr;
+}
+
+const WaveFormat& WaveFileWriter::GetFormat(void) const {
+  return format_;
+}
+
+std::size_t WaveFileWriter::GetFramesCount(void) const {
+  return frames_count_;
+}
+
+WaveFileReader::WaveFileReader()
+    : file_(nullptr),
+      file_size_(0),
+      mapped_(false),
+      content_(),
+      format_(),
+      data_offset_(0),
+      frames_count_(0),
+      position_(0) {
+  // Nothing to do here for now
+}
+
+WaveFileReader::~WaveFileReader() {
+  Close();
+}
+
+bool WaveFileReader::Open(const std::string& filename) {
+  Close();
+#if (_SOUNDTAILOR_HAS_MMAP)
+  const int kDescriptor(open(filename.c_str(), O_RDONLY));
+  if (kDescriptor < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(kDescriptor, &status) == 0 && status.st_size > 0) {
+    void* mapping(mmap(nullptr,
+                       static_cast<std::size_t>(status.st_size),
+                       PROT_READ,
+                       MAP_PRIVATE,
+                       kDescriptor,
+                       0));
+    if (mapping != MAP_FAILED) {
+      // Mostly read from the beginning to the end
+      madvise(mapping, static_cast<std::size_t>(status.st_size),
+              MADV_SEQUENTIAL);
+      file_ = static_cast<const unsigned char*>(mapping);
+      file_size_ = static_cast<std::size_t>(status.st_size);
+      mapped_ = true;
+    }
+  }
+  // The mapping stays valid once the descriptor is closed
+  close(kDescriptor);
+#endif  // (_SOUNDTAILOR_HAS_MMAP)
+  if (!mapped_) {
+    std::FILE* file(std::fopen(filename.c_str(), "rb"));
+    if (!file) {
+      return false;
+    }
+    unsigned char chunk[4096];
+    std::size_t read(0);
+    while ((read = std::fread(&chunk[0], 1, sizeof(chunk), file)) > 0) {
+      content_.insert(content_.end(), &chunk[0], &chunk[0] + read);
+    }
+    std::fclose(file);
+    file_ = content_.empty() ? nullptr : &content_[0];
+    file_size_ = content_.size();
+  }
+  if (!file_
+      || !ParseWaveHeader(file_,
+                          file_size_,
+                          &format_,
+                          &data_offset_,
+                          &frames_count_)) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void WaveFileReader::Close(void) {
+#if (_SOUNDTAILOR_HAS_MMAP)
+  if (mapped_) {
+    munmap(const_cast<unsigned char*>(file_), file_size_);
+  }
+#endif  // (_SOUNDTAILOR_HAS_MMAP)
+  file_ = nullptr;
+  file_size_ = 0;
+  mapped_ = false;
+  content_.clear();
+  data_offset_ = 0;
+  frames_count_ = 0;
+  position_ = 0;
+}
+
+bool WaveFileReader::IsOpen(void) const {
+  return file_ != nullptr;
+}
+
+const WaveFormat& WaveFileReader::GetFormat(void) const {
+  return format_;
+}
+
+std::size_t WaveFileReader::GetFramesCount(void) const {
+  return frames_count_;
+}
+
+std::size_t WaveFileReader::GetPosition(void) const {
+  return position_;
+}
+
+void WaveFileReader::Seek(const std::size_t frame) {
+  position_ = std::min(frame, frames_count_);
+}
+
+std::size_t WaveFileReader::Read(float* frames,
+                                 const std::size_t frames_count) {
+  SOUNDTAILOR_ASSERT(IsOpen());
+  SOUNDTAILOR_ASSERT(frames != nullptr || frames_count == 0);
+  const std::size_t kRead(std::min(frames_count, frames_count_ - position_));
+  const std::size_t kFrameSize(GetBytesPerFrame(format_));
+  ConvertToFloat(&file_[data_offset_ + position_ * kFrameSize],
+                 kRead * format_.channels_count,
+                 format_.sample_format,
+                 frames);
+  position_ += kRead;
+  return kRead;
+}
+
+}  // namespace io
+}  // namespace soundtailor
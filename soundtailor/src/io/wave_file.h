@@ -0,0 +1,140 @@
+/// @file wave_file.h
+/// @brief Wave files writer and (memory mapped) reader
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_IO_WAVE_FILE_H_
+#define SOUNDTAILOR_SRC_IO_WAVE_FILE_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "soundtailor/src/io/wave_format.h"
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Streaming wave file writer
+///
+/// Frames are converted by chunks into an internal buffer allocated once
+/// at opening: writing does not allocate.
+/// Header sizes are only updated on closing.
+///
+/// Usage:
+///
+///     WaveFileWriter writer;
+///     const WaveFormat kFormat = {kSampleFormatInt24, 2, 48000};
+///     writer.Open("out.wav", kFormat);
+///     writer.Write(&interleaved[0], frames_count);
+///     writer.Close();
+class WaveFileWriter {
+ public:
+  WaveFileWriter();
+  ~WaveFileWriter();
+
+  /// @brief Create (or overwrite) the given file, closing any previous one
+  ///
+  /// @return false if the file could not be created
+  bool Open(const std::string& filename, const WaveFormat& format);
+  /// @brief Append frames to the file
+  ///
+  /// @param[in]  frames   Interleaved frames, frames_count * channels long
+  /// @param[in]  frames_count   Count of frames to write
+  ///
+  /// @return false on any write error, or if the file would exceed
+  /// the 4GB wave size limit (in this case nothing is written)
+  bool Write(const float* frames, const std::size_t frames_count);
+  /// @brief Update the header and close the file
+  /// (automatically done when destroyed)
+  ///
+  /// @return false if any error happened since opening
+  bool Close(void);
+
+  bool IsOpen(void) const;
+  const WaveFormat& GetFormat(void) const;
+  /// @brief Count of frames written so far
+  std::size_t GetFramesCount(void) const;
+
+  /// @brief Conversion chunk size, in values
+  static const std::size_t kChunkSize = 4096;
+
+ private:
+  WaveFileWriter(const WaveFileWriter&) = delete;
+  WaveFileWriter& operator=(const WaveFileWriter&) = delete;
+
+  std::FILE* file_;
+  WaveFormat format_;
+  std::size_t header_size_;
+  std::size_t frames_count_;
+  std::vector<unsigned char> buffer_;  ///< Converted values
+  bool failed_;  ///< Any write error happened
+};
+
+/// @brief Wave file reader, mapping the whole file in memory
+/// where available (reading it entirely otherwise)
+///
+/// Only the parts actually read get loaded by the system,
+/// which makes opening large files and seeking within them cheap.
+class WaveFileReader {
+ public:
+  WaveFileReader();
+  ~WaveFileReader();
+
+  /// @brief Open the given file, closing any previous one
+  ///
+  /// @return false if the file could not be read, is invalid
+  /// or its format is not supported
+  bool Open(const std::string& filename);
+  /// @brief Release the file (automatically done when destroyed)
+  void Close(void);
+
+  bool IsOpen(void) const;
+  const WaveFormat& GetFormat(void) const;
+  std::size_t GetFramesCount(void) const;
+  /// @brief Current position, in frames
+  std::size_t GetPosition(void) const;
+  /// @brief Move to the given frame, clamped to the file end
+  void Seek(const std::size_t frame);
+  /// @brief Read frames from the current position, converted into floats
+  ///
+  /// @param[out]  frames   Interleaved frames, frames_count * channels long
+  /// @param[in]  frames_count   Count of frames to read
+  ///
+  /// @return Count of frames actually read, lower at the end of the file
+  std::size_t Read(float* frames, const std::size_t frames_count);
+
+ private:
+  WaveFileReader(const WaveFileReader&) = delete;
+  WaveFileReader& operator=(const WaveFileReader&) = delete;
+
+  const unsigned char* file_;  ///< Whole file content
+  std::size_t file_size_;
+  bool mapped_;  ///< Memory mapped content, or owned by content_
+  std::vector<unsigned char> content_;
+  WaveFormat format_;
+  std::size_t data_offset_;
+  std::size_t frames_count_;
+  std::size_t position_;
+};
+
+}  // namespace io
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_IO_WAVE_FILE_H_
@@ -0,0 +1,371 @@
+/// @file wave_format.cc
+/// @brief Audio samples formats and wave files headers - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::memcpy, std::memcmp
+#include <cstring>
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/io/wave_format.h"
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Wave format tags
+static const std::uint16_t kFormatTagPcm(1);
+static const std::uint16_t kFormatTagFloat(3);
+static const std::uint16_t kFormatTagExtensible(0xFFFE);
+
+/// @brief Integer formats full scale, as float:
+/// the 32 bits one is the highest float below 2^31 (2^31 itself overflows)
+static const float kInt16Scale(32767.0f);
+static const float kInt24Scale(8388607.0f);
+static const float kInt32Scale(2147483520.0f);
+
+/// @brief Write a little endian integer, moving the cursor past it
+template <typename Type>
+static void WriteLittleEndian(const Type value, unsigned char** cursor) {
+  for (unsigned int i(0); i < sizeof(Type); ++i) {
+    **cursor = static_cast<unsigned char>(value >> (8 * i));
+    *cursor += 1;
+  }
+}
+
+/// @brief Read a little endian integer
+template <typename Type>
+static Type ReadLittleEndian(const unsigned char* in) {
+  Type out(0);
+  for (unsigned int i(0); i < sizeof(Type); ++i) {
+    out = static_cast<Type>(out | (static_cast<Type>(in[i]) << (8 * i)));
+  }
+  return out;
+}
+
+/// @brief Write a 4 characters chunk identifier
+static void WriteIdentifier(const char* identifier, unsigned char** cursor) {
+  std::memcpy(*cursor, identifier, 4);
+  *cursor += 4;
+}
+
+/// @brief Store the lowest bytes_count bytes of an integer, little endian
+static inline void StoreInteger(const std::int32_t value,
+                                const unsigned int bytes_count,
+                                unsigned char* out) {
+  const std::uint32_t kValue(static_cast<std::uint32_t>(value));
+  for (unsigned int i(0); i < bytes_count; ++i) {
+    out[i] = static_cast<unsigned char>(kValue >> (8 * i));
+  }
+}
+
+/// @brief Clip, scale and round to nearest one value
+static inline std::int32_t ToInteger(const float value, const float scale) {
+  const float kScaled(std::min(std::max(value, -1.0f), 1.0f) * scale);
+  return static_cast<std::int32_t>(kScaled + (kScaled < 0.0f ? -0.5f : 0.5f));
+}
+
+/// @brief Values converted at once by ConvertToInteger()
+static const std::size_t kConversionChunkSize(256);
+
+/// @brief Clip, scale and round to nearest one Sample
+static inline SampleInt ToInteger(SampleRead value, const float scale) {
+  const Sample kScaled(VectorMath::MulConst(
+    scale,
+    VectorMath::Clamp(value,
+                      VectorMath::Fill(-1.0f),
+                      VectorMath::Fill(1.0f))));
+  // Rounding to nearest, half away from zero
+  return VectorMath::TruncToInt(VectorMath::Add(
+    kScaled,
+    VectorMath::MulConst(0.5f, VectorMath::SgnNoZero(kScaled))));
+}
+
+/// @brief Load SampleSize values from unaligned memory
+static inline Sample LoadUnaligned(const float* in) {
+  // Not using Fill(const float*) which requires aligned data
+  return VectorMath::Fill(in[0], in[1], in[2], in[3]);
+}
+
+/// @brief Integer formats conversion, 16 or 32 bits values
+///
+/// Values are rounded into an aligned buffer, then narrowed or copied
+/// as a whole.
+template <typename Type>
+static void ConvertToInteger(const float* in,
+                             const std::size_t count,
+                             const float scale,
+                             unsigned char* out) {
+  alignas(16) std::int32_t rounded[kConversionChunkSize];
+  alignas(16) Type narrowed[kConversionChunkSize];
+  for (std::size_t begin(0); begin < count; begin += kConversionChunkSize) {
+    const std::size_t kCount(std::min(kConversionChunkSize, count - begin));
+    const float* chunk_in(&in[begin]);
+    std::size_t i(0);
+    for (; i + SampleSize <= kCount; i += SampleSize) {
+      VectorMath::StoreInt(&rounded[i],
+                           ToInteger(LoadUnaligned(&chunk_in[i]), scale));
+    }
+    for (; i < kCount; ++i) {
+      rounded[i] = ToInteger(chunk_in[i], scale);
+    }
+    for (std::size_t j(0); j < kCount; ++j) {
+      narrowed[j] = static_cast<Type>(rounded[j]);
+    }
+    // Little endian platforms only
+    std::memcpy(&out[begin * sizeof(Type)], narrowed, kCount * sizeof(Type));
+  }
+}
+
+/// @brief 24 bits format conversion: one byte at a time
+static void ConvertToInt24(const float* in,
+                           const std::size_t count,
+                           unsigned char* out) {
+  std::size_t i(0);
+  for (; i + SampleSize <= count; i += SampleSize) {
+    const SampleInt kRounded(ToInteger(LoadUnaligned(&in[i]), kInt24Scale));
+    unsigned char* current(&out[i * 3]);
+    StoreInteger(VectorMath::GetByIndex<0>(kRounded), 3, current);
+    StoreInteger(VectorMath::GetByIndex<1>(kRounded), 3, current + 3);
+    StoreInteger(VectorMath::GetByIndex<2>(kRounded), 3, current + 6);
+    StoreInteger(VectorMath::GetByIndex<3>(kRounded), 3, current + 9);
+  }
+  for (; i < count; ++i) {
+    StoreInteger(ToInteger(in[i], kInt24Scale), 3, &out[i * 3]);
+  }
+}
+
+unsigned int GetBytesPerSample(const SampleFormat format) {
+  switch (format) {
+    case(kSampleFormatInt16): {
+      return 2;
+    }
+    case(kSampleFormatInt24): {
+      return 3;
+    }
+    case(kSampleFormatInt32):
+    case(kSampleFormatFloat32): {
+      return 4;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      return 0;
+    }
+  }  // switch(format)
+}
+
+unsigned int GetBytesPerFrame(const WaveFormat& format) {
+  return GetBytesPerSample(format.sample_format) * format.channels_count;
+}
+
+void ConvertFromFloat(const float* in,
+                      const std::size_t count,
+                      const SampleFormat format,
+                      unsigned char* out) {
+  SOUNDTAILOR_ASSERT(in != nullptr || count == 0);
+  SOUNDTAILOR_ASSERT(out != nullptr || count == 0);
+  switch (format) {
+    case(kSampleFormatInt16): {
+      ConvertToInteger<std::int16_t>(in, count, kInt16Scale, out);
+      break;
+    }
+    case(kSampleFormatInt24): {
+      ConvertToInt24(in, count, out);
+      break;
+    }
+    case(kSampleFormatInt32): {
+      ConvertToInteger<std::int32_t>(in, count, kInt32Scale, out);
+      break;
+    }
+    case(kSampleFormatFloat32): {
+      // Little endian platforms only
+      std::memcpy(out, in, count * sizeof(float));
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(format)
+}
+
+void ConvertToFloat(const unsigned char* in,
+                    const std::size_t count,
+                    const SampleFormat format,
+                    float* out) {
+  SOUNDTAILOR_ASSERT(in != nullptr || count == 0);
+  SOUNDTAILOR_ASSERT(out != nullptr || count == 0);
+  // Plain loops, simple enough to be auto-vectorized
+  switch (format) {
+    case(kSampleFormatInt16): {
+      for (std::size_t i(0); i < count; ++i) {
+        const std::int16_t kValue(static_cast<std::int16_t>(
+          ReadLittleEndian<std::uint16_t>(&in[2 * i])));
+        out[i] = kValue * (1.0f / 32768.0f);
+      }
+      break;
+    }
+    case(kSampleFormatInt24): {
+      for (std::size_t i(0); i < count; ++i) {
+        // Sign extension: from the highest byte of a 32 bits integer
+        const std::int32_t kValue(static_cast<std::int32_t>(
+          (static_cast<std::uint32_t>(in[3 * i]) << 8)
+          | (static_cast<std::uint32_t>(in[3 * i + 1]) << 16)
+          | (static_cast<std::uint32_t>(in[3 * i + 2]) << 24)));
+        out[i] = (kValue >> 8) * (1.0f / 8388608.0f);
+      }
+      break;
+    }
+    case(kSampleFormatInt32): {
+      for (std::size_t i(0); i < count; ++i) {
+        const std::int32_t kValue(static_cast<std::int32_t>(
+          ReadLittleEndian<std::uint32_t>(&in[4 * i])));
+        out[i] = kValue * (1.0f / 2147483648.0f);
+      }
+      break;
+    }
+    case(kSampleFormatFloat32): {
+      // Little endian platforms only
+      std::memcpy(out, in, count * sizeof(float));
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(format)
+}
+
+std::size_t WriteWaveHeader(const WaveFormat& format,
+                            const std::uint32_t frames_count,
+                            unsigned char* header) {
+  SOUNDTAILOR_ASSERT(header != nullptr);
+  SOUNDTAILOR_ASSERT(format.channels_count > 0);
+  const bool kIsFloat(kSampleFormatFloat32 == format.sample_format);
+  const std::uint32_t kFrameSize(GetBytesPerFrame(format));
+  const std::uint32_t kDataSize(frames_count * kFrameSize);
+  // Float formats have the extra "cbSize" format field and a "fact" chunk
+  const std::uint32_t kFormatSize(kIsFloat ? 18 : 16);
+  const std::uint32_t kFactSize(kIsFloat ? 12 : 0);
+
+  unsigned char* cursor(header);
+  WriteIdentifier("RIFF", &cursor);
+  WriteLittleEndian<std::uint32_t>(4 + 8 + kFormatSize + kFactSize
+                                   + 8 + kDataSize,
+                                   &cursor);
+  WriteIdentifier("WAVE", &cursor);
+  WriteIdentifier("fmt ", &cursor);
+  WriteLittleEndian<std::uint32_t>(kFormatSize, &cursor);
+  WriteLittleEndian<std::uint16_t>(kIsFloat ? kFormatTagFloat : kFormatTagPcm,
+                                   &cursor);
+  WriteLittleEndian<std::uint16_t>(
+    static_cast<std::uint16_t>(format.channels_count),
+    &cursor);
+  WriteLittleEndian<std::uint32_t>(format.sampling_rate, &cursor);
+  WriteLittleEndian<std::uint32_t>(format.sampling_rate * kFrameSize,
+                                   &cursor);
+  WriteLittleEndian<std::uint16_t>(static_cast<std::uint16_t>(kFrameSize),
+                                   &cursor);
+  WriteLittleEndian<std::uint16_t>(
+    static_cast<std::uint16_t>(8 * GetBytesPerSample(format.sample_format)),
+    &cursor);
+  if (kIsFloat) {
+    WriteLittleEndian<std::uint16_t>(0, &cursor);
+    WriteIdentifier("fact", &cursor);
+    WriteLittleEndian<std::uint32_t>(4, &cursor);
+    WriteLittleEndian<std::uint32_t>(frames_count, &cursor);
+  }
+  WriteIdentifier("data", &cursor);
+  WriteLittleEndian<std::uint32_t>(kDataSize, &cursor);
+
+  const std::size_t kHeaderSize(static_cast<std::size_t>(cursor - header));
+  SOUNDTAILOR_ASSERT(kHeaderSize <= kMaxWaveHeaderSize);
+  return kHeaderSize;
+}
+
+bool ParseWaveHeader(const unsigned char* file,
+                     const std::size_t file_size,
+                     WaveFormat* format,
+                     std::size_t* data_offset,
+                     std::size_t* frames_count) {
+  SOUNDTAILOR_ASSERT(format != nullptr);
+  SOUNDTAILOR_ASSERT(data_offset != nullptr);
+  SOUNDTAILOR_ASSERT(frames_count != nullptr);
+  if (file_size < 12
+      || std::memcmp(&file[0], "RIFF", 4) != 0
+      || std::memcmp(&file[8], "WAVE", 4) != 0) {
+    return false;
+  }
+  bool format_found(false);
+  std::size_t position(12);
+  while (position + 8 <= file_size) {
+    const unsigned char* kChunk(&file[position]);
+    const std::size_t kChunkSize(ReadLittleEndian<std::uint32_t>(&kChunk[4]));
+    const std::size_t kContent(position + 8);
+    if (std::memcmp(kChunk, "fmt ", 4) == 0) {
+      if (kChunkSize < 16 || kContent + kChunkSize > file_size) {
+        return false;
+      }
+      std::uint16_t tag(ReadLittleEndian<std::uint16_t>(&kChunk[8]));
+      const std::uint16_t kChannels(
+        ReadLittleEndian<std::uint16_t>(&kChunk[10]));
+      const std::uint16_t kBits(ReadLittleEndian<std::uint16_t>(&kChunk[22]));
+      // Extensible format: the actual tag begins the sub-format GUID
+      if (kFormatTagExtensible == tag) {
+        if (kChunkSize < 40) {
+          return false;
+        }
+        tag = ReadLittleEndian<std::uint16_t>(&kChunk[32]);
+      }
+      if (kFormatTagPcm == tag && 16 == kBits) {
+        format->sample_format = kSampleFormatInt16;
+      } else if (kFormatTagPcm == tag && 24 == kBits) {
+        format->sample_format = kSampleFormatInt24;
+      } else if (kFormatTagPcm == tag && 32 == kBits) {
+        format->sample_format = kSampleFormatInt32;
+      } else if (kFormatTagFloat == tag && 32 == kBits) {
+        format->sample_format = kSampleFormatFloat32;
+      } else {
+        return false;
+      }
+      if (0 == kChannels) {
+        return false;
+      }
+      format->channels_count = kChannels;
+      format->sampling_rate = ReadLittleEndian<std::uint32_t>(&kChunk[12]);
+      format_found = true;
+    } else if (std::memcmp(kChunk, "data", 4) == 0) {
+      if (!format_found) {
+        return false;
+      }
+      // Truncated files: only keep what is actually there
+      const std::size_t kAvailable(std::min(kChunkSize,
+                                            file_size - kContent));
+      *data_offset = kContent;
+      *frames_count = kAvailable / GetBytesPerFrame(*format);
+      return true;
+    }
+    // Chunks are padded to an even size
+    position = kContent + kChunkSize + (kChunkSize & 1);
+  }
+  return false;
+}
+
+}  // namespace io
+}  // namespace soundtailor
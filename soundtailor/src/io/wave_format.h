@@ -0,0 +1,115 @@
+/// @file wave_format.h
+/// @brief Audio samples formats and wave files headers
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_IO_WAVE_FORMAT_H_
+#define SOUNDTAILOR_SRC_IO_WAVE_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soundtailor {
+namespace io {
+
+/// @brief Available samples formats, all little endian
+enum SampleFormat {
+  kSampleFormatInt16 = 0,
+  kSampleFormatInt24,  ///< Packed on 3 bytes
+  kSampleFormatInt32,
+  kSampleFormatFloat32
+};
+
+/// @brief Layout of an audio stream
+struct WaveFormat {
+  SampleFormat sample_format;
+  unsigned int channels_count;
+  unsigned int sampling_rate;
+};
+
+/// @brief Size of one sample in the given format, in bytes
+unsigned int GetBytesPerSample(const SampleFormat format);
+
+/// @brief Size of one frame (one sample per channel), in bytes
+unsigned int GetBytesPerFrame(const WaveFormat& format);
+
+/// @brief Convert floats into the given format
+///
+/// Values are clipped to [-1.0 ; 1.0] and rounded for integer formats.
+/// Conversion is done by whole Samples, the remainder being done
+/// one value at a time: no alignment requirement.
+///
+/// @param[in]  in   Values to convert, count long
+/// @param[in]  count   Values count
+/// @param[in]  format   Output format
+/// @param[out]  out   Converted values, count * GetBytesPerSample() bytes
+void ConvertFromFloat(const float* in,
+                      const std::size_t count,
+                      const SampleFormat format,
+                      unsigned char* out);
+
+/// @brief Convert values in the given format into floats,
+/// integer formats full scale mapping to [-1.0 ; 1.0[
+///
+/// @param[in]  in   Values to convert, count * GetBytesPerSample() bytes
+/// @param[in]  count   Values count
+/// @param[in]  format   Input format
+/// @param[out]  out   Converted values, count long
+void ConvertToFloat(const unsigned char* in,
+                    const std::size_t count,
+                    const SampleFormat format,
+                    float* out);
+
+/// @brief Maximum wave header size, as written by WriteWaveHeader()
+static const std::size_t kMaxWaveHeaderSize = 58;
+
+/// @brief Write the header of a wave file
+///
+/// Integer formats are written as PCM, float ones as IEEE float
+/// along with the "fact" chunk these require.
+///
+/// @param[in]  format   Stream layout
+/// @param[in]  frames_count   Count of frames in the data chunk
+/// @param[out]  header   At least kMaxWaveHeaderSize bytes long
+///
+/// @return Actual header size, in bytes: data begins right after it
+std::size_t WriteWaveHeader(const WaveFormat& format,
+                            const std::uint32_t frames_count,
+                            unsigned char* header);
+
+/// @brief Parse a whole wave file header, locating its data chunk
+///
+/// Unknown chunks are skipped.
+///
+/// @param[in]  file   Beginning of the file
+/// @param[in]  file_size   File size, in bytes
+/// @param[out]  format   Stream layout
+/// @param[out]  data_offset   Beginning of the data chunk content, in bytes
+/// @param[out]  frames_count   Count of frames in the data chunk
+///
+/// @return false if the file is invalid or its format not supported
+bool ParseWaveHeader(const unsigned char* file,
+                     const std::size_t file_size,
+                     WaveFormat* format,
+                     std::size_t* data_offset,
+                     std::size_t* frames_count);
+
+}  // namespace io
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_IO_WAVE_FORMAT_H_
@@ -23,9 +23,16 @@
 
 #include <cmath>
 #include <cstddef> // size_t
+// std::int32_t
+#include <cstdint>
 // std::min, std::max
 #include <algorithm>
 
+#if !defined(_DISABLE_SIMD)
+// _mm_div_ps, _mm_sqrt_ps, _mm_store_si128
+#include <emmintrin.h>
+#endif  // _DISABLE_SIMD ?
+
 #include "vecmath/inc/maths.h"
 
 #include "soundtailor/src/common.h"
@@ -133,6 +140,82 @@ struct VectorMath : vecmath::PlatformVectorMath {
     return Max(Sub(Fill(0.0f), input), input);
   }
 
+  /// @brief Wrap each element of the input into [-1.0 ; 1.0]
+  ///
+  /// The input is supposed to be within [-5.0 ; 5.0]
+  static inline Sample Wrap(SampleRead input) {
+    const Sample kTwo(Fill(2.0f));
+    const Sample kUpperBound(Fill(1.0f));
+    const Sample kLowerBound(Fill(-1.0f));
+    Sample out(input);
+    for (unsigned int i(0); i < 2; ++i) {
+      const Sample above(LessThan(kUpperBound, out));
+      const Sample below(LessThan(out, kLowerBound));
+      out = Add(Sub(out, ExtractValueFromMask(kTwo, above)),
+                ExtractValueFromMask(kTwo, below));
+    }
+    return out;
+  }
+
+  /// @brief Shift all elements of the input on the left, e.g.:
+  ///
+  /// (a, b, c, d), value -> (b, c, d, value)
+  static inline Sample RotateOnLeft(SampleRead input, const float value) {
+    return Fill(GetByIndex<1>(input),
+                GetByIndex<2>(input),
+                GetByIndex<3>(input),
+                value);
+  }
+
+  /// @brief Compute the inclusive prefix sum of the input, e.g.:
+  ///
+  /// (a, b, c, d) -> (a, a + b, a + b + c, a + b + c + d)
+  static inline Sample PrefixSum(SampleRead input) {
+    // (a, a + b, b + c, c + d)
+    const Sample partial(Add(input, RotateOnRight(input, 0.0f)));
+    // (0, 0, a, a + b)
+    const Sample shifted(RotateOnRight(RotateOnRight(partial, 0.0f), 0.0f));
+    return Add(partial, shifted);
+  }
+
+  /// @brief Compute the reciprocal (1 / x) of each element of the input
+  static inline Sample Reciprocal(SampleRead input) {
+#if !defined(_DISABLE_SIMD)
+    // Full precision division: the approximate _mm_rcp_ps is not enough
+    // for the saturators denominators
+    return _mm_div_ps(_mm_set1_ps(1.0f), input);
+#else
+    return Fill(1.0f / GetByIndex<0>(input),
+                1.0f / GetByIndex<1>(input),
+                1.0f / GetByIndex<2>(input),
+                1.0f / GetByIndex<3>(input));
+#endif  // _DISABLE_SIMD ?
+  }
+
+  /// @brief Compute the square root of each element of the input
+  static inline Sample Sqrt(SampleRead input) {
+#if !defined(_DISABLE_SIMD)
+    return _mm_sqrt_ps(input);
+#else
+    return Fill(std::sqrt(GetByIndex<0>(input)),
+                std::sqrt(GetByIndex<1>(input)),
+                std::sqrt(GetByIndex<2>(input)),
+                std::sqrt(GetByIndex<3>(input)));
+#endif  // _DISABLE_SIMD ?
+  }
+
+  /// @brief Store each element of the input to the given aligned memory
+  static inline void StoreInt(std::int32_t* out, const SampleInt& input) {
+#if !defined(_DISABLE_SIMD)
+    _mm_store_si128(reinterpret_cast<__m128i*>(out), input);
+#else
+    out[0] = GetByIndex<0>(input);
+    out[1] = GetByIndex<1>(input);
+    out[2] = GetByIndex<2>(input);
+    out[3] = GetByIndex<3>(input);
+#endif  // _DISABLE_SIMD ?
+  }
+
   static inline bool Equal(float threshold, SampleRead input) {
     const Sample test_result(vecmath::PlatformVectorMath::Equal(Fill(threshold), input));
     return IsMaskFull(test_result);
@@ -18,6 +18,7 @@
 /// You should have received a copy of the GNU General Public License
 /// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "soundtailor/src/instrumentation.h"
 #include "soundtailor/src/maths.h"
 
 #include "soundtailor/src/modulators/adsd.h"
@@ -42,12 +43,14 @@ Adsd::Adsd()
 }
 
 void Adsd::TriggerOn(void) {
+  SOUNDTAILOR_COUNT(kProbeAdsdTrigger);
   cursor_ = 0;
   current_section_ = kAttack;
   current_increment_ = ComputeIncrement(kMaxAmplitude, attack_);
 }
 
 void Adsd::TriggerOff(void) {
+  SOUNDTAILOR_COUNT(kProbeAdsdTrigger);
   current_section_ = kRelease;
   current_increment_ = ComputeIncrement(-static_cast<float>(current_value_),
                                         decay_);
@@ -61,6 +64,7 @@ float Adsd::ComputeOneSample(void) {
   switch (current_section_) {
     case(kAttack): {
       if (cursor_ > attack_) {
+        SOUNDTAILOR_COUNT(kProbeAdsdSectionTransition);
         current_section_ = GetNextSection(current_section_);
         current_increment_ = ComputeIncrement(sustain_level_ - kMaxAmplitude,
                                               decay_);
@@ -72,6 +76,7 @@ float Adsd::ComputeOneSample(void) {
     }
     case(kDecay): {
       if (cursor_ > actual_decay_) {
+        SOUNDTAILOR_COUNT(kProbeAdsdSectionTransition);
         current_section_ = GetNextSection(current_section_);
         // This might create a tiny jump due to floating point wobble
         current_value_ = static_cast<float>(sustain_level_);
@@ -86,6 +91,7 @@ float Adsd::ComputeOneSample(void) {
     }
     case(kRelease): {
       if (cursor_ > actual_release_) {
+        SOUNDTAILOR_COUNT(kProbeAdsdSectionTransition);
         current_section_ = GetNextSection(current_section_);
       } else {
         current_value_ += current_increment_;
@@ -0,0 +1,247 @@
+/// @file adsd_bank.h
+/// @brief Many ADSD envelop generators processed at once
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_MODULATORS_ADSD_BANK_H_
+#define SOUNDTAILOR_SRC_MODULATORS_ADSD_BANK_H_
+
+#include <bitset>
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/modulators/modulators_common.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Bank of Voices ADSD envelop generators, e.g. one per synth voice
+///
+/// Each envelop behaves as an Adsd one.
+/// All envelops states are stored as lane-parallel arrays
+/// (structure of arrays): each Sample lane holds a different envelop,
+/// and all of them are advanced at once with vector operations only,
+/// section transitions being computed with vector compares and selects.
+/// The cost of the whole bank thus scales with SampleSize instead of Voices.
+///
+/// @tparam  Voices   Number of envelops, has to be a multiple of SampleSize
+template <unsigned int Voices>
+class AdsdBank {
+ public:
+  static_assert(Voices % SampleSize == 0,
+                "Voices count has to be a multiple of SampleSize");
+
+  AdsdBank()
+      : values_(),
+        increments_(),
+        remaining_(),
+        sections_(),
+        attacks_(),
+        attack_increments_(),
+        decays_(),
+        decay_increments_(),
+        decay_inverses_(),
+        sustain_levels_() {
+    for (unsigned int voice(0); voice < Voices; ++voice) {
+      remaining_[voice] = kNoTransition;
+      sections_[voice] = static_cast<float>(kZero);
+      attack_increments_[voice] = 1.0f;
+      decay_increments_[voice] = -1.0f;
+      decay_inverses_[voice] = 1.0f;
+    }
+  }
+
+  void TriggerOn(const unsigned int voice) {
+    SOUNDTAILOR_ASSERT(voice < Voices);
+    sections_[voice] = static_cast<float>(kAttack);
+    increments_[voice] = attack_increments_[voice];
+    remaining_[voice] = attacks_[voice];
+  }
+
+  void TriggerOff(const unsigned int voice) {
+    SOUNDTAILOR_ASSERT(voice < Voices);
+    sections_[voice] = static_cast<float>(kRelease);
+    increments_[voice] = -values_[voice] * decay_inverses_[voice];
+    remaining_[voice] = decays_[voice];
+  }
+
+  /// @brief Compute one sample of all envelops
+  ///
+  /// @param[out]  out   Output values, one per envelop (Voices long)
+  void Process(BlockOut out) {
+    float* SOUNDTAILOR_RESTRICT out_write(out);
+    for (unsigned int first(0); first < Voices; first += SampleSize) {
+      VectorMath::Store(out_write, ProcessGroup(first));
+      out_write += SampleSize;
+    }
+  }
+
+  /// @brief Compute length samples of all envelops
+  ///
+  /// @param[out]  out   Output values, one frame of Voices values
+  ///                    per time step (Voices * length long)
+  /// @param[in]  length   Number of time steps
+  void ProcessBlock(BlockOut out, const std::size_t length) {
+    for (std::size_t i(0); i < length; ++i) {
+      Process(&out[i * Voices]);
+    }
+  }
+
+  /// @brief Same as Adsd::SetParameters(), for the given voice
+  void SetParameters(const unsigned int voice,
+                     const unsigned int attack,
+                     const unsigned int decay,
+                     const unsigned int release,
+                     const float sustain_level) {
+    SOUNDTAILOR_ASSERT(voice < Voices);
+    IGNORE(release);
+    // Null times behave as a single sample
+    const float attack_run(attack > 0 ? static_cast<float>(attack) : 1.0f);
+    const float decay_run(decay > 0 ? static_cast<float>(decay) : 1.0f);
+    attacks_[voice] = static_cast<float>(attack);
+    attack_increments_[voice] = kMaxAmplitude / attack_run;
+    decays_[voice] = static_cast<float>(decay);
+    decay_increments_[voice] = (sustain_level - kMaxAmplitude) / decay_run;
+    decay_inverses_[voice] = 1.0f / decay_run;
+    sustain_levels_[voice] = sustain_level;
+  }
+
+  Section GetCurrentSection(const unsigned int voice) const {
+    SOUNDTAILOR_ASSERT(voice < Voices);
+    return static_cast<Section>(static_cast<int>(sections_[voice]));
+  }
+
+  /// @brief Retrieve which envelops are finished, e.g. back to silence
+  std::bitset<Voices> GetFinishedVoices(void) const {
+    std::bitset<Voices> out;
+    const Sample kOne(VectorMath::Fill(1.0f));
+    for (unsigned int first(0); first < Voices; first += SampleSize) {
+      const Sample finished(VectorMath::ExtractValueFromMask(
+        kOne,
+        VectorMath::LessThan(VectorMath::Fill(kRelease + 0.5f),
+                             VectorMath::Fill(&sections_[first]))));
+      alignas(16) float finished_v[SampleSize];
+      VectorMath::Store(&finished_v[0], finished);
+      for (unsigned int i(0); i < SampleSize; ++i) {
+        out[first + i] = finished_v[i] != 0.0f;
+      }
+    }
+    return out;
+  }
+
+ private:
+  /// @brief Default max level for the apogee of the attack
+  static constexpr float kMaxAmplitude = 1.0f;
+  /// @brief Remaining time for sections without any end (sustain, zero)
+  static constexpr float kNoTransition = 1e30f;
+
+  /// @brief Select, for each lane, a where mask is set and b elsewhere
+  static Sample Select(SampleRead mask, SampleRead a, SampleRead b) {
+    return VectorMath::Add(b,
+                           VectorMath::ExtractValueFromMask(
+                             VectorMath::Sub(a, b),
+                             mask));
+  }
+
+  /// @brief Mask of the lanes being in the given section
+  static Sample IsSection(SampleRead sections, const Section section) {
+    const float kSection(static_cast<float>(section));
+    return VectorMath::ExtractValueFromMask(
+      VectorMath::LessThan(VectorMath::Fill(kSection - 0.5f), sections),
+      VectorMath::LessThan(sections, VectorMath::Fill(kSection + 0.5f)));
+  }
+
+  /// @brief Advance SampleSize envelops by one sample, starting at first
+  Sample ProcessGroup(const unsigned int first) {
+    const Sample kZeroV(VectorMath::Fill(0.0f));
+    const Sample value(VectorMath::Fill(&values_[first]));
+    Sample increment(VectorMath::Fill(&increments_[first]));
+    Sample sections(VectorMath::Fill(&sections_[first]));
+    Sample remaining(VectorMath::Sub(VectorMath::Fill(&remaining_[first]),
+                                     VectorMath::Fill(1.0f)));
+    // Silent envelops output zero
+    const Sample out(VectorMath::ExtractValueFromMask(
+      value,
+      VectorMath::LessThan(sections, VectorMath::Fill(kRelease + 0.5f))));
+    Sample next(VectorMath::Add(value, increment));
+    // Most common case: no section transition at all
+    if (!VectorMath::LessEqual(0.0f, remaining)) {
+      const Sample ended(VectorMath::LessThan(remaining, kZeroV));
+      const Sample attack_end(VectorMath::ExtractValueFromMask(
+        ended,
+        IsSection(sections, kAttack)));
+      const Sample other_end(VectorMath::ExtractValueFromMask(
+        ended,
+        VectorMath::LessThan(VectorMath::Fill(kAttack + 0.5f), sections)));
+      const Sample decay_increment(VectorMath::Fill(&decay_increments_[first]));
+      // Attack -> decay
+      next = Select(attack_end,
+                    VectorMath::Add(VectorMath::Fill(kMaxAmplitude),
+                                    decay_increment),
+                    next);
+      increment = Select(attack_end, decay_increment, increment);
+      remaining = Select(attack_end,
+                         VectorMath::Sub(VectorMath::Fill(&decays_[first]),
+                                         VectorMath::Fill(1.0f)),
+                         remaining);
+      // Decay -> sustain, release -> zero
+      next = Select(VectorMath::ExtractValueFromMask(
+                      other_end,
+                      IsSection(sections, kDecay)),
+                    VectorMath::Fill(&sustain_levels_[first]),
+                    next);
+      next = Select(VectorMath::ExtractValueFromMask(
+                      other_end,
+                      IsSection(sections, kRelease)),
+                    value,
+                    next);
+      increment = Select(other_end, kZeroV, increment);
+      remaining = Select(other_end, VectorMath::Fill(kNoTransition), remaining);
+      sections = VectorMath::Add(
+        sections,
+        VectorMath::ExtractValueFromMask(VectorMath::Fill(1.0f), ended));
+      VectorMath::Store(&increments_[first], increment);
+      VectorMath::Store(&sections_[first], sections);
+    }
+    VectorMath::Store(&values_[first], next);
+    VectorMath::Store(&remaining_[first], remaining);
+    return out;
+  }
+
+  alignas(16) float values_[Voices];  ///< Current amplitudes
+  alignas(16) float increments_[Voices];  ///< Increments for current slopes
+  alignas(16) float remaining_[Voices];  ///< Time left in current sections
+  alignas(16) float sections_[Voices];  ///< Current sections, as floats
+  alignas(16) float attacks_[Voices];  ///< Time settings for the attack
+  alignas(16) float attack_increments_[Voices];  ///< Attack slopes
+  alignas(16) float decays_[Voices];  ///< Time settings for the decay
+  alignas(16) float decay_increments_[Voices];  ///< Decay slopes
+  alignas(16) float decay_inverses_[Voices];  ///< Inverses of decay times
+  alignas(16) float sustain_levels_[Voices];  ///< Sustain amplitudes
+};
+
+template <unsigned int Voices>
+constexpr float AdsdBank<Voices>::kMaxAmplitude;
+template <unsigned int Voices>
+constexpr float AdsdBank<Voices>::kNoTransition;
+
+}  // namespace modulators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_MODULATORS_ADSD_BANK_H_
@@ -0,0 +1,206 @@
+/// @file adsr.cc
+/// @brief Envelop generator using Attack-Decay-Sustain-Release (ADSR) model - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::pow
+#include <cmath>
+
+#include "soundtailor/src/maths.h"
+
+#include "soundtailor/src/modulators/adsr.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Default max level for the apogee of the attack
+static const float kMaxAmplitude(1.0f);
+
+const float Adsr::kAttackRatio(0.3f);
+const float Adsr::kDecayRatio(0.05f);
+
+Adsr::Adsr()
+    : powers_(VectorMath::Fill(1.0f)),
+      coefficient_(1.0f),
+      block_coefficient_(1.0f),
+      target_(0.0f),
+      distance_(0.0f),
+      value_(0.0f),
+      end_level_(0.0f),
+      current_section_(kZero),
+      sustain_level_(0.0f),
+      attack_coefficient_(0.0f),
+      decay_coefficient_(0.0f),
+      release_coefficient_(0.0f),
+      remaining_(0),
+      attack_(0),
+      decay_(0),
+      release_(0) {
+  // Nothing to do here for now
+}
+
+void Adsr::TriggerOn(void) {
+  StartSection(kAttack);
+}
+
+void Adsr::TriggerOff(void) {
+  StartSection(kRelease);
+}
+
+float Adsr::ComputeOneSample(void) {
+  const float out(value_);
+  switch (current_section_) {
+    case(kAttack):
+    case(kDecay):
+    case(kRelease): {
+      if (remaining_ <= 1) {
+        // Snapping to the exact end level, discarding any rounding error
+        value_ = end_level_;
+        StartSection(GetNextSection(current_section_));
+      } else {
+        distance_ *= coefficient_;
+        value_ = target_ + distance_;
+        remaining_ -= 1;
+      }
+      break;
+    }
+    case(kSustain):
+    case(kZero): {
+      // Nothing to do here
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+    }
+  }  // switch(current_section_)
+
+  return out;
+}
+
+Sample Adsr::operator()() {
+  if (kSustain == current_section_ || kZero == current_section_) {
+    return VectorMath::Fill(value_);
+  }
+  if (remaining_ > SampleSize) {
+    // The whole Sample lies within the current segment
+    const Sample out(VectorMath::Add(VectorMath::Fill(target_),
+                                     VectorMath::MulConst(distance_, powers_)));
+    distance_ *= block_coefficient_;
+    value_ = target_ + distance_;
+    remaining_ -= SampleSize;
+    return out;
+  }
+  // Segment end: section transitions are handled sample per sample
+  const float a(ComputeOneSample());
+  const float b(ComputeOneSample());
+  const float c(ComputeOneSample());
+  const float d(ComputeOneSample());
+  return VectorMath::Fill(a, b, c, d);
+}
+
+void Adsr::SetParameters(const unsigned int attack,
+                         const unsigned int decay,
+                         const unsigned int release,
+                         const float sustain_level) {
+  SOUNDTAILOR_ASSERT(sustain_level >= 0.0f);
+  SOUNDTAILOR_ASSERT(sustain_level <= kMaxAmplitude);
+  attack_ = attack;
+  decay_ = decay;
+  release_ = release;
+  sustain_level_ = sustain_level;
+  attack_coefficient_ = ComputeCoefficient(kAttackRatio, attack);
+  decay_coefficient_ = ComputeCoefficient(kDecayRatio, decay);
+  release_coefficient_ = ComputeCoefficient(kDecayRatio, release);
+}
+
+Section Adsr::GetCurrentSection(void) const {
+  return current_section_;
+}
+
+void Adsr::StartSection(const Section section) {
+  current_section_ = section;
+  unsigned int time(0);
+  float ratio(0.0f);
+  while (true) {
+    switch (current_section_) {
+      case(kAttack): {
+        time = attack_;
+        ratio = kAttackRatio;
+        coefficient_ = attack_coefficient_;
+        end_level_ = kMaxAmplitude;
+        break;
+      }
+      case(kDecay): {
+        time = decay_;
+        ratio = kDecayRatio;
+        coefficient_ = decay_coefficient_;
+        end_level_ = sustain_level_;
+        break;
+      }
+      case(kSustain): {
+        value_ = sustain_level_;
+        return;
+      }
+      case(kRelease): {
+        time = release_;
+        ratio = kDecayRatio;
+        coefficient_ = release_coefficient_;
+        end_level_ = 0.0f;
+        break;
+      }
+      case(kZero): {
+        value_ = 0.0f;
+        return;
+      }
+      default: {
+        // Should never happen
+        SOUNDTAILOR_ASSERT(false);
+        return;
+      }
+    }  // switch(current_section_)
+    if (time > 0) {
+      break;
+    }
+    // Null length segment: directly jumping to its end
+    value_ = end_level_;
+    current_section_ = GetNextSection(current_section_);
+  }
+  // The target is set beyond the end level so that the latter is reached
+  // after exactly "time" samples, whatever the starting value
+  target_ = end_level_ + ratio * (end_level_ - value_);
+  distance_ = value_ - target_;
+  remaining_ = time;
+  const float squared(coefficient_ * coefficient_);
+  powers_ = VectorMath::Fill(1.0f,
+                             coefficient_,
+                             squared,
+                             squared * coefficient_);
+  block_coefficient_ = squared * squared;
+}
+
+float Adsr::ComputeCoefficient(const float ratio, const unsigned int time) {
+  if (0 == time) {
+    return 0.0f;
+  }
+  // (end - target) = (start - target) * coefficient ^ time
+  return static_cast<float>(std::pow(ratio / (1.0 + ratio), 1.0 / time));
+}
+
+}  // namespace modulators
+}  // namespace soundtailor
@@ -0,0 +1,93 @@
+/// @file adsr.h
+/// @brief Envelop generator using Attack-Decay-Sustain-Release (ADSR) model
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_MODULATORS_ADSR_H_
+#define SOUNDTAILOR_SRC_MODULATORS_ADSR_H_
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/modulators/modulators_common.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Attack-Decay-Sustain-Release envelop with exponential (RC-like)
+/// segments and a release time independent of the decay
+///
+/// Each segment is a one-pole recursion toward a target slightly beyond
+/// the segment end level, so that this level is reached in exactly
+/// the required time:
+/// value[n] = target + (value[0] - target) * coefficient ^ n
+/// Within a segment a whole Sample is thus computed at once
+/// from the precomputed powers of the coefficient.
+class Adsr {
+ public:
+  Adsr();
+
+  void TriggerOn(void);
+  void TriggerOff(void);
+
+  float ComputeOneSample(void);
+  Sample operator()(void);
+
+  void SetParameters(const unsigned int attack,
+                     const unsigned int decay,
+                     const unsigned int release,
+                     const float sustain_level);
+
+  Section GetCurrentSection(void) const;
+
+  /// @brief Overshoot of the attack target, relatively to the attack rise:
+  /// the lower, the more curved the attack
+  static const float kAttackRatio;
+  /// @brief Overshoot of the decay and release targets, relatively to
+  /// their fall: the lower, the more curved these segments
+  static const float kDecayRatio;
+
+ private:
+  /// @brief Start the given section from the current value,
+  /// directly skipping null length sections
+  void StartSection(const Section section);
+
+  /// @brief Helper function for computing the one-pole coefficient
+  /// required to reach the end of a segment in the given time
+  static float ComputeCoefficient(const float ratio, const unsigned int time);
+
+  Sample powers_;  ///< Powers of the current coefficient, from 0 to 3
+  float coefficient_;  ///< Coefficient to use for the current segment
+  float block_coefficient_;  ///< Current coefficient to the power of 4
+  float target_;  ///< Asymptotic value of the current segment
+  float distance_;  ///< Distance between the current value and the target
+  float value_;  ///< Current amplitude
+  float end_level_;  ///< Amplitude at the end of the current segment
+  Section current_section_;  ///< The current part of the generated envelop
+  float sustain_level_;  ///< Amplitude to maintain while sustain is on
+  float attack_coefficient_;  ///< Coefficient for the attack segment
+  float decay_coefficient_;  ///< Coefficient for the decay segment
+  float release_coefficient_;  ///< Coefficient for the release segment
+  unsigned int remaining_;  ///< Samples left until the current segment end
+  unsigned int attack_;  ///< Time setting for the attack
+  unsigned int decay_;  ///< Time setting for the decay
+  unsigned int release_;  ///< Time setting for the release
+};
+
+}  // namespace modulators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_MODULATORS_ADSR_H_
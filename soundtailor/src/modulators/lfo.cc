@@ -0,0 +1,214 @@
+/// @file lfo.cc
+/// @brief Low frequency oscillators - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::ceil, std::floor
+#include <cmath>
+
+#include "soundtailor/src/modulators/lfo.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Wrap the given phase into [-1.0 ; 1.0], whatever its value
+///
+/// @param[in]  phase   Phase to wrap
+/// @param[out]  wrapped   Whether or not the phase had to be wrapped
+static inline float WrapPhase(const double phase, bool* wrapped) {
+  double out(phase);
+  if (out > 1.0) {
+    out -= 2.0 * std::ceil((out - 1.0) * 0.5);
+    *wrapped = true;
+  } else if (out < -1.0) {
+    out += 2.0 * std::ceil((-1.0 - out) * 0.5);
+  }
+  return static_cast<float>(out);
+}
+
+Lfo::Lfo(const LfoWaveform waveform, const unsigned int seed)
+    : white_(seed),
+      phase_(-1.0f),
+      increment_(0.0f),
+      last_(0.0f),
+      held_(0.0f),
+      period_beats_(1.0f),
+      waveform_(waveform),
+      rate_(kLfoAudioRate) {
+  SetSeed(seed);
+}
+
+Sample Lfo::operator()(void) {
+  const float previous(phase_);
+  const Sample phases(VectorMath::Wrap(VectorMath::FillIncremental(phase_,
+                                                                   increment_)));
+  bool wrapped(false);
+  phase_ = WrapPhase(phase_ + SampleSize * increment_, &wrapped);
+  IGNORE(wrapped);
+  if (kLfoSampleAndHold != waveform_) {
+    return ComputeShape(phases);
+  }
+  // A new value is drawn on each phase wrap, e.g. each time the phase
+  // decreases: this is not worth vectorizing
+  alignas(16) float phases_v[SampleSize];
+  alignas(16) float out[SampleSize];
+  VectorMath::Store(&phases_v[0], phases);
+  float last_phase(previous);
+  for (unsigned int i(0); i < SampleSize; ++i) {
+    if (phases_v[i] < last_phase) {
+      held_ = VectorMath::GetFirst(white_());
+    }
+    last_phase = phases_v[i];
+    out[i] = held_;
+  }
+  return VectorMath::Fill(&out[0]);
+}
+
+float Lfo::ProcessControl(const std::size_t length) {
+  bool wrapped(false);
+  phase_ = WrapPhase(phase_ + static_cast<double>(length) * increment_,
+                     &wrapped);
+  if (wrapped && kLfoSampleAndHold == waveform_) {
+    held_ = VectorMath::GetFirst(white_());
+  }
+  last_ = ComputeCurrentValue();
+  return last_;
+}
+
+void Lfo::ProcessBlock(BlockOut out, const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  if (kLfoAudioRate == rate_) {
+    for (std::size_t i(0); i < block_size; i += SampleSize) {
+      VectorMath::Store(out_write, (*this)());
+      out_write += SampleSize;
+    }
+    return;
+  }
+  // Ramping from the last value up to the one at the end of this block
+  const float start(last_);
+  const float end(ProcessControl(block_size));
+  const float step((end - start) / static_cast<float>(block_size));
+  const Sample increment(VectorMath::Fill(step * SampleSize));
+  Sample ramp(VectorMath::FillIncremental(start + step, step));
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    VectorMath::Store(out_write, ramp);
+    ramp = VectorMath::Add(ramp, increment);
+    out_write += SampleSize;
+  }
+}
+
+void Lfo::SetWaveform(const LfoWaveform waveform) {
+  waveform_ = waveform;
+  last_ = ComputeCurrentValue();
+}
+
+void Lfo::SetRate(const LfoRate rate) {
+  rate_ = rate;
+  last_ = ComputeCurrentValue();
+}
+
+void Lfo::SetFrequency(const float frequency) {
+  SOUNDTAILOR_ASSERT(frequency >= 0.0f);
+  SOUNDTAILOR_ASSERT(frequency <= 0.5f);
+  increment_ = 2.0f * frequency;
+}
+
+void Lfo::SetTempoSync(const float tempo,
+                       const float beats,
+                       const float sampling_rate) {
+  SOUNDTAILOR_ASSERT(tempo > 0.0f);
+  SOUNDTAILOR_ASSERT(beats > 0.0f);
+  SOUNDTAILOR_ASSERT(sampling_rate > 0.0f);
+  period_beats_ = beats;
+  SetFrequency(tempo / (60.0f * beats * sampling_rate));
+}
+
+void Lfo::SetPhase(const float phase) {
+  SOUNDTAILOR_ASSERT(phase >= 0.0f);
+  SOUNDTAILOR_ASSERT(phase < 1.0f);
+  phase_ = 2.0f * phase - 1.0f;
+  last_ = ComputeCurrentValue();
+}
+
+void Lfo::SyncToPosition(const double position) {
+  SOUNDTAILOR_ASSERT(position >= 0.0);
+  const double periods(position / period_beats_);
+  const float phase(static_cast<float>(periods - std::floor(periods)));
+  // Rounding may yield exactly one period
+  SetPhase(phase < 1.0f ? phase : 0.0f);
+}
+
+void Lfo::SetSeed(const unsigned int seed) {
+  white_.SetSeed(seed);
+  held_ = VectorMath::GetFirst(white_());
+  last_ = ComputeCurrentValue();
+}
+
+LfoWaveform Lfo::GetWaveform(void) const {
+  return waveform_;
+}
+
+LfoRate Lfo::GetRate(void) const {
+  return rate_;
+}
+
+Sample Lfo::ComputeShape(SampleRead phases) const {
+  switch (waveform_) {
+    case(kLfoSine): {
+      // Parabolic approximation of sin(pi * phase), then refined:
+      // maximum error is about 1e-3
+      const Sample kOne(VectorMath::Fill(1.0f));
+      const Sample abs_phases(VectorMath::Abs(phases));
+      const Sample parabola(VectorMath::MulConst(
+        4.0f,
+        VectorMath::Mul(phases, VectorMath::Sub(kOne, abs_phases))));
+      const Sample correction(VectorMath::Sub(
+        VectorMath::Mul(parabola, VectorMath::Abs(parabola)),
+        parabola));
+      return VectorMath::Add(parabola,
+                             VectorMath::MulConst(0.225f, correction));
+    }
+    case(kLfoTriangle): {
+      return VectorMath::Sub(VectorMath::Fill(1.0f),
+                             VectorMath::MulConst(2.0f,
+                                                  VectorMath::Abs(phases)));
+    }
+    case(kLfoSawtooth): {
+      return phases;
+    }
+    case(kLfoSquare): {
+      return VectorMath::SgnNoZero(phases);
+    }
+    case(kLfoSampleAndHold): {
+      return VectorMath::Fill(held_);
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      return VectorMath::Fill(0.0f);
+    }
+  }  // switch(waveform_)
+}
+
+float Lfo::ComputeCurrentValue(void) const {
+  return VectorMath::GetFirst(ComputeShape(VectorMath::Fill(phase_)));
+}
+
+}  // namespace modulators
+}  // namespace soundtailor
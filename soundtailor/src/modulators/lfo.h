@@ -0,0 +1,124 @@
+/// @file lfo.h
+/// @brief Low frequency oscillators, running at control or audio rate
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_MODULATORS_LFO_H_
+#define SOUNDTAILOR_SRC_MODULATORS_LFO_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Available LFO waveforms
+enum LfoWaveform {
+  kLfoSine = 0,
+  kLfoTriangle,
+  kLfoSawtooth,
+  kLfoSquare,
+  kLfoSampleAndHold
+};
+
+/// @brief Available LFO evaluation rates
+enum LfoRate {
+  kLfoAudioRate = 0,  ///< One value per sample
+  kLfoControlRate  ///< One value per block, linearly interpolated
+};
+
+/// @brief Low frequency oscillator, output within [-1.0 ; 1.0]
+///
+/// At audio rate each sample is computed, as for any generator.
+/// At control rate the waveform is only evaluated once per block,
+/// output samples ramping linearly from the previous block value:
+/// this is most of the time enough for slow modulations, and much cheaper.
+///
+/// The phase follows the same convention as all generators,
+/// e.g. it lies within [-1.0 ; 1.0].
+class Lfo {
+ public:
+  explicit Lfo(const LfoWaveform waveform = kLfoSine,
+               const unsigned int seed = 0);
+
+  /// @brief Audio rate generation, whatever the rate setting
+  Sample operator()(void);
+  /// @brief Advance the oscillator by the given length at once
+  ///
+  /// @param[in]  length   Number of samples to skip
+  ///
+  /// @return the oscillator value at the end of this length
+  float ProcessControl(const std::size_t length);
+  /// @brief Generate a block, at the rate given by SetRate()
+  ///
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockOut out, const std::size_t block_size);
+
+  void SetWaveform(const LfoWaveform waveform);
+  void SetRate(const LfoRate rate);
+  /// @brief Set the oscillator frequency (normalized)
+  void SetFrequency(const float frequency);
+  /// @brief Set the oscillator period as a musical duration
+  ///
+  /// @param[in]  tempo   Tempo in beats per minute
+  /// @param[in]  beats   Period length, in beats (e.g. 0.25 for a 16th note)
+  /// @param[in]  sampling_rate   Sampling rate, in Hz
+  void SetTempoSync(const float tempo,
+                    const float beats,
+                    const float sampling_rate);
+  /// @brief Set the current phase, as a fraction of the period in [0.0 ; 1.0[
+  void SetPhase(const float phase);
+  /// @brief Align the phase on the given song position
+  ///
+  /// The period length is the one given to SetTempoSync(),
+  /// a phase of 0 matching the song start
+  ///
+  /// @param[in]  position   Song position, in beats
+  void SyncToPosition(const double position);
+  /// @brief Restart the sample and hold random generator from the given seed
+  void SetSeed(const unsigned int seed);
+
+  LfoWaveform GetWaveform(void) const;
+  LfoRate GetRate(void) const;
+
+ private:
+  /// @brief Compute the waveform for each given phase
+  ///
+  /// The sample and hold waveform is not handled here
+  Sample ComputeShape(SampleRead phases) const;
+  /// @brief Compute the value at the current phase
+  float ComputeCurrentValue(void) const;
+
+  generators::WhiteNoise white_;  ///< Sample and hold random values generator
+  float phase_;  ///< Current phase
+  float increment_;  ///< Phase increment per sample
+  float last_;  ///< Value at the end of the last control rate block
+  float held_;  ///< Currently held random value
+  float period_beats_;  ///< Period length in beats, for tempo sync
+  LfoWaveform waveform_;
+  LfoRate rate_;
+};
+
+}  // namespace modulators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_MODULATORS_LFO_H_
@@ -0,0 +1,192 @@
+/// @file modulation_matrix.cc
+/// @brief Modulation matrix - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::min
+#include <algorithm>
+
+#include "soundtailor/src/modulators/modulation_matrix.h"
+
+namespace soundtailor {
+namespace modulators {
+
+ModulationMatrix::ModulationMatrix(const std::size_t max_block_size)
+    : amounts_(),
+      bases_(),
+      mins_(),
+      maxs_(),
+      values_(),
+      source_values_(),
+      routes_count_(),
+      ramping_(),
+      sources_(),
+      destinations_(),
+      rates_(),
+      blocks_(),
+      max_block_size_(max_block_size) {
+  SOUNDTAILOR_ASSERT(max_block_size % SampleSize == 0);
+  sources_.reserve(kMaxSources);
+  destinations_.reserve(kMaxDestinations);
+  rates_.reserve(kMaxDestinations);
+  blocks_.reserve(kMaxDestinations);
+}
+
+unsigned int ModulationMatrix::AddSource(const Source& source) {
+  SOUNDTAILOR_ASSERT(sources_.size() < kMaxSources);
+  sources_.push_back(source);
+  return static_cast<unsigned int>(sources_.size() - 1);
+}
+
+unsigned int ModulationMatrix::AddDestination(const Destination& destination,
+                                              const float base,
+                                              const float min,
+                                              const float max,
+                                              const DestinationRate rate) {
+  SOUNDTAILOR_ASSERT(destinations_.size() < kMaxDestinations);
+  SOUNDTAILOR_ASSERT(min <= max);
+  const unsigned int index(static_cast<unsigned int>(destinations_.size()));
+  destinations_.push_back(destination);
+  rates_.push_back(rate);
+  mins_[index] = min;
+  maxs_[index] = max;
+  SetBase(index, base);
+  // Nothing pushed yet: the destination is supposed to be at its base value
+  values_[index] = bases_[index];
+  // Allocation only occurs here, never while processing
+  blocks_.push_back(std::vector<float>(
+    kDestinationAudioRate == rate ? max_block_size_ : 0,
+    values_[index]));
+  return index;
+}
+
+void ModulationMatrix::SetRoute(const unsigned int source,
+                                const unsigned int destination,
+                                const float amount) {
+  SOUNDTAILOR_ASSERT(source < sources_.size());
+  SOUNDTAILOR_ASSERT(destination < destinations_.size());
+  const bool was_routed(0.0f != amounts_[source][destination]);
+  const bool is_routed(0.0f != amount);
+  if (was_routed && !is_routed) {
+    routes_count_[source] -= 1;
+  } else if (!was_routed && is_routed) {
+    routes_count_[source] += 1;
+  }
+  amounts_[source][destination] = amount;
+}
+
+void ModulationMatrix::SetBase(const unsigned int destination,
+                               const float base) {
+  SOUNDTAILOR_ASSERT(destination < destinations_.size());
+  SOUNDTAILOR_ASSERT(base >= mins_[destination]);
+  SOUNDTAILOR_ASSERT(base <= maxs_[destination]);
+  bases_[destination] = base;
+}
+
+void ModulationMatrix::Process(const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  SOUNDTAILOR_ASSERT(block_size <= max_block_size_);
+  // Sources: all evaluated once, even if not routed,
+  // so that they keep on running
+  const unsigned int sources_count(static_cast<unsigned int>(sources_.size()));
+  for (unsigned int source(0); source < sources_count; ++source) {
+    source_values_[source] = sources_[source](block_size);
+  }
+  // Destinations: computed SampleSize at a time
+  const unsigned int destinations_count(
+    static_cast<unsigned int>(destinations_.size()));
+  for (unsigned int first(0);
+       first < destinations_count;
+       first += SampleSize) {
+    Sample value(VectorMath::Fill(&bases_[first]));
+    for (unsigned int source(0); source < sources_count; ++source) {
+      if (0 == routes_count_[source]) {
+        continue;
+      }
+      const Sample amounts(VectorMath::Fill(&amounts_[source][first]));
+      value = VectorMath::Add(value,
+                              VectorMath::MulConst(source_values_[source],
+                                                   amounts));
+    }
+    value = VectorMath::Clamp(value,
+                              VectorMath::Fill(&mins_[first]),
+                              VectorMath::Fill(&maxs_[first]));
+    const Sample previous(VectorMath::Fill(&values_[first]));
+    const bool is_ramping(ramping_[first]
+                          || ramping_[first + 1]
+                          || ramping_[first + 2]
+                          || ramping_[first + 3]);
+    if (!is_ramping && VectorMath::Equal(previous, value)) {
+      // Most common case: nothing to be done for all these destinations
+      continue;
+    }
+    alignas(16) float previous_v[SampleSize];
+    VectorMath::Store(&previous_v[0], previous);
+    VectorMath::Store(&values_[first], value);
+    const unsigned int last(std::min(first + SampleSize, destinations_count));
+    for (unsigned int destination(first); destination < last; ++destination) {
+      Deliver(destination,
+              previous_v[destination - first],
+              values_[destination],
+              block_size);
+    }
+  }
+}
+
+const float* ModulationMatrix::GetDestinationBlock(
+    const unsigned int destination) const {
+  SOUNDTAILOR_ASSERT(destination < destinations_.size());
+  SOUNDTAILOR_ASSERT(kDestinationAudioRate == rates_[destination]);
+  return &blocks_[destination][0];
+}
+
+float ModulationMatrix::GetDestinationValue(
+    const unsigned int destination) const {
+  SOUNDTAILOR_ASSERT(destination < destinations_.size());
+  return values_[destination];
+}
+
+void ModulationMatrix::Deliver(const unsigned int destination,
+                               const float previous,
+                               const float value,
+                               const std::size_t block_size) {
+  const bool has_changed(previous != value);
+  if (kDestinationAudioRate == rates_[destination]) {
+    if (!has_changed && !ramping_[destination]) {
+      return;
+    }
+    // Ramping from the previous value, a constant "ramp" being required
+    // right after an actual one
+    const float step((value - previous) / static_cast<float>(block_size));
+    const Sample increment(VectorMath::Fill(step * SampleSize));
+    Sample ramp(VectorMath::FillIncremental(previous + step, step));
+    float* SOUNDTAILOR_RESTRICT out(&blocks_[destination][0]);
+    for (std::size_t i(0); i < block_size; i += SampleSize) {
+      VectorMath::Store(out, ramp);
+      ramp = VectorMath::Add(ramp, increment);
+      out += SampleSize;
+    }
+    ramping_[destination] = has_changed;
+  }
+  if (has_changed && destinations_[destination]) {
+    destinations_[destination](value);
+  }
+}
+
+}  // namespace modulators
+}  // namespace soundtailor
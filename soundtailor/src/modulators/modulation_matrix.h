@@ -0,0 +1,137 @@
+/// @file modulation_matrix.h
+/// @brief Modulation matrix, routing modulation sources to parameters
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_MODULATORS_MODULATION_MATRIX_H_
+#define SOUNDTAILOR_SRC_MODULATORS_MODULATION_MATRIX_H_
+
+#include <cstddef>
+// std::function
+#include <functional>
+#include <vector>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Available delivery rates for modulation destinations
+enum DestinationRate {
+  /// Destination set once per block, only if its value changed
+  kDestinationControlRate = 0,
+  /// Per-sample values available, ramping linearly over each block
+  kDestinationAudioRate
+};
+
+/// @brief Modulation matrix: each destination parameter is computed as
+/// its base value plus the sum of all sources scaled by their route amount
+///
+/// Everything is computed once per block:
+/// - all sources are evaluated first, in a single pass
+/// - then all destinations are computed at once, SampleSize destinations
+/// at a time, with a multiply-add per routed source
+/// - finally each destination is pushed only if its value changed
+class ModulationMatrix {
+ public:
+  /// @brief A modulation source, returning its value at the end of a block
+  /// given this block length (e.g. Lfo::ProcessControl())
+  typedef std::function<float(std::size_t)> Source;
+  /// @brief A modulated parameter setter (e.g. Filter::SetParameters())
+  typedef std::function<void(float)> Destination;
+
+  /// @brief Maximum number of sources
+  static const unsigned int kMaxSources = 16;
+  /// @brief Maximum number of destinations
+  static const unsigned int kMaxDestinations = 16;
+
+  /// @param[in]  max_block_size   Longest block to be processed,
+  ///                              required for audio rate destinations
+  explicit ModulationMatrix(const std::size_t max_block_size = 1024);
+
+  /// @brief Register a new source
+  ///
+  /// @return the source index, to be used for routing
+  unsigned int AddSource(const Source& source);
+  /// @brief Register a new destination
+  ///
+  /// @param[in]  destination   Parameter setter, may be empty for audio rate
+  ///                           destinations only read through
+  ///                           GetDestinationBlock()
+  /// @param[in]  base   Parameter value when not modulated
+  /// @param[in]  min   Lowest allowed parameter value
+  /// @param[in]  max   Highest allowed parameter value
+  /// @param[in]  rate   Delivery rate
+  ///
+  /// @return the destination index, to be used for routing
+  unsigned int AddDestination(const Destination& destination,
+                              const float base,
+                              const float min,
+                              const float max,
+                              const DestinationRate rate);
+
+  /// @brief Set the modulation amount from a source to a destination,
+  /// a null amount removing the route
+  void SetRoute(const unsigned int source,
+                const unsigned int destination,
+                const float amount);
+  /// @brief Set the destination value when not modulated
+  void SetBase(const unsigned int destination, const float base);
+
+  /// @brief Evaluate all sources and update all destinations for one block
+  ///
+  /// @param[in]  block_size   Has to be a multiple of SampleSize,
+  ///                          and not greater than max_block_size
+  void Process(const std::size_t block_size);
+
+  /// @brief Per-sample values of an audio rate destination
+  /// for the last processed block
+  const float* GetDestinationBlock(const unsigned int destination) const;
+  /// @brief Value of the destination at the end of the last processed block
+  float GetDestinationValue(const unsigned int destination) const;
+
+ private:
+  /// @brief Number of Samples required to hold all destinations
+  static const unsigned int kMaxGroups = kMaxDestinations / SampleSize;
+
+  /// @brief Push a destination value, given its previous one
+  void Deliver(const unsigned int destination,
+               const float previous,
+               const float value,
+               const std::size_t block_size);
+
+  alignas(16) float amounts_[kMaxSources][kMaxDestinations];  ///< Routes
+  alignas(16) float bases_[kMaxDestinations];
+  alignas(16) float mins_[kMaxDestinations];
+  alignas(16) float maxs_[kMaxDestinations];
+  alignas(16) float values_[kMaxDestinations];  ///< Last pushed values
+  alignas(16) float source_values_[kMaxSources];  ///< Last sources values
+  unsigned int routes_count_[kMaxSources];  ///< Destinations of each source
+  bool ramping_[kMaxDestinations];  ///< True if the last block was a ramp
+  std::vector<Source> sources_;
+  std::vector<Destination> destinations_;
+  std::vector<DestinationRate> rates_;
+  std::vector<std::vector<float> > blocks_;  ///< Audio rate values
+  std::size_t max_block_size_;
+};
+
+}  // namespace modulators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_MODULATORS_MODULATION_MATRIX_H_
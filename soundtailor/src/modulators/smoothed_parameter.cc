@@ -0,0 +1,192 @@
+/// @file smoothed_parameter.cc
+/// @brief Parameter smoothing - implementation
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::max
+#include <algorithm>
+// std::ceil, std::exp, std::fabs, std::pow
+#include <cmath>
+
+#include "soundtailor/src/modulators/smoothed_parameter.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief One pole convergence threshold, relative to the smoothed distance
+/// (e.g. -80dB)
+static const float kConvergence(1e-4f);
+
+SmoothedParameter::SmoothedParameter(const SmoothingType type,
+                                     const float value)
+    : type_(type),
+      time_(0.0f),
+      value_(value),
+      target_(value),
+      step_(0.0f),
+      threshold_(0.0f),
+      remaining_(0),
+      steps_(VectorMath::Fill(0.0f)),
+      smoothing_(false) {
+  SOUNDTAILOR_ASSERT(type != kSmoothingMultiplicative || value > 0.0f);
+}
+
+Sample SmoothedParameter::operator()(void) {
+  // Most common case: nothing to smooth
+  if (!smoothing_) {
+    return VectorMath::Fill(value_);
+  }
+  const Sample kTarget(VectorMath::Fill(target_));
+  if (type_ == kSmoothingOnePole) {
+    const float kDistance(value_ - target_);
+    const Sample out(VectorMath::Add(kTarget,
+                                     VectorMath::MulConst(kDistance, steps_)));
+    const float kNextDistance(kDistance * step_);
+    if (std::fabs(kNextDistance) <= threshold_) {
+      value_ = target_;
+      smoothing_ = false;
+    } else {
+      value_ = target_ + kNextDistance;
+    }
+    return out;
+  }
+  // Ramps: time steps beyond the remaining length are set to the target
+  const Sample kIndices(VectorMath::FillIncremental(1.0f, 1.0f));
+  const Sample kRemaining(VectorMath::Fill(static_cast<float>(remaining_)));
+  const Sample ramp(type_ == kSmoothingLinear
+    ? VectorMath::Add(VectorMath::Fill(value_), steps_)
+    : VectorMath::MulConst(value_, steps_));
+  const Sample out(VectorMath::Add(
+    VectorMath::ExtractValueFromMask(ramp,
+                                     VectorMath::LessThan(kIndices,
+                                                          kRemaining)),
+    VectorMath::ExtractValueFromMask(kTarget,
+                                     VectorMath::LessEqual(kRemaining,
+                                                           kIndices))));
+  if (remaining_ <= SampleSize) {
+    remaining_ = 0;
+    value_ = target_;
+    smoothing_ = false;
+  } else {
+    remaining_ -= SampleSize;
+    value_ = type_ == kSmoothingLinear ? value_ + step_ : value_ * step_;
+  }
+  return out;
+}
+
+void SmoothedParameter::ProcessBlock(BlockOut out,
+                                     const std::size_t block_size) {
+  SOUNDTAILOR_ASSERT(block_size % SampleSize == 0);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  std::size_t i(0);
+  for (; i < block_size && smoothing_; i += SampleSize) {
+    VectorMath::Store(out_write, (*this)());
+    out_write += SampleSize;
+  }
+  // Constant fast path for the remaining of the block
+  const Sample kValue(VectorMath::Fill(value_));
+  for (; i < block_size; i += SampleSize) {
+    VectorMath::Store(out_write, kValue);
+    out_write += SampleSize;
+  }
+}
+
+void SmoothedParameter::SetTarget(const float target) {
+  SOUNDTAILOR_ASSERT(type_ != kSmoothingMultiplicative || target > 0.0f);
+  // Already there or on its way: restarting the ramp would only slow it down
+  if (target == target_) {
+    return;
+  }
+  target_ = target;
+  smoothing_ = true;
+  switch (type_) {
+    case(kSmoothingLinear): {
+      remaining_ = std::max(static_cast<std::size_t>(std::ceil(time_)),
+                            static_cast<std::size_t>(1));
+      const float kIncrement((target_ - value_) / remaining_);
+      steps_ = VectorMath::FillIncremental(kIncrement, kIncrement);
+      step_ = kIncrement * SampleSize;
+      break;
+    }
+    case(kSmoothingMultiplicative): {
+      remaining_ = std::max(static_cast<std::size_t>(std::ceil(time_)),
+                            static_cast<std::size_t>(1));
+      // Computations done in double since precision is crucial here
+      const double kRatio(std::pow(static_cast<double>(target_) / value_,
+                                   1.0 / static_cast<double>(remaining_)));
+      steps_ = VectorMath::Fill(static_cast<float>(kRatio),
+                                static_cast<float>(kRatio * kRatio),
+                                static_cast<float>(kRatio * kRatio * kRatio),
+                                static_cast<float>(std::pow(kRatio, 4.0)));
+      step_ = VectorMath::GetLast(steps_);
+      break;
+    }
+    case(kSmoothingOnePole): {
+      const double kPole(time_ > 0.0f
+        ? std::exp(-1.0 / static_cast<double>(time_))
+        : 0.0);
+      steps_ = VectorMath::Fill(static_cast<float>(kPole),
+                                static_cast<float>(kPole * kPole),
+                                static_cast<float>(kPole * kPole * kPole),
+                                static_cast<float>(std::pow(kPole, 4.0)));
+      step_ = VectorMath::GetLast(steps_);
+      threshold_ = kConvergence * std::fabs(target_ - value_);
+      break;
+    }
+    default: {
+      // Should never happen
+      SOUNDTAILOR_ASSERT(false);
+      break;
+    }
+  }
+}
+
+void SmoothedParameter::SetValue(const float value) {
+  SOUNDTAILOR_ASSERT(type_ != kSmoothingMultiplicative || value > 0.0f);
+  value_ = value;
+  target_ = value;
+  remaining_ = 0;
+  smoothing_ = false;
+}
+
+void SmoothedParameter::SetTime(const float time) {
+  SOUNDTAILOR_ASSERT(time >= 0.0f);
+  time_ = time;
+}
+
+void SmoothedParameter::SetType(const SmoothingType type) {
+  SOUNDTAILOR_ASSERT(type != kSmoothingMultiplicative || value_ > 0.0f);
+  type_ = type;
+  // Restart from the current value
+  SetValue(value_);
+}
+
+float SmoothedParameter::GetValue(void) const {
+  return value_;
+}
+
+float SmoothedParameter::GetTarget(void) const {
+  return target_;
+}
+
+bool SmoothedParameter::IsSmoothing(void) const {
+  return smoothing_;
+}
+
+}  // namespace modulators
+}  // namespace soundtailor
@@ -0,0 +1,107 @@
+/// @file smoothed_parameter.h
+/// @brief Parameter smoothing, generating per-sample ramps
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOUNDTAILOR_SRC_MODULATORS_SMOOTHED_PARAMETER_H_
+#define SOUNDTAILOR_SRC_MODULATORS_SMOOTHED_PARAMETER_H_
+
+#include <cstddef>
+
+#include "soundtailor/src/common.h"
+#include "soundtailor/src/maths.h"
+
+namespace soundtailor {
+namespace modulators {
+
+/// @brief Available smoothing behaviours
+enum SmoothingType {
+  /// Linear ramp toward the target, reached after the smoothing time
+  kSmoothingLinear = 0,
+  /// One pole low pass toward the target, the smoothing time being
+  /// its time constant
+  kSmoothingOnePole,
+  /// Exponential ramp toward the target, reached after the smoothing time:
+  /// constant ratio between successive samples, e.g. linear in octaves
+  /// or decibels. Only for strictly positive values.
+  kSmoothingMultiplicative
+};
+
+/// @brief Parameter value smoothly moving toward its target,
+/// generating per-sample values
+///
+/// All values of a Sample are computed at once from the current value
+/// and precomputed powers (or multiples) of the per-sample step.
+/// Once the target is reached, smoothing stops and all subsequent values
+/// are constant (fast path).
+///
+/// Generator-like: it may be used with soundtailor::ProcessBlock(),
+/// or to feed per-sample automation, see ProcessBlockSmoothedFM() and
+/// ProcessBlockSmoothed().
+class SmoothedParameter {
+ public:
+  explicit SmoothedParameter(const SmoothingType type = kSmoothingLinear,
+                             const float value = 0.0f);
+
+  /// @brief Generate the next SampleSize values
+  Sample operator()(void);
+  /// @brief Generate a whole block
+  ///
+  /// @param[out]  out   Output block, block_size long
+  /// @param[in]  block_size   Has to be a multiple of SampleSize
+  void ProcessBlock(BlockOut out, const std::size_t block_size);
+
+  /// @brief Start smoothing toward the given value
+  ///
+  /// Even with a null smoothing time, the new value is only reached
+  /// at the next generated sample, so that IsSmoothing() reports the change.
+  /// Setting the current target again does nothing, even while smoothing
+  void SetTarget(const float target);
+  /// @brief Immediately jump to the given value, e.g. at initialization
+  void SetValue(const float value);
+  /// @brief Set the smoothing time, in samples
+  ///
+  /// Only applies to subsequent calls to SetTarget()
+  void SetTime(const float time);
+  void SetType(const SmoothingType type);
+
+  /// @brief Value of the last generated sample
+  float GetValue(void) const;
+  float GetTarget(void) const;
+  bool IsSmoothing(void) const;
+
+ private:
+  SmoothingType type_;
+  float time_;
+  float value_;  ///< Value of the last generated sample
+  float target_;
+  /// Step between successive Samples, e.g. over SampleSize time steps:
+  /// increment (linear), ratio (multiplicative) or pole (one pole)
+  float step_;
+  /// One pole convergence threshold, relative to the smoothed distance
+  float threshold_;
+  std::size_t remaining_;  ///< Samples left until the target (ramps)
+  /// Step multiples (linear) or powers (others), from 1 to SampleSize
+  Sample steps_;
+  bool smoothing_;
+};
+
+}  // namespace modulators
+}  // namespace soundtailor
+
+#endif  // SOUNDTAILOR_SRC_MODULATORS_SMOOTHED_PARAMETER_H_
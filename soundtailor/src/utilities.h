@@ -63,6 +63,152 @@ void ProcessBlock(BlockIn in,
   }
 }
 
+/// @brief Block process function for audio rate frequency modulation
+///
+/// Each output sample is generated at its own frequency, read from the
+/// "frequencies" block (normalized, same range as SetFrequency())
+template <typename GeneratorType>
+void ProcessBlockFM(BlockIn frequencies,
+                    BlockOut out,
+                    std::size_t block_size,
+                    GeneratorType&& instance) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(frequencies);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    const Sample kFrequencies(VectorMath::Fill(in_ptr));
+    VectorMath::Store(out_write, instance.ProcessFM(kFrequencies));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+/// @brief Block process function for audio rate phase modulation
+///
+/// Each output sample is phase shifted by its own offset, read from the
+/// "phase_offsets" block (same range as SetPhase(), 2.0 being a full period)
+template <typename GeneratorType>
+void ProcessBlockPM(BlockIn phase_offsets,
+                    BlockOut out,
+                    std::size_t block_size,
+                    GeneratorType&& instance) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(phase_offsets);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    const Sample kOffsets(VectorMath::Fill(in_ptr));
+    VectorMath::Store(out_write, instance.ProcessPM(kOffsets));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+/// @brief Block process function for hard sync masters
+///
+/// Along with the generated signal, outputs for each sample the time elapsed
+/// since the master wrapped, or a negative value if it did not:
+/// see generators::PhaseAccumulator::ProcessSyncMaster()
+template <typename GeneratorType>
+void ProcessBlockSyncMaster(BlockOut out,
+                            BlockOut sync_positions,
+                            std::size_t block_size,
+                            GeneratorType&& instance) {
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  float* SOUNDTAILOR_RESTRICT sync_write(sync_positions);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    Sample sync;
+    VectorMath::Store(out_write, instance.ProcessSyncMaster(&sync));
+    VectorMath::Store(sync_write, sync);
+    out_write += SampleSize;
+    sync_write += SampleSize;
+  }
+}
+
+/// @brief Block process function for hard sync slaves
+///
+/// The generator restarts wherever the master wrapped, as reported by
+/// ProcessBlockSyncMaster()
+template <typename GeneratorType>
+void ProcessBlockSyncSlave(BlockIn sync_positions,
+                           BlockOut out,
+                           std::size_t block_size,
+                           GeneratorType&& instance) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(sync_positions);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  for (std::size_t i(0); i < block_size; i += SampleSize) {
+    const Sample kSync(VectorMath::Fill(in_ptr));
+    VectorMath::Store(out_write, instance.ProcessSyncSlave(kSync));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
+/// @brief Block process function for generators with a smoothed frequency
+///
+/// While the frequency is moving the generator is modulated at audio rate,
+/// see ProcessBlockFM(); once it reaches its target, the generator frequency
+/// is set once and the remaining of the block is generated as usual.
+///
+/// @param[in]  frequency   Smoothed frequency, see
+/// modulators::SmoothedParameter (normalized, same range as SetFrequency())
+template <typename SmootherType, typename GeneratorType>
+void ProcessBlockSmoothedFM(SmootherType&& frequency,
+                            BlockOut out,
+                            std::size_t block_size,
+                            GeneratorType&& instance) {
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  std::size_t i(0);
+  const bool kWasSmoothing(frequency.IsSmoothing());
+  for (; i < block_size && frequency.IsSmoothing(); i += SampleSize) {
+    VectorMath::Store(out_write, instance.ProcessFM(frequency()));
+    out_write += SampleSize;
+  }
+  if (kWasSmoothing && !frequency.IsSmoothing()) {
+    instance.SetFrequency(frequency.GetValue());
+  }
+  for (; i < block_size; i += SampleSize) {
+    VectorMath::Store(out_write, instance());
+    out_write += SampleSize;
+  }
+}
+
+/// @brief Block process function for filters with smoothed parameters
+///
+/// While any parameter is moving, filter parameters are updated
+/// once per Sample (e.g. every SampleSize time steps) with the smoothed
+/// values; once both reach their target, parameters are not touched anymore.
+///
+/// @param[in]  frequency   Smoothed frequency, see
+/// modulators::SmoothedParameter
+/// @param[in]  resonance   Smoothed resonance, same as above
+template <typename FrequencyType, typename ResonanceType, typename FilterType>
+void ProcessBlockSmoothed(BlockIn in,
+                          BlockOut out,
+                          std::size_t block_size,
+                          FrequencyType&& frequency,
+                          ResonanceType&& resonance,
+                          FilterType&& filter_instance) {
+  const float* SOUNDTAILOR_RESTRICT in_ptr(in);
+  float* SOUNDTAILOR_RESTRICT out_write(out);
+  std::size_t i(0);
+  for (;
+       i < block_size && (frequency.IsSmoothing() || resonance.IsSmoothing());
+       i += SampleSize) {
+    // Parameters reached at the end of this Sample
+    const float kFrequency(VectorMath::GetLast(frequency()));
+    const float kResonance(VectorMath::GetLast(resonance()));
+    filter_instance.SetParameters(kFrequency, kResonance);
+    const Sample kInput(VectorMath::Fill(in_ptr));
+    VectorMath::Store(out_write, filter_instance(kInput));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+  for (; i < block_size; i += SampleSize) {
+    const Sample kInput(VectorMath::Fill(in_ptr));
+    VectorMath::Store(out_write, filter_instance(kInput));
+    in_ptr += SampleSize;
+    out_write += SampleSize;
+  }
+}
+
 }  // namespace soundtailor
 
 #endif  // SOUNDTAILOR_SRC_UTILITIES_H_
@@ -21,13 +21,13 @@
 #ifndef SOUNDTAILOR_TESTS_DEBUG_H_
 #define SOUNDTAILOR_TESTS_DEBUG_H_
 
-// offsetof
-#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <string>
 
 #include "soundtailor/src/configuration.h"
 #include "soundtailor/src/maths.h"
+#include "soundtailor/src/io/wave_file.h"
 
 #if _COMPILER_MSVC
 #pragma warning(push)
@@ -92,28 +92,19 @@ class FileWriter {
 /// writer.PushBuffer(&data[1], data.size() - 1);
 /// writer.Close();
 ///
-/// This is clearly not optimized at all nor really clean,
-/// for debugging purpose only!
+/// Thin wrapper around soundtailor::io::WaveFileWriter, writing 16 bits PCM.
 class WaveFileWriter {
-public:
+ public:
   explicit WaveFileWriter(const std::string& filename,
                           uint32_t sample_rate = 96000,
                           uint16_t channels_count = 1)
-      : out_(std::fopen(filename.c_str(), "wb+")),
-        header_({ htonl(0x52494646), // = "RIFF"
-                  0,
-                  htonl(0x57415645), // = "WAVE"
-                  htonl(0x666d7420), // = "fmt "
-                  16,
-                  static_cast<uint16_t>(1),
-                  channels_count,
-                  sample_rate,
-                  sample_rate * channels_count * 2,
-                  static_cast<uint16_t>(channels_count * 2),
-                  16,
-                  htonl(0x64617461), // = "data"
-                  0 }) {
-    std::fwrite(&header_, sizeof(Header), 1, out_);
+      : writer_() {
+    const soundtailor::io::WaveFormat kFormat = {
+      soundtailor::io::kSampleFormatInt16,
+      channels_count,
+      sample_rate
+    };
+    writer_.Open(filename, kFormat);
   }
   ~WaveFileWriter() {
     Close();
@@ -132,80 +123,19 @@ public:
   }
 
   /// @brief Push version for an entire buffer
+  ///
+  /// buffer_count has to be a multiple of the channels count
   void PushBuffer(const float* buffer, const unsigned int buffer_count) {
-    int16_t* out_pcm = new int16_t[buffer_count];
-    SOUNDTAILOR_ASSERT(out_pcm);
-    for (unsigned int i = 0; i < buffer_count; ++i) {
-      int16_t* out(out_pcm + i);
-      const float sample(Math::Clamp(buffer[i], -1.0f, 1.0f) * 32767.0f);
-      const int16_t tmp_short(static_cast<int16_t>(sample));
-      *out = tmp_short;
-    }
-    header_.subchunk2_size_ += buffer_count * header_.block_align_;
-    const unsigned int remainder = sizeof(Header) - offsetof(Header, format_);
-    header_.chunk_size_ = header_.subchunk2_size_ + remainder;
-
-    std::fwrite(out_pcm, sizeof(int16_t), buffer_count, out_);
-    delete[] out_pcm;
+    writer_.Write(buffer, buffer_count / writer_.GetFormat().channels_count);
   }
 
   /// @brief Close writer (automatically done when destroyed)
   void Close(void) {
-    if (out_) {
-      // Fix header chunk sizes
-      std::fseek(out_, offsetof(Header, chunk_size_), SEEK_SET);
-      std::fwrite(&header_.chunk_size_, sizeof(uint32_t), 1, out_);
-
-      std::fseek(out_, offsetof(Header, subchunk2_size_), SEEK_SET);
-      std::fwrite(&header_.subchunk2_size_, sizeof(uint32_t), 1, out_);
-
-      std::fclose(out_);
-      out_ = nullptr;
-    }
-  }
-
-private:
-  static inline bool IsLittleEndian() {
-    union {
-      uint32_t unsigned_32b_;
-      char memory_[4];
-    } MemoryMapping;
-    MemoryMapping.unsigned_32b_ = 0x01234567;
-    return MemoryMapping.memory_[0] == 0x67;
-  }
-
-  /// @brief Equivalent to gcc __bswap_32
-  static inline uint32_t ByteSwap32(uint32_t value) {
-    return ((value << 24) & 0xff000000)
-           | ((value << 8) & 0xff0000)
-           | ((value >> 8) & 0xff00)
-           | ((value >> 24) & 0xff );
+    writer_.Close();
   }
 
-  /// @brief Equivalent of Posix or Winsock2's htonl
-  static inline uint32_t htonl(uint32_t value)
-  {
-    return IsLittleEndian() ? ByteSwap32(value) : value;
-  }
-
-  struct Header {
-    uint32_t chunk_id_;
-    uint32_t chunk_size_;
-    uint32_t format_;
-    uint32_t subchunk1_id_;
-    uint32_t subchunk1_size_;
-    uint16_t audio_format_;
-    uint16_t channels_count_;
-    uint32_t sample_rate_;
-    uint32_t byte_rate_;
-    uint16_t block_align_;
-    uint16_t bits_per_sample_;
-    uint32_t subchunk2_id_;
-    uint32_t subchunk2_size_;
-  };
-
-  std::FILE* out_;
-  Header header_;
+ private:
+  soundtailor::io::WaveFileWriter writer_;
 };
 
 }  // namespace debug
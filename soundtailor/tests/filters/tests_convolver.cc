@@ -0,0 +1,160 @@
+/// @file tests_convolver.cc
+/// @brief SoundTailor FFT and convolution tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/convolver.h"
+#include "soundtailor/src/filters/fft.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::filters::Convolver;
+using soundtailor::filters::RealFft;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(8 * 1024);
+static const unsigned int kBlockSize(64);
+
+/// @brief Random (decaying) impulse response of the given length
+static std::vector<float> MakeImpulse(const unsigned int length) {
+  std::vector<float> impulse(length);
+  WhiteNoise noise;
+  for (unsigned int i(0); i < length; ++i) {
+    impulse[i] = VectorMath::GetFirst(noise())
+                 * std::exp(-4.0f * static_cast<float>(i) / length);
+  }
+  return impulse;
+}
+
+/// @brief Direct convolution, computed in double
+static std::vector<float> Convolve(const std::vector<float>& impulse,
+                                   const std::vector<float>& input) {
+  std::vector<float> output(input.size());
+  for (unsigned int i(0); i < input.size(); ++i) {
+    double sum(0.0);
+    const unsigned int kTaps(std::min(static_cast<unsigned int>(impulse.size()),
+                                      i + 1));
+    for (unsigned int tap(0); tap < kTaps; ++tap) {
+      sum += static_cast<double>(impulse[tap]) * input[i - tap];
+    }
+    output[i] = static_cast<float>(sum);
+  }
+  return output;
+}
+
+/// @brief Check the forward transform against a naive DFT
+TEST(RealFft, MatchesDft) {
+  const unsigned int kSize(256);
+  std::vector<float> input(kSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kSize, noise);
+  std::vector<float> real(kSize / 2 + 1);
+  std::vector<float> imaginary(kSize / 2 + 1);
+  RealFft fft(kSize);
+  fft.Forward(&input[0], &real[0], &imaginary[0]);
+
+  const float kEpsilon(1e-4f * kSize);
+  for (unsigned int k(0); k <= kSize / 2; ++k) {
+    double expected_real(0.0);
+    double expected_imaginary(0.0);
+    for (unsigned int n(0); n < kSize; ++n) {
+      const double kAngle(-2.0 * soundtailor::Pi * k * n / kSize);
+      expected_real += input[n] * std::cos(kAngle);
+      expected_imaginary += input[n] * std::sin(kAngle);
+    }
+    EXPECT_NEAR(expected_real, real[k], kEpsilon);
+    EXPECT_NEAR(expected_imaginary, imaginary[k], kEpsilon);
+  }
+}
+
+/// @brief Check that the inverse transform actually inverts the forward one
+TEST(RealFft, RoundTrip) {
+  WhiteNoise noise;
+  for (unsigned int size(2 * soundtailor::SampleSize); size <= 4096; size *= 2) {
+    std::vector<float> input(size);
+    std::vector<float> output(size);
+    std::vector<float> real(size / 2 + 1);
+    std::vector<float> imaginary(size / 2 + 1);
+    soundtailor::ProcessBlock(&input[0], size, noise);
+    RealFft fft(size);
+    fft.Forward(&input[0], &real[0], &imaginary[0]);
+    fft.Inverse(&real[0], &imaginary[0], &output[0]);
+    for (unsigned int i(0); i < size; ++i) {
+      EXPECT_NEAR(input[i], output[i], 1e-5f);
+    }
+  }
+}
+
+/// @brief Check the convolver against a direct convolution, for both uniform
+/// and non-uniform partitions and all kinds of impulse lengths
+TEST(Convolver, MatchesDirect) {
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> output(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  // The biggest one gets a third stage, its work spread over 64 blocks
+  const unsigned int kImpulseSizes[] = {1, 7, kBlockSize, kBlockSize + 1,
+                                        1000, 5000, 12000};
+  const unsigned int kMaxPartitionSizes[] = {kBlockSize, 4096};
+  for (unsigned int impulse_size : kImpulseSizes) {
+    const std::vector<float> kImpulse(MakeImpulse(impulse_size));
+    const std::vector<float> kExpected(Convolve(kImpulse, input));
+    for (unsigned int max_partition_size : kMaxPartitionSizes) {
+      Convolver convolver(&kImpulse[0],
+                          impulse_size,
+                          kBlockSize,
+                          max_partition_size);
+      // Several blocks at once
+      convolver.ProcessBlock(&input[0], &output[0], kDataTestSetSize);
+      for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+        EXPECT_NEAR(kExpected[i], output[i], 1e-3f);
+      }
+    }
+  }
+}
+
+/// @brief Check that an impulse gets the impulse response out,
+/// without any latency
+TEST(Convolver, ZeroLatency) {
+  const unsigned int kImpulseSize(3000);
+  const std::vector<float> kImpulse(MakeImpulse(kImpulseSize));
+  std::vector<float> input(kDataTestSetSize, 0.0f);
+  std::vector<float> output(kDataTestSetSize);
+  input[0] = 1.0f;
+  Convolver convolver(&kImpulse[0], kImpulseSize, kBlockSize);
+  // Direct form head, then 64 and 512 samples partitions
+  EXPECT_EQ(2u, convolver.GetStagesCount());
+  for (unsigned int i(0); i < kDataTestSetSize; i += kBlockSize) {
+    convolver.ProcessBlock(&input[i], &output[i], kBlockSize);
+  }
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    const float kExpected(i < kImpulseSize ? kImpulse[i] : 0.0f);
+    EXPECT_NEAR(kExpected, output[i], 1e-5f);
+  }
+
+  // Same thing after a reset
+  convolver.Reset();
+  convolver.ProcessBlock(&input[0], &output[0], kDataTestSetSize);
+  for (unsigned int i(0); i < kImpulseSize; ++i) {
+    EXPECT_NEAR(kImpulse[i], output[i], 1e-5f);
+  }
+}
@@ -0,0 +1,164 @@
+/// @file tests_filter_bank.cc
+/// @brief SoundTailor filter bank tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/biquad_designer.h"
+#include "soundtailor/src/filters/filter_bank.h"
+#include "soundtailor/src/filters/sos_cascade.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::filters::BiquadCoefficients;
+using soundtailor::filters::DesignBiquad;
+using soundtailor::filters::FilterBank;
+using soundtailor::filters::SosCascade;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(16 * 1024);
+
+/// @brief Each band has to match a single section filter
+TEST(FilterBank, MatchesSections) {
+  // Not a multiple of SampleSize on purpose
+  const unsigned int kBandsCount(11);
+  const float kLowest(0.005f);
+  const float kHighest(0.4f);
+  const float kResonance(4.0f);
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> bands(kDataTestSetSize * kBandsCount);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  FilterBank bank(kBandsCount);
+  bank.SetBands(kLowest, kHighest, kResonance);
+  EXPECT_EQ(kBandsCount, bank.GetBandsCount());
+  // Two smaller blocks, checking the states continuity
+  const unsigned int kHalf(kDataTestSetSize / 2);
+  std::vector<float> half_bands(kHalf * kBandsCount);
+  for (unsigned int block(0); block < 2; ++block) {
+    bank.ProcessBlock(&input[block * kHalf], &half_bands[0], kHalf);
+    for (unsigned int band(0); band < kBandsCount; ++band) {
+      for (unsigned int i(0); i < kHalf; ++i) {
+        bands[band * kDataTestSetSize + block * kHalf + i]
+          = half_bands[band * kHalf + i];
+      }
+    }
+  }
+
+  std::vector<float> expected(kDataTestSetSize);
+  for (unsigned int band(0); band < kBandsCount; ++band) {
+    const float kFrequency(kLowest * std::pow(kHighest / kLowest,
+                                              band / (kBandsCount - 1.0f)));
+    SosCascade reference(1);
+    reference.SetSection(0, DesignBiquad(soundtailor::filters::kBiquadBandPass,
+                                         kFrequency,
+                                         kResonance));
+    reference.ProcessBlock(&input[0], &expected[0], kDataTestSetSize);
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      EXPECT_NEAR(expected[i], bands[band * kDataTestSetSize + i], 1e-4f);
+    }
+  }
+}
+
+/// @brief Check envelope followers on sines centered on some bands
+TEST(FilterBank, Followers) {
+  const unsigned int kBandsCount(8);
+  const float kLowest(0.01f);
+  const float kHighest(0.2f);
+  const unsigned int kCenterBand(3);
+  const float kFrequency(kLowest * std::pow(kHighest / kLowest,
+                                            kCenterBand / (kBandsCount - 1.0f)));
+  std::vector<float> input(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    input[i] = static_cast<float>(std::sin(2.0 * soundtailor::Pi
+                                           * kFrequency * i));
+  }
+  std::vector<float> bands(kDataTestSetSize * kBandsCount);
+  std::vector<float> envelopes(kDataTestSetSize * kBandsCount);
+
+  const soundtailor::filters::FilterBankFollower kFollowers[] = {
+    soundtailor::filters::kFollowerPeak,
+    soundtailor::filters::kFollowerRms
+  };
+  for (const soundtailor::filters::FilterBankFollower kFollower : kFollowers) {
+    FilterBank bank(kBandsCount);
+    bank.SetBands(kLowest, kHighest, 8.0f);
+    // Fast attack, slow release: close to the peak value
+    // Equal times: close to the mean value
+    if (kFollower == soundtailor::filters::kFollowerPeak) {
+      bank.SetFollower(kFollower, 1.0f, 2000.0f);
+    } else {
+      bank.SetFollower(kFollower, 1000.0f, 1000.0f);
+    }
+    bank.ProcessBlock(&input[0], &bands[0], &envelopes[0], kDataTestSetSize);
+
+    // Steady state value of the centered band
+    const float kExpected(kFollower == soundtailor::filters::kFollowerPeak
+      ? 1.0f
+      : std::sqrt(0.5f));
+    const float kCentered(envelopes[(kCenterBand + 1) * kDataTestSetSize - 1]);
+    EXPECT_NEAR(kExpected, kCentered, 0.05f);
+    // Farther bands are much lower
+    for (unsigned int band(0); band < kBandsCount; ++band) {
+      const float kEnvelope(envelopes[(band + 1) * kDataTestSetSize - 1]);
+      if (band + 1 < kCenterBand || band > kCenterBand + 1) {
+        EXPECT_GT(0.25f * kCentered, kEnvelope);
+      }
+    }
+  }
+}
+
+/// @brief Followers are updated by both processing methods: alternating them
+/// yields the same envelopes as always retrieving them
+TEST(FilterBank, FollowersWithoutOutput) {
+  const unsigned int kBandsCount(8);
+  const unsigned int kBlockSize(256);
+  std::vector<float> input(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+  std::vector<float> bands(kBlockSize * kBandsCount);
+  std::vector<float> expected(kBlockSize * kBandsCount);
+  std::vector<float> actual(kBlockSize * kBandsCount);
+
+  const soundtailor::filters::FilterBankFollower kFollowers[] = {
+    soundtailor::filters::kFollowerPeak,
+    soundtailor::filters::kFollowerRms
+  };
+  for (const soundtailor::filters::FilterBankFollower kFollower : kFollowers) {
+    FilterBank reference(kBandsCount);
+    FilterBank bank(kBandsCount);
+    reference.SetBands(0.01f, 0.2f, 8.0f);
+    bank.SetBands(0.01f, 0.2f, 8.0f);
+    reference.SetFollower(kFollower, 10.0f, 1000.0f);
+    bank.SetFollower(kFollower, 10.0f, 1000.0f);
+    for (unsigned int i(0); i < kDataTestSetSize; i += kBlockSize) {
+      reference.ProcessBlock(&input[i], &bands[0], &expected[0], kBlockSize);
+      if ((i / kBlockSize) % 2 == 0) {
+        bank.ProcessBlock(&input[i], &bands[0], kBlockSize);
+      } else {
+        bank.ProcessBlock(&input[i], &bands[0], &actual[0], kBlockSize);
+        for (unsigned int j(0); j < kBlockSize * kBandsCount; ++j) {
+          EXPECT_EQ(expected[j], actual[j]);
+        }
+      }
+    }
+  }
+}
@@ -30,9 +30,14 @@
 #include "soundtailor/src/filters/moog.h"
 #include "soundtailor/src/filters/moog_lowaliasnonlinear.h"
 #include "soundtailor/src/filters/moog_lowpassblock.h"
+#include "soundtailor/src/filters/moog_musicdsp.h"
+#include "soundtailor/src/filters/moog_musicdsp_var1.h"
+#include "soundtailor/src/filters/moog_musicdsp_var2.h"
+#include "soundtailor/src/filters/moog_musicdsp_varstilson.h"
 #include "soundtailor/src/filters/moog_oversampled.h"
 #include "soundtailor/src/filters/oversampler.h"
 #include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/state_variable.h"
 
 using soundtailor::filters::Chamberlin;
 using soundtailor::filters::ChamberlinOversampled;
@@ -42,9 +47,14 @@ using soundtailor::filters::Gain;
 using soundtailor::filters::Moog;
 using soundtailor::filters::MoogLowAliasNonLinear;
 using soundtailor::filters::MoogLowPassBlock;
+using soundtailor::filters::MoogMusicDSP;
+using soundtailor::filters::MoogMusicDSPVar1;
+using soundtailor::filters::MoogMusicDSPVar2;
+using soundtailor::filters::MoogMusicDSPVarStilson;
 using soundtailor::filters::MoogOversampled;
 using soundtailor::filters::Oversampler;
 using soundtailor::filters::SecondOrderRaw;
+using soundtailor::filters::StateVariable;
 
 /// @brief All tested filter types
 typedef ::testing::Types<Chamberlin,
@@ -55,9 +65,14 @@ typedef ::testing::Types<Chamberlin,
                          Moog,
                          MoogLowAliasNonLinear,
                          MoogLowPassBlock,
+                         MoogMusicDSP,
+                         MoogMusicDSPVar1,
+                         MoogMusicDSPVar2,
+                         MoogMusicDSPVarStilson,
                          MoogOversampled,
                          Oversampler<SecondOrderRaw>,
-                         SecondOrderRaw> FilterTypes;
+                         SecondOrderRaw,
+                         StateVariable> FilterTypes;
 
 /// @brief All filter types supporting passthrough
 // @todo(gm) Chamberlin filter supports passthrough with a one-sample delay!
@@ -70,7 +85,8 @@ typedef ::testing::Types<Chamberlin,
                          Moog,
                          MoogLowPassBlock,
                          Oversampler<SecondOrderRaw>,
-                         SecondOrderRaw> PassthroughFilterTypes;
+                         SecondOrderRaw,
+                         StateVariable> PassthroughFilterTypes;
 
 TYPED_TEST_SUITE(Filter, FilterTypes);
 TYPED_TEST_SUITE(FilterData, FilterTypes);
@@ -93,7 +109,7 @@ TYPED_TEST(Filter, ZeroOutputMean) {
     for (unsigned int i(0);
          i < this->kDataTestSetSize_;
          i += soundtailor::SampleSize) {
-      const Sample input(VectorMath::Fill(this->kNormDistribution_(this->kRandomGenerator_)));
+      const Sample input(this->noise_());
       const Sample filtered(filter(input));
       actual_mean = VectorMath::Add(actual_mean, filtered);
       expected_mean = VectorMath::Add(expected_mean, input);
@@ -115,7 +131,7 @@ TYPED_TEST(Filter, Range) {
   // Very high Epsilon due to this filter implementation
   const float kEpsilon(1e-1f);
   for (unsigned int i(0); i < this->kDataTestSetSize_; i += soundtailor::SampleSize) {
-    const Sample input(VectorMath::Fill(this->kNormDistribution_(this->kRandomGenerator_)));
+    const Sample input(this->noise_());
     const Sample filtered(VectorMath::MulConst(this->kInverseFilterGain_, filter(input)));
     EXPECT_TRUE(VectorMath::GreaterEqual(1.0f, VectorMath::Add(filtered, VectorMath::Fill(-kEpsilon))));
     EXPECT_TRUE(VectorMath::LessEqual(-1.0f, VectorMath::Add(filtered, VectorMath::Fill(kEpsilon))));
@@ -157,7 +173,7 @@ TYPED_TEST(Filter, Perf) {
 
     unsigned int sample_idx(0);
     while (sample_idx < this->kDataTestSetSize_) {
-      const Sample kCurrent(VectorMath::Fill(this->kNormDistribution_(this->kRandomGenerator_)));
+      const Sample kCurrent(this->noise_());
       // No actual test!
       EXPECT_TRUE(VectorMath::LessEqual(-2.0f, filter(kCurrent)));
       sample_idx += soundtailor::SampleSize;
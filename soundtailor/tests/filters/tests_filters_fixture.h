@@ -23,10 +23,8 @@
 
 #include "soundtailor/tests/tests.h"
 
-// std::generate
-#include <algorithm>
-// std::bind
-#include <functional>
+#include "soundtailor/src/generators/white_noise.h"
+
 #include <random>
 
 /// @brief Base tests fixture for all filters
@@ -46,7 +44,7 @@ class Filter : public ::testing::Test {
 #endif  // (_BUILD_CONFIGURATION_DEBUG)
 
     kRandomGenerator_(),
-    kNormDistribution_(-1.0f, 1.0f),
+    noise_(),
     kPassthroughFrequency_(FilterType::Meta().freq_passthrough),
     kPassthroughResonance_(FilterType::Meta().res_passthrough),
     kDelay_(FilterType::Meta().output_delay),
@@ -65,7 +63,8 @@ class Filter : public ::testing::Test {
   const unsigned int kPerfIterations_;
   // @todo(gm) set the seed for deterministic tests across platforms
   std::default_random_engine kRandomGenerator_;
-  std::uniform_real_distribution<float> kNormDistribution_;
+  /// @brief Test input signals generator
+  soundtailor::generators::WhiteNoise noise_;
 
   /// @brief Frequency parameter to be set in order to have a near-passthrough
   const float kPassthroughFrequency_;
@@ -86,9 +85,9 @@ class FilterData : public Filter<FilterType> {
   FilterData()
       : output_data_(this->kDataTestSetSize_),
     input_data_(this->kDataTestSetSize_) {
-    std::generate(input_data_.begin(),
-                  input_data_.end(),
-                  std::bind(this->kNormDistribution_, this->kRandomGenerator_));
+    soundtailor::ProcessBlock(&input_data_[0],
+                              input_data_.size(),
+                              this->noise_);
   }
 
   virtual ~FilterData() {
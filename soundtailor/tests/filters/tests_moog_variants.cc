@@ -0,0 +1,190 @@
+/// @file tests_moog_variants.cc
+/// @brief SoundTailor Moog filter variants comparison
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/moog.h"
+#include "soundtailor/src/filters/moog_lowaliasnonlinear.h"
+#include "soundtailor/src/filters/moog_musicdsp.h"
+#include "soundtailor/src/filters/moog_musicdsp_var1.h"
+#include "soundtailor/src/filters/moog_musicdsp_var2.h"
+#include "soundtailor/src/filters/moog_musicdsp_varstilson.h"
+#include "soundtailor/src/filters/moog_oversampled.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::filters::Moog;
+using soundtailor::filters::MoogLowAliasNonLinear;
+using soundtailor::filters::MoogLowAliasNonLinearParallel;
+using soundtailor::filters::MoogMusicDSP;
+using soundtailor::filters::MoogMusicDSPVar1;
+using soundtailor::filters::MoogMusicDSPVar2;
+using soundtailor::filters::MoogMusicDSPVarStilson;
+using soundtailor::filters::MoogOversampled;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(16 * 1024);
+
+/// @brief Moog variants with their own block processing method
+template <typename FilterType>
+class MoogVariant : public ::testing::Test {
+};
+
+typedef ::testing::Types<MoogMusicDSP,
+                         MoogMusicDSPVar1,
+                         MoogMusicDSPVar2,
+                         MoogMusicDSPVarStilson> MoogVariantTypes;
+
+TYPED_TEST_SUITE(MoogVariant, MoogVariantTypes);
+
+/// @brief Check that the dedicated block method yields the same result
+/// as the per-Sample one
+TYPED_TEST(MoogVariant, ProcessBlock) {
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> output(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  const float kFrequency(0.1f);
+  // Below self-oscillation, which would amplify rounding differences
+  const float kResonance(0.25f * TypeParam::Meta().res_max);
+  TypeParam filter_perblock;
+  TypeParam filter_persample;
+  filter_perblock.SetParameters(kFrequency, kResonance);
+  filter_persample.SetParameters(kFrequency, kResonance);
+  filter_perblock.ProcessBlock(&input[0], &output[0], kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kInput(VectorMath::Fill(&input[i]));
+    const Sample kError(VectorMath::Abs(
+      VectorMath::Sub(VectorMath::Fill(&output[i]),
+                      filter_persample(kInput))));
+    EXPECT_TRUE(VectorMath::GreaterEqual(1e-5f, kError));
+  }
+}
+
+/// @brief Helper for the comparison below: roughly characterize the given
+/// filter sound, by the relative difference between its response to the
+/// input and the (rescaled) response to a much quieter version of it
+template <typename FilterType>
+static double ComputeNonLinearity(const std::vector<float>& input) {
+  const float kFrequency(0.1f);
+  const float kResonance(0.5f * FilterType::Meta().res_max);
+  const float kQuietGain(0.01f);
+  std::vector<float> output(input.size());
+  std::vector<float> quiet_input(input.size());
+  std::vector<float> quiet_output(input.size());
+  for (unsigned int i(0); i < input.size(); ++i) {
+    quiet_input[i] = kQuietGain * input[i];
+  }
+  FilterType loud_filter;
+  FilterType quiet_filter;
+  loud_filter.SetParameters(kFrequency, kResonance);
+  quiet_filter.SetParameters(kFrequency, kResonance);
+  soundtailor::ProcessBlock(&input[0], &output[0], input.size(), loud_filter);
+  soundtailor::ProcessBlock(&quiet_input[0],
+                            &quiet_output[0],
+                            input.size(),
+                            quiet_filter);
+  double power(0.0);
+  double difference_power(0.0);
+  for (unsigned int i(0); i < input.size(); ++i) {
+    const double kQuiet(quiet_output[i] / kQuietGain);
+    power += kQuiet * kQuiet;
+    difference_power += (output[i] - kQuiet) * (output[i] - kQuiet);
+  }
+  return std::sqrt(difference_power / power);
+}
+
+/// @brief Helper for the comparison below: print the given filter
+/// non-linearity, check that it is (or is not) a linear model
+template <typename FilterType>
+static void CheckNonLinearity(const char* name,
+                              const std::vector<float>& input,
+                              const bool linear) {
+  const double kNonLinearity(ComputeNonLinearity<FilterType>(input));
+  std::cerr << name << " non-linearity: " << kNonLinearity << std::endl;
+  if (linear) {
+    EXPECT_GT(1e-5, kNonLinearity);
+  } else {
+    EXPECT_LT(1e-2, kNonLinearity);
+  }
+}
+
+/// @brief Compare the character of all Moog variants
+/// (their CPU cost is compared by the benchmarks)
+TEST(MoogVariants, NonLinearity) {
+  std::vector<float> input(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  CheckNonLinearity<Moog>("Moog", input, true);
+  CheckNonLinearity<MoogLowAliasNonLinear>("MoogLowAliasNonLinear",
+                                           input,
+                                           false);
+  CheckNonLinearity<MoogOversampled>("MoogOversampled", input, false);
+  CheckNonLinearity<MoogMusicDSP>("MoogMusicDSP", input, false);
+  CheckNonLinearity<MoogMusicDSPVar1>("MoogMusicDSPVar1", input, false);
+  CheckNonLinearity<MoogMusicDSPVar2>("MoogMusicDSPVar2", input, true);
+  CheckNonLinearity<MoogMusicDSPVarStilson>("MoogMusicDSPVarStilson",
+                                            input,
+                                            false);
+}
+
+/// @brief Each voice of the parallel filter has to match the serial filter
+TEST(MoogLowAliasNonLinear, Parallel) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(
+    0.01f,
+    MoogLowAliasNonLinear::Meta().freq_max);
+  std::uniform_real_distribution<float> kResDistribution(
+    MoogLowAliasNonLinear::Meta().res_min,
+    0.5f * MoogLowAliasNonLinear::Meta().res_max);
+  const unsigned int kLength(kDataTestSetSize / soundtailor::SampleSize);
+  std::vector<float> frames(kDataTestSetSize);
+  std::vector<float> out(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&frames[0], kDataTestSetSize, noise);
+
+  MoogLowAliasNonLinearParallel filter;
+  std::vector<MoogLowAliasNonLinear> references(soundtailor::SampleSize);
+  for (unsigned int voice(0); voice < soundtailor::SampleSize; ++voice) {
+    const float kFrequency(kFreqDistribution(kRandomGenerator));
+    const float kResonance(kResDistribution(kRandomGenerator));
+    filter.SetParameters(voice, kFrequency, kResonance);
+    references[voice].SetParameters(kFrequency, kResonance);
+  }
+  filter.ProcessBlock(&frames[0], &out[0], kLength);
+
+  for (unsigned int voice(0); voice < soundtailor::SampleSize; ++voice) {
+    std::vector<float> voice_in(kLength);
+    std::vector<float> voice_out(kLength);
+    for (unsigned int i(0); i < kLength; ++i) {
+      voice_in[i] = frames[i * soundtailor::SampleSize + voice];
+    }
+    soundtailor::ProcessBlock(&voice_in[0],
+                              &voice_out[0],
+                              kLength,
+                              references[voice]);
+    for (unsigned int i(0); i < kLength; ++i) {
+      EXPECT_NEAR(voice_out[i], out[i * soundtailor::SampleSize + voice], 1e-5f);
+    }
+  }
+}
@@ -0,0 +1,213 @@
+/// @file tests_saturators.cc
+/// @brief SoundTailor saturators and waveshaper tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/fft.h"
+#include "soundtailor/src/filters/saturators.h"
+#include "soundtailor/src/filters/waveshaper.h"
+
+using soundtailor::filters::Adaa;
+using soundtailor::filters::HardClipShape;
+using soundtailor::filters::RealFft;
+using soundtailor::filters::SoftClipCubicShape;
+using soundtailor::filters::Waveshaper;
+
+static const unsigned int kDataTestSetSize(4096);
+
+/// @brief Check vectorized saturators against their scalar versions
+/// and reference curves, within [-4.0 ; 4.0]
+TEST(Saturators, Curves) {
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kInput(VectorMath::FillIncremental(
+      -4.0f + 8.0f * i / kDataTestSetSize,
+      8.0f / kDataTestSetSize));
+    const Sample kHardClip(soundtailor::filters::HardClip(kInput));
+    const Sample kSoftClip(soundtailor::filters::SoftClipCubic(kInput));
+    const Sample kTanh(soundtailor::filters::TanhRational(kInput));
+    for (unsigned int lane(0); lane < soundtailor::SampleSize; ++lane) {
+      const float kValue(VectorMath::GetByIndex(kInput, lane));
+      EXPECT_EQ(std::min(std::max(kValue, -1.0f), 1.0f),
+                VectorMath::GetByIndex(kHardClip, lane));
+      const float kExpectedSoftClip(std::fabs(kValue) < 1.0f
+        ? kValue - kValue * kValue * kValue / 3.0f
+        : (kValue > 0.0f ? 2.0f : -2.0f) / 3.0f);
+      EXPECT_NEAR(kExpectedSoftClip, VectorMath::GetByIndex(kSoftClip, lane),
+                  1e-6f);
+      EXPECT_NEAR(soundtailor::filters::SoftClipCubic(kValue),
+                  VectorMath::GetByIndex(kSoftClip, lane),
+                  1e-6f);
+      EXPECT_NEAR(std::tanh(kValue), VectorMath::GetByIndex(kTanh, lane),
+                  0.025f);
+      EXPECT_NEAR(soundtailor::filters::TanhRational(kValue),
+                  VectorMath::GetByIndex(kTanh, lane),
+                  1e-6f);
+    }
+  }
+}
+
+/// @brief Check that antiderivatives are actual antiderivatives,
+/// by numerical differentiation
+TEST(Saturators, AntiDerivatives) {
+  const float kStep(1e-2f);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kInput(VectorMath::FillIncremental(
+      -4.0f + 8.0f * i / kDataTestSetSize,
+      8.0f / kDataTestSetSize));
+    const Sample kAbove(VectorMath::Add(kInput, VectorMath::Fill(kStep)));
+    const Sample kBelow(VectorMath::Sub(kInput, VectorMath::Fill(kStep)));
+    const Sample kHardClipDerivative(VectorMath::MulConst(
+      0.5f / kStep,
+      VectorMath::Sub(HardClipShape::AntiDerivative(kAbove),
+                      HardClipShape::AntiDerivative(kBelow))));
+    const Sample kSoftClipDerivative(VectorMath::MulConst(
+      0.5f / kStep,
+      VectorMath::Sub(SoftClipCubicShape::AntiDerivative(kAbove),
+                      SoftClipCubicShape::AntiDerivative(kBelow))));
+    EXPECT_TRUE(VectorMath::IsNear(HardClipShape::Apply(kInput),
+                                   kHardClipDerivative,
+                                   1e-2f));
+    EXPECT_TRUE(VectorMath::IsNear(SoftClipCubicShape::Apply(kInput),
+                                   kSoftClipDerivative,
+                                   1e-3f));
+  }
+}
+
+/// @brief Compute the power of all components not harmonically related
+/// to the given (integer) bin, e.g. aliasing
+static float ComputeAliasingRatio(const std::vector<float>& signal,
+                                  const unsigned int fundamental_bin) {
+  const unsigned int kBins(static_cast<unsigned int>(signal.size()) / 2 + 1);
+  std::vector<float> real(kBins);
+  std::vector<float> imaginary(kBins);
+  RealFft fft(signal.size());
+  fft.Forward(&signal[0], &real[0], &imaginary[0]);
+  double harmonics(0.0);
+  double others(0.0);
+  for (unsigned int bin(1); bin < kBins; ++bin) {
+    const double kPower(real[bin] * real[bin] + imaginary[bin] * imaginary[bin]);
+    if (bin % fundamental_bin == 0) {
+      harmonics += kPower;
+    } else {
+      others += kPower;
+    }
+  }
+  return static_cast<float>(others / harmonics);
+}
+
+/// @brief Check that anti-aliasing actually reduces aliasing
+/// on a heavily driven high frequency sine
+TEST(Waveshaper, AntiAliasing) {
+  // Integer number of periods, so that all harmonics fall on exact bins
+  const unsigned int kFundamentalBin(301);
+  std::vector<float> input(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    input[i] = static_cast<float>(std::sin(2.0 * soundtailor::Pi
+                                           * kFundamentalBin * i
+                                           / kDataTestSetSize));
+  }
+  const soundtailor::filters::WaveshaperShape kShapes[] = {
+    soundtailor::filters::kWaveshaperHardClip,
+    soundtailor::filters::kWaveshaperSoftClipCubic
+  };
+  for (const soundtailor::filters::WaveshaperShape kShape : kShapes) {
+    std::vector<float> naive(kDataTestSetSize);
+    std::vector<float> antialiased(kDataTestSetSize);
+    Waveshaper naive_shaper(kShape);
+    Waveshaper antialiased_shaper(kShape);
+    naive_shaper.SetDrive(8.0f);
+    antialiased_shaper.SetDrive(8.0f);
+    antialiased_shaper.SetAntiAliasing(true);
+    // Twice, so that the second pass starts from a steady state
+    for (unsigned int pass(0); pass < 2; ++pass) {
+      naive_shaper.ProcessBlock(&input[0], &naive[0], kDataTestSetSize);
+      antialiased_shaper.ProcessBlock(&input[0],
+                                      &antialiased[0],
+                                      kDataTestSetSize);
+    }
+    const float kNaiveRatio(ComputeAliasingRatio(naive, kFundamentalBin));
+    const float kAntiAliasedRatio(ComputeAliasingRatio(antialiased,
+                                                       kFundamentalBin));
+    EXPECT_GT(0.5f * kNaiveRatio, kAntiAliasedRatio);
+  }
+}
+
+/// @brief Changing the shape restarts anti-aliasing from a clean state:
+/// back to a previously used shape, the output has to match a fresh instance
+TEST(Waveshaper, SetShape) {
+  std::vector<float> input(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    input[i] = static_cast<float>(std::sin(2.0 * soundtailor::Pi * i / 64.0));
+  }
+  std::vector<float> expected(kDataTestSetSize);
+  std::vector<float> actual(kDataTestSetSize);
+  Waveshaper reference(soundtailor::filters::kWaveshaperHardClip);
+  Waveshaper waveshaper(soundtailor::filters::kWaveshaperHardClip);
+  reference.SetDrive(4.0f);
+  waveshaper.SetDrive(4.0f);
+  reference.SetAntiAliasing(true);
+  waveshaper.SetAntiAliasing(true);
+  waveshaper.ProcessBlock(&input[0], &actual[0], kDataTestSetSize);
+  waveshaper.SetShape(soundtailor::filters::kWaveshaperSoftClipCubic);
+  waveshaper.ProcessBlock(&input[0], &actual[0], kDataTestSetSize);
+  waveshaper.SetShape(soundtailor::filters::kWaveshaperHardClip);
+
+  reference.ProcessBlock(&input[0], &expected[0], kDataTestSetSize);
+  waveshaper.ProcessBlock(&input[0], &actual[0], kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    EXPECT_EQ(expected[i], actual[i]);
+  }
+}
+
+/// @brief Check that anti-aliasing converges toward the plain shape
+/// for slowly varying signals
+TEST(Waveshaper, AntiAliasingLowFrequency) {
+  const float kFrequency(1e-3f);
+  Adaa<SoftClipCubicShape> soft_clip;
+  Adaa<HardClipShape> hard_clip;
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    Sample input;
+    // Half sample delay introduced by antiderivative anti-aliasing
+    Sample delayed;
+    float values[soundtailor::SampleSize];
+    float delayed_values[soundtailor::SampleSize];
+    for (unsigned int lane(0); lane < soundtailor::SampleSize; ++lane) {
+      values[lane] = static_cast<float>(
+        2.0 * std::sin(2.0 * soundtailor::Pi * kFrequency * (i + lane)));
+      delayed_values[lane] = static_cast<float>(
+        2.0 * std::sin(2.0 * soundtailor::Pi * kFrequency * (i + lane - 0.5)));
+    }
+    input = VectorMath::Fill(values[0], values[1], values[2], values[3]);
+    delayed = VectorMath::Fill(delayed_values[0],
+                               delayed_values[1],
+                               delayed_values[2],
+                               delayed_values[3]);
+    const Sample kSoftClip(soft_clip(input));
+    const Sample kHardClip(hard_clip(input));
+    if (i > 0) {
+      EXPECT_TRUE(VectorMath::IsNear(
+        soundtailor::filters::SoftClipCubic(delayed), kSoftClip, 1e-3f));
+      EXPECT_TRUE(VectorMath::IsNear(
+        soundtailor::filters::HardClip(delayed), kHardClip, 1e-2f));
+    }
+  }
+}
@@ -0,0 +1,250 @@
+/// @file tests_sos_cascade.cc
+/// @brief SoundTailor second order sections cascade tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <complex>
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/biquad_designer.h"
+#include "soundtailor/src/filters/sos_cascade.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::filters::BiquadCoefficients;
+using soundtailor::filters::DesignBiquad;
+using soundtailor::filters::SosCascade;
+using soundtailor::filters::SosCascadeParallel;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(16 * 1024);
+
+/// @brief Compute the magnitude response of the given section
+static float ComputeGain(const BiquadCoefficients& coefficients,
+                         const float frequency) {
+  const std::complex<double> kZ(
+    std::polar(1.0, -2.0 * soundtailor::Pi * static_cast<double>(frequency)));
+  const std::complex<double> kNumerator(
+    static_cast<double>(coefficients.b0)
+    + kZ * (static_cast<double>(coefficients.b1)
+            + kZ * static_cast<double>(coefficients.b2)));
+  const std::complex<double> kDenominator(
+    1.0 + kZ * (static_cast<double>(coefficients.a1)
+                + kZ * static_cast<double>(coefficients.a2)));
+  return static_cast<float>(std::abs(kNumerator / kDenominator));
+}
+
+/// @brief Serial, scalar reference implementation
+static void ProcessReference(const std::vector<BiquadCoefficients>& sections,
+                             const std::vector<float>& in,
+                             std::vector<float>* out) {
+  std::vector<float> s1(sections.size(), 0.0f);
+  std::vector<float> s2(sections.size(), 0.0f);
+  for (unsigned int i(0); i < in.size(); ++i) {
+    float current(in[i]);
+    for (unsigned int j(0); j < sections.size(); ++j) {
+      const BiquadCoefficients& kSection(sections[j]);
+      const float kOutput(kSection.b0 * current + s1[j]);
+      s1[j] = kSection.b1 * current - kSection.a1 * kOutput + s2[j];
+      s2[j] = kSection.b2 * current - kSection.a2 * kOutput;
+      current = kOutput;
+    }
+    (*out)[i] = current;
+  }
+}
+
+/// @brief Draw a random, stable section
+static BiquadCoefficients RandomSection(std::default_random_engine* generator) {
+  std::uniform_int_distribution<int> type_distribution(
+    soundtailor::filters::kBiquadLowPass,
+    soundtailor::filters::kBiquadHighShelf);
+  std::uniform_real_distribution<float> frequency_distribution(0.001f, 0.45f);
+  std::uniform_real_distribution<float> resonance_distribution(0.5f, 4.0f);
+  std::uniform_real_distribution<float> gain_distribution(-12.0f, 12.0f);
+  return DesignBiquad(
+    static_cast<soundtailor::filters::BiquadType>(
+      type_distribution(*generator)),
+    frequency_distribution(*generator),
+    resonance_distribution(*generator),
+    gain_distribution(*generator));
+}
+
+/// @brief Check each section type gain at well-known frequencies
+TEST(BiquadDesigner, Response) {
+  const float kFrequency(0.05f);
+  const float kResonance(2.0f);
+  const float kGain(6.0f);
+  // Linear gains corresponding to kGain, and its square root
+  const float kAmplitude(std::pow(10.0f, kGain / 20.0f));
+  const float kHalfAmplitude(std::pow(10.0f, kGain / 40.0f));
+  const float kEpsilon(1e-3f);
+
+  const BiquadCoefficients kLowPass(
+    DesignBiquad(soundtailor::filters::kBiquadLowPass, kFrequency, kResonance));
+  EXPECT_NEAR(1.0f, ComputeGain(kLowPass, 0.0f), kEpsilon);
+  EXPECT_NEAR(kResonance, ComputeGain(kLowPass, kFrequency), kEpsilon);
+  EXPECT_NEAR(0.0f, ComputeGain(kLowPass, 0.5f), kEpsilon);
+
+  const BiquadCoefficients kHighPass(
+    DesignBiquad(soundtailor::filters::kBiquadHighPass, kFrequency, kResonance));
+  EXPECT_NEAR(0.0f, ComputeGain(kHighPass, 0.0f), kEpsilon);
+  EXPECT_NEAR(kResonance, ComputeGain(kHighPass, kFrequency), kEpsilon);
+  EXPECT_NEAR(1.0f, ComputeGain(kHighPass, 0.5f), kEpsilon);
+
+  const BiquadCoefficients kBandPass(
+    DesignBiquad(soundtailor::filters::kBiquadBandPass, kFrequency, kResonance));
+  EXPECT_NEAR(0.0f, ComputeGain(kBandPass, 0.0f), kEpsilon);
+  EXPECT_NEAR(1.0f, ComputeGain(kBandPass, kFrequency), kEpsilon);
+
+  const BiquadCoefficients kNotch(
+    DesignBiquad(soundtailor::filters::kBiquadNotch, kFrequency, kResonance));
+  EXPECT_NEAR(1.0f, ComputeGain(kNotch, 0.0f), kEpsilon);
+  EXPECT_NEAR(0.0f, ComputeGain(kNotch, kFrequency), kEpsilon);
+
+  const BiquadCoefficients kAllPass(
+    DesignBiquad(soundtailor::filters::kBiquadAllPass, kFrequency, kResonance));
+  for (unsigned int i(0); i < 16; ++i) {
+    EXPECT_NEAR(1.0f, ComputeGain(kAllPass, 0.49f * i / 16.0f), kEpsilon);
+  }
+
+  const BiquadCoefficients kPeaking(
+    DesignBiquad(soundtailor::filters::kBiquadPeaking,
+                 kFrequency,
+                 kResonance,
+                 kGain));
+  EXPECT_NEAR(1.0f, ComputeGain(kPeaking, 0.0f), kEpsilon);
+  EXPECT_NEAR(kAmplitude, ComputeGain(kPeaking, kFrequency), kEpsilon);
+
+  const BiquadCoefficients kLowShelf(
+    DesignBiquad(soundtailor::filters::kBiquadLowShelf,
+                 kFrequency,
+                 kResonance,
+                 kGain));
+  EXPECT_NEAR(kAmplitude, ComputeGain(kLowShelf, 0.0f), kEpsilon);
+  EXPECT_NEAR(kHalfAmplitude, ComputeGain(kLowShelf, kFrequency), kEpsilon);
+  EXPECT_NEAR(1.0f, ComputeGain(kLowShelf, 0.5f), kEpsilon);
+
+  const BiquadCoefficients kHighShelf(
+    DesignBiquad(soundtailor::filters::kBiquadHighShelf,
+                 kFrequency,
+                 kResonance,
+                 kGain));
+  EXPECT_NEAR(1.0f, ComputeGain(kHighShelf, 0.0f), kEpsilon);
+  EXPECT_NEAR(kHalfAmplitude, ComputeGain(kHighShelf, kFrequency), kEpsilon);
+  EXPECT_NEAR(kAmplitude, ComputeGain(kHighShelf, 0.5f), kEpsilon);
+}
+
+/// @brief Check that the pipelined cascade matches a serial one,
+/// for all sections counts and several block sizes
+TEST(SosCascade, MatchesReference) {
+  std::default_random_engine generator;
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> expected(kDataTestSetSize);
+  std::vector<float> actual(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  const unsigned int kBlockSizes[] = {4, 64, 1020};
+  for (unsigned int count(1); count <= SosCascade::kMaxSections; ++count) {
+    std::vector<BiquadCoefficients> sections;
+    SosCascade cascade(count);
+    for (unsigned int i(0); i < count; ++i) {
+      sections.push_back(RandomSection(&generator));
+      cascade.SetSection(i, sections.back());
+    }
+    ProcessReference(sections, input, &expected);
+
+    const unsigned int kBlockSize(kBlockSizes[count % 3]);
+    unsigned int i(0);
+    while (i + kBlockSize <= kDataTestSetSize) {
+      cascade.ProcessBlock(&input[i], &actual[i], kBlockSize);
+      i += kBlockSize;
+    }
+    for (unsigned int j(0); j < i; ++j) {
+      EXPECT_NEAR(expected[j], actual[j], 1e-4f * (1.0f + std::fabs(expected[j])));
+    }
+  }
+}
+
+/// @brief Check that both per-sample and per-block methods
+/// yield the same result
+TEST(SosCascade, Process) {
+  std::default_random_engine generator;
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> output(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  const unsigned int kSectionsCount(7);
+  SosCascade cascade_perblock(kSectionsCount);
+  SosCascade cascade_persample(kSectionsCount);
+  for (unsigned int i(0); i < kSectionsCount; ++i) {
+    const BiquadCoefficients kSection(RandomSection(&generator));
+    cascade_perblock.SetSection(i, kSection);
+    cascade_persample.SetSection(i, kSection);
+  }
+  cascade_perblock.ProcessBlock(&input[0], &output[0], kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kInput(VectorMath::Fill(&input[i]));
+    const Sample kReference(VectorMath::Fill(&output[i]));
+    // Not bit-exact: multiply-adds may be fused differently
+    // within pipeline filling, draining and steady state
+    const Sample kError(VectorMath::Abs(
+      VectorMath::Sub(kReference, cascade_persample(kInput))));
+    EXPECT_TRUE(VectorMath::GreaterEqual(1e-5f, kError));
+  }
+}
+
+/// @brief Check that each channel of the parallel cascade
+/// matches its own serial cascade
+TEST(SosCascade, Parallel) {
+  std::default_random_engine generator;
+  const unsigned int kSectionsCount(5);
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> frames(kDataTestSetSize * soundtailor::SampleSize);
+  std::vector<float> frames_out(kDataTestSetSize * soundtailor::SampleSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    for (unsigned int channel(0); channel < soundtailor::SampleSize; ++channel) {
+      frames[i * soundtailor::SampleSize + channel] = input[i];
+    }
+  }
+
+  SosCascadeParallel parallel(kSectionsCount);
+  std::vector<std::vector<BiquadCoefficients> > sections(
+    soundtailor::SampleSize);
+  for (unsigned int channel(0); channel < soundtailor::SampleSize; ++channel) {
+    for (unsigned int i(0); i < kSectionsCount; ++i) {
+      sections[channel].push_back(RandomSection(&generator));
+      parallel.SetSection(channel, i, sections[channel].back());
+    }
+  }
+  parallel.ProcessBlock(&frames[0], &frames_out[0], kDataTestSetSize);
+
+  std::vector<float> expected(kDataTestSetSize);
+  for (unsigned int channel(0); channel < soundtailor::SampleSize; ++channel) {
+    ProcessReference(sections[channel], input, &expected);
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      EXPECT_NEAR(expected[i],
+                  frames_out[i * soundtailor::SampleSize + channel],
+                  1e-4f * (1.0f + std::fabs(expected[i])));
+    }
+  }
+}
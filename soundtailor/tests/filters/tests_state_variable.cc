@@ -0,0 +1,158 @@
+/// @file tests_state_variable.cc
+/// @brief SoundTailor state variable filters tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::filters::StateVariable;
+using soundtailor::filters::StateVariableParallel;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(16 * 1024);
+
+/// @brief Compute the steady state gain of the given filter for a sine input
+static float ComputeSineGain(StateVariable* filter, const float frequency) {
+  std::vector<float> input(kDataTestSetSize);
+  std::vector<float> output(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    input[i] = static_cast<float>(std::sin(2.0 * soundtailor::Pi
+                                           * frequency * i));
+  }
+  filter->ProcessBlock(&input[0], &output[0], kDataTestSetSize);
+  // Skipping the transient part
+  float input_max(0.0f);
+  float output_max(0.0f);
+  for (unsigned int i(kDataTestSetSize / 2); i < kDataTestSetSize; ++i) {
+    input_max = std::max(input_max, std::fabs(input[i]));
+    output_max = std::max(output_max, std::fabs(output[i]));
+  }
+  return output_max / input_max;
+}
+
+/// @brief Check each output gain at well-known frequencies
+TEST(StateVariable, Response) {
+  const float kFrequency(0.05f);
+  const float kResonance(2.0f);
+  const float kEpsilon(2e-2f);
+
+  StateVariable low_pass(soundtailor::filters::kSvfLowPass);
+  low_pass.SetParameters(kFrequency, kResonance);
+  // Frequency is exactly prewarped: gain at cutoff is the quality factor
+  EXPECT_NEAR(kResonance, ComputeSineGain(&low_pass, kFrequency), kEpsilon);
+  EXPECT_NEAR(1.0f, ComputeSineGain(&low_pass, kFrequency / 64.0f), kEpsilon);
+
+  StateVariable band_pass(soundtailor::filters::kSvfBandPass);
+  band_pass.SetParameters(kFrequency, kResonance);
+  EXPECT_NEAR(kResonance, ComputeSineGain(&band_pass, kFrequency), kEpsilon);
+
+  StateVariable high_pass(soundtailor::filters::kSvfHighPass);
+  high_pass.SetParameters(kFrequency, kResonance);
+  EXPECT_NEAR(kResonance, ComputeSineGain(&high_pass, kFrequency), kEpsilon);
+  EXPECT_NEAR(1.0f, ComputeSineGain(&high_pass, 0.45f), kEpsilon);
+
+  StateVariable notch(soundtailor::filters::kSvfNotch);
+  notch.SetParameters(kFrequency, kResonance);
+  EXPECT_NEAR(0.0f, ComputeSineGain(&notch, kFrequency), kEpsilon);
+}
+
+/// @brief Low pass, band pass and high pass outputs have to sum up
+/// to the input signal
+TEST(StateVariable, OutputsSum) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(
+    StateVariable::Meta().freq_min,
+    StateVariable::Meta().freq_max);
+  WhiteNoise noise;
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const float kResonance(0.5f + 10.0f * kNormPosDistribution(kRandomGenerator));
+    StateVariable filter;
+    filter.SetParameters(kFreqDistribution(kRandomGenerator), kResonance);
+    for (unsigned int i(0);
+         i < kDataTestSetSize;
+         i += soundtailor::SampleSize) {
+      const Sample kInput(noise());
+      Sample low_pass;
+      Sample band_pass;
+      Sample high_pass;
+      filter.Process(kInput, &low_pass, &band_pass, &high_pass);
+      const Sample kSum(VectorMath::Add(
+        VectorMath::Add(low_pass, high_pass),
+        VectorMath::MulConst(1.0f / kResonance, band_pass)));
+      EXPECT_TRUE(VectorMath::IsNear(kInput, kSum, 1e-3f));
+    }
+  }
+}
+
+/// @brief Highest frequency and resonance: output has to remain bounded,
+/// where the Chamberlin filter would be unstable
+TEST(StateVariable, Stability) {
+  const float kResonance(StateVariable::Meta().res_max);
+  WhiteNoise noise;
+  StateVariable filter;
+  filter.SetParameters(StateVariable::Meta().freq_max, kResonance);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kFiltered(filter(noise()));
+    EXPECT_TRUE(VectorMath::IsNear(VectorMath::Fill(0.0f),
+                                   kFiltered,
+                                   kResonance));
+  }
+}
+
+/// @brief Each voice of the parallel filter has to match the serial filter
+TEST(StateVariable, Parallel) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(
+    StateVariable::Meta().freq_min,
+    StateVariable::Meta().freq_max);
+  const unsigned int kLength(kDataTestSetSize / soundtailor::SampleSize);
+  std::vector<float> frames(kDataTestSetSize);
+  std::vector<float> out(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&frames[0], kDataTestSetSize, noise);
+
+  StateVariableParallel filter(soundtailor::filters::kSvfHighPass);
+  std::vector<StateVariable> references(
+    soundtailor::SampleSize,
+    StateVariable(soundtailor::filters::kSvfHighPass));
+  for (unsigned int voice(0); voice < soundtailor::SampleSize; ++voice) {
+    const float kFrequency(kFreqDistribution(kRandomGenerator));
+    const float kResonance(0.5f + kNormPosDistribution(kRandomGenerator));
+    filter.SetParameters(voice, kFrequency, kResonance);
+    references[voice].SetParameters(kFrequency, kResonance);
+  }
+  filter.ProcessBlock(&frames[0], &out[0], kLength);
+
+  for (unsigned int voice(0); voice < soundtailor::SampleSize; ++voice) {
+    std::vector<float> voice_in(kLength);
+    std::vector<float> voice_out(kLength);
+    for (unsigned int i(0); i < kLength; ++i) {
+      voice_in[i] = frames[i * soundtailor::SampleSize + voice];
+    }
+    references[voice].ProcessBlock(&voice_in[0], &voice_out[0], kLength);
+    for (unsigned int i(0); i < kLength; ++i) {
+      EXPECT_NEAR(voice_out[i], out[i * soundtailor::SampleSize + voice], 1e-5f);
+    }
+  }
+}
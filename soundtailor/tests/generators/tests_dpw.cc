@@ -0,0 +1,104 @@
+/// @file tests_dpw.cc
+/// @brief SoundTailor higher-order DPW generators tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/generators/dpw.h"
+
+// Using declarations for tested generator
+using soundtailor::generators::DPW;
+using soundtailor::generators::DPWPolynomial;
+
+static const float kSamplingRate(48000.0f);
+/// @brief Long enough for a few periods at the lowest tested frequency
+static const unsigned int kDataTestSetSize(40000);
+
+/// @brief Wrap the given phase into [-1.0 ; 1.0]
+static inline double WrapPhase(const double phase) {
+  double out(phase);
+  while (out > 1.0) {
+    out -= 2.0;
+  }
+  while (out < -1.0) {
+    out += 2.0;
+  }
+  return out;
+}
+
+/// @brief Double precision reference: plain (Order - 1)th backward
+/// difference of the DPW polynomial,
+/// normalized by Order! * increment^(Order - 1)
+///
+/// The generator is only given for the order to be deduced
+template <unsigned int Order>
+static double ComputeReference(const DPW<Order>& /*generator*/,
+                               const double phase,
+                               const double increment) {
+  double out(0.0);
+  double coefficient(1.0);
+  double normalization(1.0);
+  for (unsigned int k(0); k < Order; ++k) {
+    out += coefficient
+           * DPWPolynomial<Order>::Compute(WrapPhase(phase - k * increment));
+    // Next signed binomial coefficient
+    coefficient *= -static_cast<double>(Order - 1 - k) / (k + 1);
+    normalization *= k + 1;
+    if (k + 1 < Order) {
+      normalization *= increment;
+    }
+  }
+  return out / normalization;
+}
+
+template <typename GeneratorType>
+class DPWLowFrequency : public ::testing::Test {
+};
+
+typedef ::testing::Types<DPW<3>, DPW<4> > DPWTypes;
+
+TYPED_TEST_SUITE(DPWLowFrequency, DPWTypes);
+
+/// @brief Generates a signal at a few Hz, where differentiations
+/// in single precision would be meaningless: check for normalized range
+/// and compare against the double precision reference
+TYPED_TEST(DPWLowFrequency, Reference) {
+  const float kFrequencies[] = {3.0f, 7.0f};
+  const float kPhase(-0.3f);
+  std::vector<float> output(kDataTestSetSize);
+  for (const float kFrequencyHz : kFrequencies) {
+    const float kFrequency(kFrequencyHz / kSamplingRate);
+    TypeParam generator(kPhase);
+    generator.SetFrequency(kFrequency);
+    soundtailor::ProcessBlock(&output[0], kDataTestSetSize, generator);
+
+    const double kIncrement(2.0 * static_cast<double>(kFrequency));
+    const float kEpsilon(1e-4f);
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      const double kCurrentPhase(WrapPhase(kPhase + i * kIncrement));
+      const double kExpected(ComputeReference(generator,
+                                              kCurrentPhase,
+                                              kIncrement));
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(output[i]));
+      EXPECT_NEAR(kExpected, output[i], kEpsilon);
+    }
+  }
+}
@@ -20,12 +20,14 @@
 
 #include "soundtailor/tests/generators/tests_generators_fixture.h"
 
+#include "soundtailor/src/generators/dpw.h"
 #include "soundtailor/src/generators/generators_common.h"
 #include "soundtailor/src/generators/sawtooth_blit.h"
 #include "soundtailor/src/generators/sawtooth_dpw.h"
 #include "soundtailor/src/generators/square_blit.h"
 #include "soundtailor/src/generators/triangle_dpw.h"
 
+using soundtailor::generators::DPW;
 using soundtailor::generators::PhaseAccumulator;
 using soundtailor::generators::SawtoothBLIT;
 using soundtailor::generators::SawtoothDPW;
@@ -34,6 +36,8 @@ using soundtailor::generators::TriangleDPW;
 
 /// @brief All tested types
 typedef ::testing::Types<
+    DPW<3>,
+    DPW<4>,
     PhaseAccumulator,
     SawtoothBLIT,
     SawtoothDPW,
@@ -264,6 +268,149 @@ TYPED_TEST(GeneratorData, Process) {
   }
 }
 
+/// @brief Check that audio rate frequency modulation with a constant
+/// frequency yields the same signal as the unmodulated generator
+TYPED_TEST(GeneratorData, ProcessFMConstant) {
+  const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+
+  TypeParam generator_reference;
+  TypeParam generator_modulated;
+  generator_reference.SetFrequency(kFrequency);
+  generator_modulated.SetFrequency(kFrequency);
+
+  const std::vector<float> kFrequencies(this->kDataTestSetSize_, kFrequency);
+  std::vector<float> modulated(this->kDataTestSetSize_);
+  soundtailor::ProcessBlock(&this->output_data_[0],
+                            this->output_data_.size(),
+                            generator_reference);
+  soundtailor::ProcessBlockFM(&kFrequencies[0],
+                              &modulated[0],
+                              modulated.size(),
+                              generator_modulated);
+  // Phases are not accumulated the same way, hence a slight drift which may
+  // move a discontinuity by one sample: only the mean error is checked
+  float error(0.0f);
+  for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+    error += std::fabs(this->output_data_[i] - modulated[i]);
+  }
+  const float kEpsilon(1e-3f);
+  EXPECT_GT(kEpsilon, error / this->kDataTestSetSize_);
+}
+
+/// @brief Check that audio rate phase modulation with null offsets
+/// yields the same signal as the unmodulated generator
+TYPED_TEST(GeneratorData, ProcessPMZero) {
+  const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+
+  TypeParam generator_reference;
+  TypeParam generator_modulated;
+  generator_reference.SetFrequency(kFrequency);
+  generator_modulated.SetFrequency(kFrequency);
+
+  const std::vector<float> kOffsets(this->kDataTestSetSize_, 0.0f);
+  std::vector<float> modulated(this->kDataTestSetSize_);
+  soundtailor::ProcessBlock(&this->output_data_[0],
+                            this->output_data_.size(),
+                            generator_reference);
+  soundtailor::ProcessBlockPM(&kOffsets[0],
+                              &modulated[0],
+                              modulated.size(),
+                              generator_modulated);
+  // Normalization factors are not computed the same way
+  const float kEpsilon(1e-4f);
+  for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+    EXPECT_NEAR(this->output_data_[i], modulated[i], kEpsilon);
+  }
+}
+
+/// @brief Generates a frequency modulated signal (vibrato),
+/// check for normalized range (within [-1.0f ; 1.0f])
+TYPED_TEST(GeneratorData, RangeFM) {
+  for (unsigned int iterations(0); iterations < this->kTestIterations_; ++iterations) {
+    IGNORE(iterations);
+
+    const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+    TypeParam generator;
+    generator.SetFrequency(kFrequency);
+
+    // Half an octave deep, 5Hz vibrato
+    std::vector<float> frequencies(this->kDataTestSetSize_);
+    for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+      const double kModulator(std::sin(2.0 * soundtailor::Pi * 5.0 * i
+                                       / this->kSamplingRate_));
+      frequencies[i] = kFrequency
+                       * static_cast<float>(std::pow(2.0, 0.5 * kModulator));
+    }
+    soundtailor::ProcessBlockFM(&frequencies[0],
+                                &this->output_data_[0],
+                                this->output_data_.size(),
+                                generator);
+    // Small epsilon for DPW overshoots
+    const float kEpsilon(5e-2f);
+    for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(this->output_data_[i]));
+    }
+  }
+}
+
+/// @brief Generates a signal with a frequency randomly stepping at each
+/// sample, check for normalized range (within [-1.0f ; 1.0f])
+TYPED_TEST(GeneratorData, RangeStepFM) {
+  std::vector<float> frequencies(this->kDataTestSetSize_);
+  for (unsigned int iterations(0); iterations < this->kTestIterations_; ++iterations) {
+    IGNORE(iterations);
+
+    TypeParam generator;
+    generator.SetFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+    // Steps held for a random count of samples, from 1 to 8
+    std::uniform_int_distribution<unsigned int> kLengthDistribution(1, 8);
+    unsigned int i(0);
+    while (i < this->kDataTestSetSize_) {
+      const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+      const unsigned int kEnd(std::min(
+          i + kLengthDistribution(this->kRandomGenerator_),
+          this->kDataTestSetSize_));
+      for (; i < kEnd; ++i) {
+        frequencies[i] = kFrequency;
+      }
+    }
+    soundtailor::ProcessBlockFM(&frequencies[0],
+                                &this->output_data_[0],
+                                this->output_data_.size(),
+                                generator);
+    // Small epsilon for DPW overshoots
+    const float kEpsilon(5e-2f);
+    for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(this->output_data_[i]));
+    }
+  }
+}
+
+/// @brief Generates a signal with a frequency stepping to zero
+/// and near-zero values, check for normalized range
+TYPED_TEST(GeneratorData, RangeNearZeroFM) {
+  const float kFrequencies[] = {0.0f, 1e-9f, 1e-6f, this->kMaxFundamentalNorm_};
+  const unsigned int kFrequenciesCount(sizeof(kFrequencies)
+                                       / sizeof(kFrequencies[0]));
+  std::uniform_int_distribution<unsigned int> kIndexDistribution(
+      0,
+      kFrequenciesCount - 1);
+  std::vector<float> frequencies(this->kDataTestSetSize_);
+  for (float& frequency : frequencies) {
+    frequency = kFrequencies[kIndexDistribution(this->kRandomGenerator_)];
+  }
+  TypeParam generator;
+  generator.SetFrequency(this->kMaxFundamentalNorm_);
+  soundtailor::ProcessBlockFM(&frequencies[0],
+                              &this->output_data_[0],
+                              this->output_data_.size(),
+                              generator);
+  const float kEpsilon(5e-2f);
+  for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+    EXPECT_GE(1.0f + kEpsilon, std::fabs(this->output_data_[i]));
+  }
+}
+
 /// @brief Generates a signal (performance tests)
 TYPED_TEST(Generator, Perf) {
   for (unsigned int iterations(0); iterations < this->kPerfIterations_; ++iterations) {
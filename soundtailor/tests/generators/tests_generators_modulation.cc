@@ -0,0 +1,120 @@
+/// @file tests_generators_modulation.cc
+/// @brief SoundTailor generators audio rate modulation tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/utilities.h"
+#include "soundtailor/src/generators/generators_common.h"
+
+// Using declarations for tested generators
+using soundtailor::generators::PhaseAccumulator;
+
+static const unsigned int kDataTestSetSize(32768);
+static const float kSamplingRate(96000.0f);
+/// @brief Arbitrary lowest allowed fundamental
+static const float kMinFundamentalNorm(10.0f / kSamplingRate);
+/// @brief Arbitrary highest allowed fundamental
+static const float kMaxFundamentalNorm(2000.0f / kSamplingRate);
+
+/// @brief Wrap the given phase difference into [-1.0 ; 1.0]
+static inline float WrapPhase(const float phase) {
+  float out(phase);
+  while (out > 1.0f) {
+    out -= 2.0f;
+  }
+  while (out < -1.0f) {
+    out += 2.0f;
+  }
+  return out;
+}
+
+/// @brief Generates a phase with random per-sample frequencies,
+/// check that each phase step matches its own frequency
+TEST(GeneratorsModulation, PhaseAccumulatorFM) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(0.0f, 0.5f);
+  std::vector<float> frequencies(kDataTestSetSize);
+  for (float& frequency : frequencies) {
+    frequency = kFreqDistribution(kRandomGenerator);
+  }
+  std::vector<float> phases(kDataTestSetSize);
+  PhaseAccumulator generator;
+  soundtailor::ProcessBlockFM(&frequencies[0],
+                              &phases[0],
+                              kDataTestSetSize,
+                              generator);
+
+  const float kEpsilon(1e-4f);
+  for (unsigned int i(1); i < kDataTestSetSize; ++i) {
+    EXPECT_GE(1.0f, std::fabs(phases[i]));
+    const float kExpected(2.0f * frequencies[i - 1]);
+    const float kActual(WrapPhase(phases[i] - phases[i - 1]));
+    // Unwrapped steps of exactly 1.0 may be wrapped either way
+    EXPECT_NEAR(kExpected, std::fabs(kActual), kEpsilon);
+  }
+}
+
+/// @brief Check that modulated and unmodulated calls may be interleaved
+/// without any phase discontinuity
+TEST(GeneratorsModulation, PhaseAccumulatorInterleaved) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(kMinFundamentalNorm,
+                                                          kMaxFundamentalNorm);
+  const float kFrequency(kFreqDistribution(kRandomGenerator));
+  PhaseAccumulator generator;
+  generator.SetFrequency(kFrequency);
+  const Sample kFrequencies(VectorMath::Fill(kFrequency));
+
+  float last(VectorMath::GetLast(generator()));
+  const float kEpsilon(1e-5f);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample current(i % 3 ? generator() : generator.ProcessFM(kFrequencies));
+    const float kActual(WrapPhase(VectorMath::GetFirst(current) - last));
+    EXPECT_NEAR(2.0f * kFrequency, kActual, kEpsilon);
+    last = VectorMath::GetLast(current);
+  }
+}
+
+/// @brief Check that a constant phase offset is equivalent to a phase shift
+TEST(GeneratorsModulation, PhaseAccumulatorPM) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(kMinFundamentalNorm,
+                                                          kMaxFundamentalNorm);
+  const float kFrequency(kFreqDistribution(kRandomGenerator));
+  const float kOffset(kNormDistribution(kRandomGenerator));
+  PhaseAccumulator generator;
+  PhaseAccumulator reference(kOffset);
+  generator.SetFrequency(kFrequency);
+  reference.SetFrequency(kFrequency);
+
+  const float kEpsilon(1e-4f);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kActual(generator.ProcessPM(VectorMath::Fill(kOffset)));
+    const Sample kExpected(reference());
+    for (unsigned int lane(0); lane < soundtailor::SampleSize; ++lane) {
+      EXPECT_NEAR(0.0f,
+                  WrapPhase(VectorMath::GetByIndex(kActual, lane)
+                            - VectorMath::GetByIndex(kExpected, lane)),
+                  kEpsilon);
+    }
+  }
+}
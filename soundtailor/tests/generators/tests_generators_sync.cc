@@ -0,0 +1,255 @@
+/// @file tests_generators_sync.cc
+/// @brief SoundTailor generators hard sync tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::is_same
+#include <type_traits>
+#include <vector>
+
+#include "soundtailor/tests/generators/tests_generators_fixture.h"
+
+#include "soundtailor/src/utilities.h"
+#include "soundtailor/src/generators/generators_common.h"
+#include "soundtailor/src/generators/sawtooth_blit.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/square_blit.h"
+#include "soundtailor/src/generators/triangle_dpw.h"
+
+// Using declarations for tested generators
+using soundtailor::generators::PhaseAccumulator;
+using soundtailor::generators::SawtoothBLIT;
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::generators::SquareBLIT;
+using soundtailor::generators::TriangleDPW;
+
+/// @brief All tested slave types
+typedef ::testing::Types<
+    SawtoothBLIT,
+    SawtoothDPW,
+    SquareBLIT,
+    TriangleDPW> SlaveTypes;
+
+/// @brief DPW slave types
+typedef ::testing::Types<
+    SawtoothDPW,
+    TriangleDPW> SlaveDPWTypes;
+
+template <typename GeneratorType>
+class SyncSlave : public GeneratorData<GeneratorType> {
+};
+
+template <typename GeneratorType>
+class SyncSlaveDPW : public GeneratorData<GeneratorType> {
+};
+
+TYPED_TEST_SUITE(SyncSlave, SlaveTypes);
+TYPED_TEST_SUITE(SyncSlaveDPW, SlaveDPWTypes);
+
+/// @brief Check reported wrap positions against the generated phase
+TEST(GeneratorsSync, MasterPositions) {
+  std::default_random_engine kRandomGenerator;
+  // PhaseAccumulator initial lanes are not wrapped, hence the frequency limit
+  std::uniform_real_distribution<float> kFreqDistribution(0.001f, 0.1f);
+  const unsigned int kDataTestSetSize(32768);
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const float kFrequency(kFreqDistribution(kRandomGenerator));
+    const float kIncrement(2.0f * kFrequency);
+    PhaseAccumulator master;
+    master.SetFrequency(kFrequency);
+    std::vector<float> phases(kDataTestSetSize);
+    std::vector<float> sync_positions(kDataTestSetSize);
+    soundtailor::ProcessBlockSyncMaster(&phases[0],
+                                        &sync_positions[0],
+                                        kDataTestSetSize,
+                                        master);
+    const float kEpsilon(1e-3f);
+    for (unsigned int i(1); i < kDataTestSetSize; ++i) {
+      if (phases[i] < phases[i - 1]) {
+        EXPECT_LE(0.0f, sync_positions[i]);
+        EXPECT_GT(1.0f, sync_positions[i]);
+        // The phase is back at -1.0 at the reported position
+        EXPECT_NEAR(-1.0f,
+                    phases[i] - sync_positions[i] * kIncrement,
+                    kEpsilon);
+      } else {
+        EXPECT_GT(0.0f, sync_positions[i]);
+      }
+    }
+  }
+}
+
+/// @brief Check that the slave phase restarts exactly
+/// at the positions reported by the master
+TEST(GeneratorsSync, SlavePhase) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(0.001f, 0.1f);
+  const unsigned int kDataTestSetSize(32768);
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const float kMasterFrequency(kFreqDistribution(kRandomGenerator));
+    const float kSlaveFrequency(kFreqDistribution(kRandomGenerator));
+    const float kSlaveIncrement(2.0f * kSlaveFrequency);
+    PhaseAccumulator master;
+    PhaseAccumulator slave;
+    master.SetFrequency(kMasterFrequency);
+    slave.SetFrequency(kSlaveFrequency);
+
+    // Phase of the time step before the first one
+    float last(-kSlaveIncrement);
+    const float kEpsilon(1e-4f);
+    for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+      Sample sync;
+      master.ProcessSyncMaster(&sync);
+      Sample reset_from;
+      const Sample kPhases(slave.ProcessSyncSlave(sync, -1.0f, &reset_from));
+      for (unsigned int lane(0); lane < soundtailor::SampleSize; ++lane) {
+        const float kPosition(VectorMath::GetByIndex(sync, lane));
+        const float kPhase(VectorMath::GetByIndex(kPhases, lane));
+        if (kPosition >= 0.0f) {
+          EXPECT_NEAR(-1.0f + kPosition * kSlaveIncrement, kPhase, kEpsilon);
+        } else {
+          float expected(last + kSlaveIncrement);
+          if (expected > 1.0f) {
+            expected -= 2.0f;
+          }
+          EXPECT_NEAR(expected, kPhase, kEpsilon);
+        }
+        last = kPhase;
+      }
+    }
+  }
+}
+
+/// @brief Without any sync, slaves output the same signal
+/// as their free running counterparts
+TYPED_TEST(SyncSlave, NoSync) {
+  const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+  TypeParam reference;
+  TypeParam slave;
+  reference.SetFrequency(kFrequency);
+  slave.SetFrequency(kFrequency);
+  soundtailor::ProcessBlock(&this->output_data_[0],
+                            this->output_data_.size(),
+                            reference);
+  const std::vector<float> kNoSync(this->kDataTestSetSize_, -1.0f);
+  std::vector<float> synced(this->kDataTestSetSize_);
+  soundtailor::ProcessBlockSyncSlave(&kNoSync[0],
+                                     &synced[0],
+                                     synced.size(),
+                                     slave);
+  for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+    EXPECT_EQ(this->output_data_[i], synced[i]);
+  }
+}
+
+/// @brief Synced slaves stay within the normalized range
+TYPED_TEST(SyncSlave, Range) {
+  for (unsigned int iterations(0); iterations < this->kTestIterations_; ++iterations) {
+    IGNORE(iterations);
+    const float kMasterFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+    // Slave frequency from 1 to 4 times the master one
+    const float kSlaveFrequency(kMasterFrequency
+                                * (1.0f + 3.0f * kNormPosDistribution(this->kRandomGenerator_)));
+    PhaseAccumulator master;
+    TypeParam slave;
+    master.SetFrequency(kMasterFrequency);
+    slave.SetFrequency(kSlaveFrequency);
+    std::vector<float> master_out(this->kDataTestSetSize_);
+    std::vector<float> sync_positions(this->kDataTestSetSize_);
+    soundtailor::ProcessBlockSyncMaster(&master_out[0],
+                                        &sync_positions[0],
+                                        this->kDataTestSetSize_,
+                                        master);
+    soundtailor::ProcessBlockSyncSlave(&sync_positions[0],
+                                       &this->output_data_[0],
+                                       this->kDataTestSetSize_,
+                                       slave);
+    // Epsilon for band-limited overshoots
+    const float kEpsilon(1e-1f);
+    const float kMax(std::is_same<TypeParam, SquareBLIT>::value ? 2.0f : 1.0f);
+    for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+      EXPECT_GE(kMax + kEpsilon, std::fabs(this->output_data_[i]));
+    }
+  }
+}
+
+// @todo(gm) get rid of that when using generator policies
+template<class GeneratorType>
+float GetInternalPhase(void) {
+  return 0.0f;
+}
+template<>
+float GetInternalPhase<TriangleDPW>(void)  {
+  return 0.5f;
+}
+
+/// @brief A DPW slave synced by a master running at the same frequency,
+/// and wrapping at the same time, outputs its free running signal
+TYPED_TEST(SyncSlaveDPW, SameFrequency) {
+  const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+  PhaseAccumulator master(GetInternalPhase<TypeParam>());
+  TypeParam reference;
+  TypeParam slave;
+  master.SetFrequency(kFrequency);
+  reference.SetFrequency(kFrequency);
+  slave.SetFrequency(kFrequency);
+  soundtailor::ProcessBlock(&this->output_data_[0],
+                            this->output_data_.size(),
+                            reference);
+  std::vector<float> master_out(this->kDataTestSetSize_);
+  std::vector<float> sync_positions(this->kDataTestSetSize_);
+  std::vector<float> synced(this->kDataTestSetSize_);
+  soundtailor::ProcessBlockSyncMaster(&master_out[0],
+                                      &sync_positions[0],
+                                      this->kDataTestSetSize_,
+                                      master);
+  soundtailor::ProcessBlockSyncSlave(&sync_positions[0],
+                                     &synced[0],
+                                     this->kDataTestSetSize_,
+                                     slave);
+  // Resets are exactly compensated by the phase reached before them
+  const float kEpsilon(1e-2f);
+  for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+    EXPECT_NEAR(this->output_data_[i], synced[i], kEpsilon);
+  }
+}
+
+/// @brief Generates a synced signal (performance tests)
+TYPED_TEST(SyncSlave, Perf) {
+  for (unsigned int iterations(0); iterations < this->kPerfIterations_; ++iterations) {
+    IGNORE(iterations);
+
+    const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+    SawtoothDPW master;
+    TypeParam slave;
+    master.SetFrequency(kFrequency);
+    slave.SetFrequency(2.5f * kFrequency);
+
+    unsigned int sample_idx(0);
+    while (sample_idx < this->kDataTestSetSize_) {
+      Sample sync;
+      master.ProcessSyncMaster(&sync);
+      const Sample kCurrent(slave.ProcessSyncSlave(sync));
+      sample_idx += soundtailor::SampleSize;
+      // No actual test!
+      EXPECT_TRUE(VectorMath::LessEqual(-3.0f, kCurrent));
+    }
+  }
+}
@@ -0,0 +1,130 @@
+/// @file tests_noise.cc
+/// @brief SoundTailor noise generators tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/generators/pink_noise.h"
+#include "soundtailor/src/generators/sample_and_hold_noise.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+// Using declarations for tested generators
+using soundtailor::generators::PinkNoise;
+using soundtailor::generators::SampleAndHoldNoise;
+using soundtailor::generators::WhiteNoise;
+
+static const unsigned int kDataTestSetSize(32768);
+
+/// @brief Compute the ratio between the power of the signal derivative
+/// and the one of the signal: 2.0 for a white noise, lower if low-passed
+static float ComputeDerivativeRatio(const std::vector<float>& data) {
+  double power(0.0);
+  double derivative_power(0.0);
+  for (unsigned int i(1); i < data.size(); ++i) {
+    const double kDiff(data[i] - data[i - 1]);
+    power += data[i] * data[i];
+    derivative_power += kDiff * kDiff;
+  }
+  return static_cast<float>(derivative_power / power);
+}
+
+/// @brief Check white noise range, mean, power and spectral flatness
+TEST(Noise, WhiteStatistics) {
+  WhiteNoise generator;
+  std::vector<float> data(kDataTestSetSize);
+  soundtailor::ProcessBlock(&data[0], kDataTestSetSize, generator);
+  double mean(0.0);
+  double power(0.0);
+  for (const float value : data) {
+    EXPECT_LE(-1.0f, value);
+    EXPECT_GT(1.0f, value);
+    mean += value;
+    power += value * value;
+  }
+  EXPECT_NEAR(0.0, mean / kDataTestSetSize, 1e-2);
+  EXPECT_NEAR(1.0 / 3.0, power / kDataTestSetSize, 1e-2);
+  EXPECT_NEAR(2.0f, ComputeDerivativeRatio(data), 5e-2f);
+}
+
+/// @brief Check that identical seeds yield identical sequences,
+/// and different ones different sequences
+TEST(Noise, WhiteSeed) {
+  const unsigned int kSeed(12345);
+  WhiteNoise generator(kSeed);
+  WhiteNoise same(kSeed);
+  WhiteNoise other(kSeed + 1);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    const Sample kValue(generator());
+    EXPECT_TRUE(VectorMath::Equal(kValue, same()));
+    EXPECT_FALSE(VectorMath::Equal(kValue, other()));
+  }
+  // Restarting from the seed
+  generator.SetSeed(kSeed);
+  same.SetSeed(kSeed);
+  EXPECT_TRUE(VectorMath::Equal(generator(), same()));
+}
+
+/// @brief Check pink noise range and mean, and that it is low-passed
+TEST(Noise, PinkStatistics) {
+  PinkNoise generator;
+  std::vector<float> data(kDataTestSetSize);
+  soundtailor::ProcessBlock(&data[0], kDataTestSetSize, generator);
+  double mean(0.0);
+  for (const float value : data) {
+    EXPECT_GE(1.0f, std::fabs(value));
+    mean += value;
+  }
+  EXPECT_NEAR(0.0, mean / kDataTestSetSize, 5e-2);
+  EXPECT_GT(0.5f, ComputeDerivativeRatio(data));
+}
+
+/// @brief Check that identical seeds yield identical pink noise sequences
+TEST(Noise, PinkSeed) {
+  PinkNoise generator(42);
+  PinkNoise same(42);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    EXPECT_TRUE(VectorMath::Equal(generator(), same()));
+  }
+}
+
+/// @brief Check that sample and hold values are changed at the expected rate
+TEST(Noise, SampleAndHoldRate) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(1e-3f, 1e-1f);
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const float kFrequency(kFreqDistribution(kRandomGenerator));
+    SampleAndHoldNoise generator(iterations);
+    generator.SetFrequency(kFrequency);
+    std::vector<float> data(kDataTestSetSize);
+    soundtailor::ProcessBlock(&data[0], kDataTestSetSize, generator);
+    unsigned int changes(0);
+    for (unsigned int i(1); i < kDataTestSetSize; ++i) {
+      EXPECT_GE(1.0f, std::fabs(data[i]));
+      if (data[i] != data[i - 1]) {
+        changes += 1;
+      }
+    }
+    const float kExpected(kFrequency * kDataTestSetSize);
+    // A few changes may be missed (identical consecutive values)
+    EXPECT_NEAR(kExpected, static_cast<float>(changes), 1.0f + 1e-2f * kExpected);
+  }
+}
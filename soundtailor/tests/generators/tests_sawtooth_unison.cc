@@ -0,0 +1,121 @@
+/// @file tests_sawtooth_unison.cc
+/// @brief SoundTailor unison generator tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/sawtooth_unison.h"
+
+// Using declarations for tested generator
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::generators::SawtoothUnison;
+
+static const unsigned int kDataTestSetSize(32768);
+static const float kSamplingRate(96000.0f);
+/// @brief Arbitrary lowest allowed fundamental
+static const float kMinFundamentalNorm(10.0f / kSamplingRate);
+/// @brief Arbitrary highest allowed fundamental
+static const float kMaxFundamentalNorm(2000.0f / kSamplingRate);
+
+/// @brief Generates a signal with random parameters,
+/// check for normalized range (within [-1.0f ; 1.0f]) on both channels
+TEST(SawtoothUnison, Range) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(kMinFundamentalNorm,
+                                                          kMaxFundamentalNorm);
+  std::vector<float> left(kDataTestSetSize);
+  std::vector<float> right(kDataTestSetSize);
+  for (unsigned int voices(1);
+       voices <= SawtoothUnison::kMaxVoices;
+       ++voices) {
+    SawtoothUnison generator(voices);
+    generator.SetFrequency(kFreqDistribution(kRandomGenerator));
+    generator.SetDetune(kNormPosDistribution(kRandomGenerator));
+    generator.SetPhaseSpread(kNormPosDistribution(kRandomGenerator));
+    generator.SetStereoSpread(kNormPosDistribution(kRandomGenerator));
+    generator.ProcessBlock(&left[0], &right[0], kDataTestSetSize);
+    // Small epsilon for DPW overshoots
+    const float kEpsilon(1e-2f);
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(left[i]));
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(right[i]));
+    }
+  }
+}
+
+/// @brief Without any detune nor spread, all oscillators are identical:
+/// output is expected to be the one of a single SawtoothDPW panned center
+TEST(SawtoothUnison, NoSpread) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_real_distribution<float> kFreqDistribution(kMinFundamentalNorm,
+                                                          kMaxFundamentalNorm);
+  const float kFrequency(kFreqDistribution(kRandomGenerator));
+  SawtoothUnison generator(SawtoothUnison::kMaxVoices - 1);
+  generator.SetFrequency(kFrequency);
+  SawtoothDPW reference;
+  reference.SetFrequency(kFrequency);
+
+  std::vector<float> left(kDataTestSetSize);
+  std::vector<float> right(kDataTestSetSize);
+  std::vector<float> expected(kDataTestSetSize);
+  generator.ProcessBlock(&left[0], &right[0], kDataTestSetSize);
+  soundtailor::ProcessBlock(&expected[0], kDataTestSetSize, reference);
+
+  const float kCenterGain(std::sqrt(0.5f));
+  // Phases are not accumulated the same way, hence a slight drift which may
+  // move a discontinuity by one sample: only the mean error is checked
+  float left_error(0.0f);
+  float right_error(0.0f);
+  // The very first reference sample is not run from an history
+  for (unsigned int i(1); i < kDataTestSetSize; ++i) {
+    left_error += std::fabs(kCenterGain * expected[i] - left[i]);
+    right_error += std::fabs(kCenterGain * expected[i] - right[i]);
+  }
+  const float kEpsilon(1e-3f);
+  EXPECT_GT(kEpsilon, left_error / kDataTestSetSize);
+  EXPECT_GT(kEpsilon, right_error / kDataTestSetSize);
+}
+
+/// @brief Outermost oscillators are hard panned at max stereo spread
+TEST(SawtoothUnison, StereoSpread) {
+  const float kFrequency(kMaxFundamentalNorm);
+  SawtoothUnison generator(2);
+  generator.SetFrequency(kFrequency);
+  generator.SetDetune(1.0f);
+  generator.SetStereoSpread(1.0f);
+  SawtoothUnison generator_left(1);
+  generator_left.SetFrequency(kFrequency * (1.0f - 0.06f));
+
+  std::vector<float> left(kDataTestSetSize);
+  std::vector<float> right(kDataTestSetSize);
+  std::vector<float> expected(kDataTestSetSize);
+  std::vector<float> unused(kDataTestSetSize);
+  generator.ProcessBlock(&left[0], &right[0], kDataTestSetSize);
+  generator_left.ProcessBlock(&expected[0], &unused[0], kDataTestSetSize);
+
+  // Single voice is panned center, the stereo one hard left with half gain
+  const float kExpectedRatio(0.5f / std::sqrt(0.5f));
+  const float kEpsilon(1e-4f);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    EXPECT_NEAR(kExpectedRatio * expected[i], left[i], kEpsilon);
+  }
+}
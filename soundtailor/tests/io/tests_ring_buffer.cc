@@ -0,0 +1,98 @@
+/// @file tests_ring_buffer.cc
+/// @brief SoundTailor lock-free ring buffer tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <thread>
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/io/ring_buffer.h"
+
+using soundtailor::io::RingBuffer;
+
+/// @brief Capacity rounding, partial pushes and pops, wrapping
+TEST(RingBuffer, SingleThread) {
+  RingBuffer ring(100);
+  EXPECT_EQ(128u, ring.GetCapacity());
+  std::vector<float> input(200);
+  for (std::size_t i(0); i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+  std::vector<float> output(200);
+  EXPECT_EQ(100u, ring.Push(&input[0], 100));
+  EXPECT_EQ(28u, ring.Push(&input[100], 100));
+  EXPECT_EQ(0u, ring.GetWriteAvailable());
+  EXPECT_EQ(60u, ring.Pop(&output[0], 60));
+  // Wrapping around the buffer end
+  EXPECT_EQ(60u, ring.Push(&input[128], 72));
+  EXPECT_EQ(128u, ring.Pop(&output[60], 200));
+  EXPECT_EQ(0u, ring.GetReadAvailable());
+  for (std::size_t i(0); i < 188; ++i) {
+    EXPECT_EQ(input[i], output[i]);
+  }
+}
+
+/// @brief One producer and one consumer thread: all values go through,
+/// in order
+TEST(RingBuffer, ProducerConsumer) {
+  // Smaller test sets in debug
+#if (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+  const std::size_t kValuesCount(1 << 18);
+#else  // (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+  const std::size_t kValuesCount(1 << 22);
+#endif  // (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+  RingBuffer ring(1024);
+  std::thread producer([&ring, kValuesCount]() {
+    float chunk[97];
+    std::size_t pushed(0);
+    while (pushed < kValuesCount) {
+      const std::size_t kCount(std::min(kValuesCount - pushed,
+                                        sizeof(chunk) / sizeof(chunk[0])));
+      for (std::size_t i(0); i < kCount; ++i) {
+        // Exactly representable values
+        chunk[i] = static_cast<float>((pushed + i) % (1 << 20));
+      }
+      std::size_t done(0);
+      while (done < kCount) {
+        done += ring.Push(&chunk[done], kCount - done);
+        std::this_thread::yield();
+      }
+      pushed += kCount;
+    }
+  });
+  std::vector<float> chunk(61);
+  std::size_t popped(0);
+  std::size_t errors(0);
+  while (popped < kValuesCount) {
+    const std::size_t kCount(ring.Pop(&chunk[0], chunk.size()));
+    for (std::size_t i(0); i < kCount; ++i) {
+      if (chunk[i] != static_cast<float>((popped + i) % (1 << 20))) {
+        errors += 1;
+      }
+    }
+    popped += kCount;
+    if (0 == kCount) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_EQ(0u, errors);
+  EXPECT_EQ(0u, ring.GetReadAvailable());
+}
@@ -0,0 +1,205 @@
+/// @file tests_wave_file.cc
+/// @brief SoundTailor wave files reading and writing tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::chrono
+#include <chrono>
+// std::remove
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/generators/white_noise.h"
+#include "soundtailor/src/io/background_wave_writer.h"
+#include "soundtailor/src/io/wave_file.h"
+#include "soundtailor/src/io/wave_format.h"
+
+using soundtailor::generators::WhiteNoise;
+using soundtailor::io::BackgroundWaveWriter;
+using soundtailor::io::ConvertFromFloat;
+using soundtailor::io::ConvertToFloat;
+using soundtailor::io::GetBytesPerSample;
+using soundtailor::io::SampleFormat;
+using soundtailor::io::WaveFileReader;
+using soundtailor::io::WaveFileWriter;
+using soundtailor::io::WaveFormat;
+
+static const char* kFilename("soundtailor_tests_io.wav");
+
+/// @brief All supported formats, along with their expected round trip error
+///
+/// Integer formats are written with a (2^(n-1) - 1) scale and read with
+/// a 2^(n-1) one: up to 1.5 LSB error near full scale
+struct FormatPrecision {
+  SampleFormat format;
+  float epsilon;
+};
+
+static const FormatPrecision kFormats[] = {
+  {soundtailor::io::kSampleFormatInt16, 2.0f / 32768.0f},
+  {soundtailor::io::kSampleFormatInt24, 2.0f / 8388608.0f},
+  {soundtailor::io::kSampleFormatInt32, 1e-7f},
+  {soundtailor::io::kSampleFormatFloat32, 0.0f}
+};
+
+/// @brief Random data within [-1.0 ; 1.0], with a length not being
+/// a multiple of SampleSize (so that scalar remainders are tested)
+static std::vector<float> MakeNoise(const std::size_t length) {
+  // Generated length has to be a multiple of SampleSize
+  std::vector<float> out(
+    (length + soundtailor::SampleSize - 1) & ~(soundtailor::SampleSize - 1));
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&out[0], out.size(), noise);
+  out.resize(length);
+  return out;
+}
+
+/// @brief Full scale values and out of range ones get clipped
+TEST(WaveFormat, ConvertClipping) {
+  const float kInput[] = {1.0f, -1.0f, 2.0f, -2.0f, 0.5f, 0.0f, -0.5f};
+  const std::size_t kCount(sizeof(kInput) / sizeof(kInput[0]));
+  std::vector<unsigned char> converted(kCount * 2);
+  ConvertFromFloat(&kInput[0],
+                   kCount,
+                   soundtailor::io::kSampleFormatInt16,
+                   &converted[0]);
+  const int kExpected[] = {32767, -32767, 32767, -32767, 16384, 0, -16384};
+  for (std::size_t i(0); i < kCount; ++i) {
+    const int kActual(static_cast<std::int16_t>(
+      converted[2 * i] | (converted[2 * i + 1] << 8)));
+    EXPECT_EQ(kExpected[i], kActual);
+  }
+}
+
+/// @brief Conversion to any format and back keeps the data,
+/// down to the format precision
+TEST(WaveFormat, ConvertRoundTrip) {
+  const std::size_t kLength(1027);
+  const std::vector<float> kInput(MakeNoise(kLength));
+  std::vector<float> output(kLength);
+  for (const FormatPrecision& format : kFormats) {
+    std::vector<unsigned char> converted(
+      kLength * GetBytesPerSample(format.format));
+    ConvertFromFloat(&kInput[0], kLength, format.format, &converted[0]);
+    ConvertToFloat(&converted[0], kLength, format.format, &output[0]);
+    for (std::size_t i(0); i < kLength; ++i) {
+      EXPECT_NEAR(kInput[i], output[i], format.epsilon);
+    }
+  }
+}
+
+/// @brief Multichannel files written then read back, in all formats
+TEST(WaveFile, RoundTrip) {
+  const unsigned int kChannelsCount(3);
+  const std::size_t kFramesCount(10007);
+  const std::vector<float> kInput(MakeNoise(kFramesCount * kChannelsCount));
+  for (const FormatPrecision& format : kFormats) {
+    const WaveFormat kFormat = {format.format, kChannelsCount, 44100};
+    WaveFileWriter writer;
+    ASSERT_TRUE(writer.Open(kFilename, kFormat));
+    // Odd chunks, spanning the writer internal buffer
+    std::size_t written(0);
+    while (written < kFramesCount) {
+      const std::size_t kChunk(std::min(kFramesCount - written,
+                                        static_cast<std::size_t>(1531)));
+      EXPECT_TRUE(writer.Write(&kInput[written * kChannelsCount], kChunk));
+      written += kChunk;
+    }
+    EXPECT_EQ(kFramesCount, writer.GetFramesCount());
+    EXPECT_TRUE(writer.Close());
+
+    WaveFileReader reader;
+    ASSERT_TRUE(reader.Open(kFilename));
+    EXPECT_EQ(kFormat.sample_format, reader.GetFormat().sample_format);
+    EXPECT_EQ(kChannelsCount, reader.GetFormat().channels_count);
+    EXPECT_EQ(44100u, reader.GetFormat().sampling_rate);
+    ASSERT_EQ(kFramesCount, reader.GetFramesCount());
+    std::vector<float> output(kFramesCount * kChannelsCount);
+    EXPECT_EQ(kFramesCount, reader.Read(&output[0], kFramesCount + 10));
+    EXPECT_EQ(0u, reader.Read(&output[0], 1));
+    for (std::size_t i(0); i < output.size(); ++i) {
+      EXPECT_NEAR(kInput[i], output[i], format.epsilon);
+    }
+
+    // Random access
+    const std::size_t kPosition(kFramesCount / 3);
+    reader.Seek(kPosition);
+    EXPECT_EQ(1u, reader.Read(&output[0], 1));
+    for (unsigned int channel(0); channel < kChannelsCount; ++channel) {
+      EXPECT_NEAR(kInput[kPosition * kChannelsCount + channel],
+                  output[channel],
+                  format.epsilon);
+    }
+    reader.Close();
+  }
+  std::remove(kFilename);
+}
+
+/// @brief Invalid files are rejected
+TEST(WaveFile, Invalid) {
+  WaveFileReader reader;
+  EXPECT_FALSE(reader.Open("soundtailor_tests_io_missing.wav"));
+  std::FILE* file(std::fopen(kFilename, "wb"));
+  ASSERT_TRUE(file != nullptr);
+  std::fputs("RIFF----WAVEdata", file);
+  std::fclose(file);
+  EXPECT_FALSE(reader.Open(kFilename));
+  EXPECT_FALSE(reader.IsOpen());
+  std::remove(kFilename);
+}
+
+/// @brief Frames pushed to the background writer all end up in the file
+TEST(BackgroundWaveWriter, RoundTrip) {
+  const unsigned int kChannelsCount(2);
+  const std::size_t kFramesCount(48000);
+  const std::size_t kBlockSize(256);
+  const std::vector<float> kInput(MakeNoise(kFramesCount * kChannelsCount));
+  const WaveFormat kFormat = {soundtailor::io::kSampleFormatFloat32,
+                              kChannelsCount,
+                              48000};
+  // Small ring, so that it gets full from time to time
+  BackgroundWaveWriter writer(4096);
+  ASSERT_TRUE(writer.Open(kFilename, kFormat));
+  std::size_t pushed(0);
+  while (pushed < kFramesCount) {
+    const std::size_t kBlock(std::min(kBlockSize, kFramesCount - pushed));
+    const std::size_t kPushed(writer.Push(&kInput[pushed * kChannelsCount],
+                                          kBlock));
+    pushed += kPushed;
+    if (kPushed < kBlock) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ(kFramesCount, writer.GetFramesCount());
+
+  WaveFileReader reader;
+  ASSERT_TRUE(reader.Open(kFilename));
+  ASSERT_EQ(kFramesCount, reader.GetFramesCount());
+  std::vector<float> output(kFramesCount * kChannelsCount);
+  EXPECT_EQ(kFramesCount, reader.Read(&output[0], kFramesCount));
+  for (std::size_t i(0); i < output.size(); ++i) {
+    EXPECT_EQ(kInput[i], output[i]);
+  }
+  reader.Close();
+  std::remove(kFilename);
+}
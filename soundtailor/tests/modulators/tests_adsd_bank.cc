@@ -0,0 +1,112 @@
+/// @file tests_adsd_bank.cc
+/// @brief SoundTailor envelop bank tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/modulators/adsd.h"
+#include "soundtailor/src/modulators/adsd_bank.h"
+
+using soundtailor::modulators::Adsd;
+using soundtailor::modulators::AdsdBank;
+
+static const unsigned int kVoices(16);
+static const unsigned int kMaxTime(9600);
+static const unsigned int kDataTestSetSize(32768);
+
+/// @brief Check that each envelop of the bank matches an Adsd one,
+/// all of them being triggered at random times
+TEST(AdsdBank, MatchesAdsd) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_int_distribution<unsigned int> kTimeDistribution(0, kMaxTime);
+  std::uniform_int_distribution<unsigned int> kEventDistribution(
+    0,
+    kDataTestSetSize);
+
+  AdsdBank<kVoices> bank;
+  std::vector<Adsd> references(kVoices);
+  std::vector<unsigned int> triggers_on(kVoices);
+  std::vector<unsigned int> triggers_off(kVoices);
+  for (unsigned int voice(0); voice < kVoices; ++voice) {
+    const unsigned int kAttack(kTimeDistribution(kRandomGenerator));
+    const unsigned int kDecay(kTimeDistribution(kRandomGenerator));
+    const float kSustainLevel(kNormPosDistribution(kRandomGenerator));
+    bank.SetParameters(voice, kAttack, kDecay, kDecay, kSustainLevel);
+    references[voice].SetParameters(kAttack, kDecay, kDecay, kSustainLevel);
+    triggers_on[voice] = kEventDistribution(kRandomGenerator) / 2;
+    triggers_off[voice] = triggers_on[voice]
+                          + kEventDistribution(kRandomGenerator) / 2;
+  }
+
+  std::vector<float> out(kVoices);
+  // Values are accumulated in single precision, contrary to Adsd
+  const float kEpsilon(1e-3f);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    for (unsigned int voice(0); voice < kVoices; ++voice) {
+      if (triggers_on[voice] == i) {
+        bank.TriggerOn(voice);
+        references[voice].TriggerOn();
+      }
+      if (triggers_off[voice] == i) {
+        bank.TriggerOff(voice);
+        references[voice].TriggerOff();
+      }
+    }
+    bank.Process(&out[0]);
+    for (unsigned int voice(0); voice < kVoices; ++voice) {
+      EXPECT_NEAR(references[voice].ComputeOneSample(), out[voice], kEpsilon);
+      EXPECT_EQ(references[voice].GetCurrentSection(),
+                bank.GetCurrentSection(voice));
+    }
+  }
+}
+
+/// @brief Check per-voice finished flags
+TEST(AdsdBank, Finished) {
+  const unsigned int kAttack(64);
+  const unsigned int kDecay(128);
+  const unsigned int kSustain(32);
+  AdsdBank<kVoices> bank;
+  for (unsigned int voice(0); voice < kVoices; ++voice) {
+    bank.SetParameters(voice, kAttack, kDecay, kDecay, 0.5f);
+  }
+  // Nothing triggered yet
+  EXPECT_TRUE(bank.GetFinishedVoices().all());
+
+  // Only even voices are triggered
+  for (unsigned int voice(0); voice < kVoices; voice += 2) {
+    bank.TriggerOn(voice);
+  }
+  std::vector<float> out(kVoices * (kAttack + kDecay + kSustain));
+  bank.ProcessBlock(&out[0], kAttack + kDecay + kSustain);
+  for (unsigned int voice(0); voice < kVoices; ++voice) {
+    EXPECT_EQ(voice % 2 != 0, bank.GetFinishedVoices()[voice]);
+  }
+  for (unsigned int voice(0); voice < kVoices; voice += 2) {
+    bank.TriggerOff(voice);
+  }
+  bank.ProcessBlock(&out[0], kDecay + 2);
+  EXPECT_TRUE(bank.GetFinishedVoices().all());
+  // Finished voices are silent
+  for (unsigned int voice(0); voice < kVoices; ++voice) {
+    EXPECT_EQ(0.0f, out[(kDecay + 1) * kVoices + voice]);
+  }
+}
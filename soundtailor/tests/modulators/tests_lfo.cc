@@ -0,0 +1,198 @@
+/// @file tests_lfo.cc
+/// @brief SoundTailor low frequency oscillators tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/modulators/lfo.h"
+
+using soundtailor::modulators::Lfo;
+using soundtailor::modulators::LfoWaveform;
+
+static const float kSamplingRate(96000.0f);
+/// @brief Arbitrary lowest allowed frequency
+static const float kMinFrequencyNorm(0.01f / kSamplingRate);
+/// @brief Arbitrary highest allowed frequency
+static const float kMaxFrequencyNorm(200.0f / kSamplingRate);
+
+/// @brief Lfo with a fixed waveform, so that each one is a type on its own
+template <LfoWaveform Waveform>
+class LfoWith : public Lfo {
+ public:
+  LfoWith() : Lfo(Waveform) {}
+};
+
+/// @brief Tests fixture for low frequency oscillators
+template <typename LfoType>
+class LfoModulator : public ::testing::Test {
+ protected:
+  LfoModulator()
+      : kTestIterations_(16),
+        kDataTestSetSize_(32768),
+        kBlockSize_(64),
+        kRandomGenerator_(),
+        kFreqDistribution_(kMinFrequencyNorm, kMaxFrequencyNorm),
+        output_data_(kDataTestSetSize_) {
+    // Nothing to be done here for now
+  }
+
+  virtual ~LfoModulator() {
+    // Nothing to be done here for now
+  }
+
+  const unsigned int kTestIterations_;
+  const unsigned int kDataTestSetSize_;
+  const unsigned int kBlockSize_;
+  std::default_random_engine kRandomGenerator_;
+  std::uniform_real_distribution<float> kFreqDistribution_;
+  std::vector<float> output_data_;
+};
+
+/// @brief All tested types
+typedef ::testing::Types<LfoWith<soundtailor::modulators::kLfoSine>,
+                         LfoWith<soundtailor::modulators::kLfoTriangle>,
+                         LfoWith<soundtailor::modulators::kLfoSawtooth>,
+                         LfoWith<soundtailor::modulators::kLfoSquare>,
+                         LfoWith<soundtailor::modulators::kLfoSampleAndHold> >
+                         LfoTypes;
+
+TYPED_TEST_SUITE(LfoModulator, LfoTypes);
+
+/// @brief Generates a signal at both rates,
+/// check for its range (within [-1.0 ; 1.0])
+TYPED_TEST(LfoModulator, Range) {
+  for (unsigned int iterations(0);
+       iterations < this->kTestIterations_;
+       ++iterations) {
+    IGNORE(iterations);
+    TypeParam generator;
+    generator.SetFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+    generator.SetPhase(kNormPosDistribution(this->kRandomGenerator_) * 0.999f);
+    generator.SetRate(kBoolDistribution(this->kRandomGenerator_)
+                      ? soundtailor::modulators::kLfoAudioRate
+                      : soundtailor::modulators::kLfoControlRate);
+    for (unsigned int i(0);
+         i < this->kDataTestSetSize_;
+         i += this->kBlockSize_) {
+      generator.ProcessBlock(&this->output_data_[i], this->kBlockSize_);
+    }
+    // Small epsilon for the sine approximation
+    const float kEpsilon(1e-3f);
+    for (unsigned int i(0); i < this->kDataTestSetSize_; ++i) {
+      EXPECT_GE(1.0f + kEpsilon, std::fabs(this->output_data_[i]));
+    }
+  }
+}
+
+/// @brief Check that both per-sample and per-block audio rate generation
+/// methods yield an identical result
+TYPED_TEST(LfoModulator, Process) {
+  const float kFrequency(this->kFreqDistribution_(this->kRandomGenerator_));
+  TypeParam generator_perblock;
+  TypeParam generator_persample;
+  generator_perblock.SetFrequency(kFrequency);
+  generator_persample.SetFrequency(kFrequency);
+  generator_perblock.ProcessBlock(&this->output_data_[0],
+                                  this->output_data_.size());
+  for (unsigned int i(0);
+       i < this->kDataTestSetSize_;
+       i += soundtailor::SampleSize) {
+    const Sample kReference(VectorMath::Fill(&this->output_data_[i]));
+    const Sample kGenerated(generator_persample());
+    EXPECT_TRUE(VectorMath::Equal(kReference, kGenerated));
+  }
+}
+
+/// @brief At control rate, the last sample of each block has to match
+/// the audio rate value at the same time
+TYPED_TEST(LfoModulator, ControlRate) {
+  // Increments are exactly representable,
+  // hence no phase drift between both rates
+  const float kFrequency(1.0f / 2048.0f);
+  TypeParam generator_audio;
+  TypeParam generator_control;
+  generator_audio.SetFrequency(kFrequency);
+  generator_control.SetFrequency(kFrequency);
+  generator_control.SetRate(soundtailor::modulators::kLfoControlRate);
+
+  std::vector<float> control(this->kDataTestSetSize_);
+  generator_audio.ProcessBlock(&this->output_data_[0],
+                               this->output_data_.size());
+  for (unsigned int i(0);
+       i < this->kDataTestSetSize_;
+       i += this->kBlockSize_) {
+    generator_control.ProcessBlock(&control[i], this->kBlockSize_);
+  }
+  const float kEpsilon(1e-5f);
+  for (unsigned int i(this->kBlockSize_);
+       i < this->kDataTestSetSize_;
+       i += this->kBlockSize_) {
+    EXPECT_NEAR(this->output_data_[i], control[i - 1], kEpsilon);
+  }
+  // Control rate output is continuous
+  const float kMaxDelta(2.0f / this->kBlockSize_ + kEpsilon);
+  for (unsigned int i(1); i < this->kDataTestSetSize_; ++i) {
+    EXPECT_GE(kMaxDelta, std::fabs(control[i] - control[i - 1]));
+  }
+}
+
+/// @brief Check tempo synchronization: the period has to match
+/// the given musical duration, and the phase the song position
+TEST(Lfo, TempoSync) {
+  const float kTempo(120.0f);
+  const float kSamplingRate(48000.0f);
+  // A period lasts for a half note, e.g. 48000 samples at 120 bpm
+  const float kBeats(2.0f);
+  const unsigned int kPeriod(48000);
+
+  Lfo generator(soundtailor::modulators::kLfoSawtooth);
+  generator.SetTempoSync(kTempo, kBeats, kSamplingRate);
+  generator.SyncToPosition(0.0);
+  const float kEpsilon(1e-3f);
+  EXPECT_NEAR(-1.0f, generator.ProcessControl(0), kEpsilon);
+  // Half a period later, the sawtooth is half way
+  EXPECT_NEAR(0.0f, generator.ProcessControl(kPeriod / 2), kEpsilon);
+  EXPECT_NEAR(0.5f, generator.ProcessControl(kPeriod / 4), kEpsilon);
+
+  // Aligning on the song: 5.5 beats is one period and 3/4 of another one
+  generator.SyncToPosition(5.5);
+  EXPECT_NEAR(0.5f, generator.ProcessControl(0), kEpsilon);
+  generator.SyncToPosition(4.0);
+  EXPECT_NEAR(-1.0f, generator.ProcessControl(0), kEpsilon);
+}
+
+/// @brief Check the sine waveform against the actual one
+TEST(Lfo, SineAccuracy) {
+  const unsigned int kPeriod(1024);
+  Lfo generator(soundtailor::modulators::kLfoSine);
+  generator.SetFrequency(1.0f / kPeriod);
+  generator.SetPhase(0.0f);
+  // Phase convention: the phase starts at -1.0, hence the sign
+  const float kEpsilon(2e-3f);
+  for (unsigned int i(0); i < kPeriod; i += soundtailor::SampleSize) {
+    const Sample kGenerated(generator());
+    for (unsigned int j(0); j < soundtailor::SampleSize; ++j) {
+      const double kExpected(-std::sin(2.0 * soundtailor::Pi * (i + j)
+                                       / kPeriod));
+      EXPECT_NEAR(kExpected, VectorMath::GetByIndex(kGenerated, j), kEpsilon);
+    }
+  }
+}
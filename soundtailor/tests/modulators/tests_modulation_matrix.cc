@@ -0,0 +1,185 @@
+/// @file tests_modulation_matrix.cc
+/// @brief SoundTailor modulation matrix tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/modulators/lfo.h"
+#include "soundtailor/src/modulators/modulation_matrix.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+
+using soundtailor::modulators::Lfo;
+using soundtailor::modulators::ModulationMatrix;
+using soundtailor::generators::SawtoothDPW;
+
+static const unsigned int kBlockSize(64);
+static const unsigned int kBlocksCount(512);
+
+/// @brief Route constant sources, check each destination value
+TEST(ModulationMatrix, Routes) {
+  std::default_random_engine kRandomGenerator;
+  ModulationMatrix matrix(kBlockSize);
+  std::vector<float> sources(ModulationMatrix::kMaxSources);
+  std::vector<float> pushed(ModulationMatrix::kMaxDestinations, 0.0f);
+  for (unsigned int source(0); source < sources.size(); ++source) {
+    sources[source] = kNormDistribution(kRandomGenerator);
+    matrix.AddSource([&sources, source](std::size_t) {
+      return sources[source];
+    });
+  }
+  std::vector<float> bases(ModulationMatrix::kMaxDestinations);
+  for (unsigned int destination(0);
+       destination < ModulationMatrix::kMaxDestinations;
+       ++destination) {
+    bases[destination] = kNormDistribution(kRandomGenerator);
+    matrix.AddDestination([&pushed, destination](float value) {
+                            pushed[destination] = value;
+                          },
+                          bases[destination],
+                          -100.0f,
+                          100.0f,
+                          soundtailor::modulators::kDestinationControlRate);
+  }
+  // Random routes, half of them being null
+  std::vector<float> expected(bases);
+  for (unsigned int source(0); source < sources.size(); ++source) {
+    for (unsigned int destination(0);
+         destination < ModulationMatrix::kMaxDestinations;
+         ++destination) {
+      const float amount(kBoolDistribution(kRandomGenerator)
+                         ? kNormDistribution(kRandomGenerator) : 0.0f);
+      matrix.SetRoute(source, destination, amount);
+      expected[destination] += amount * sources[source];
+    }
+  }
+  matrix.Process(kBlockSize);
+  const float kEpsilon(1e-5f);
+  for (unsigned int destination(0);
+       destination < ModulationMatrix::kMaxDestinations;
+       ++destination) {
+    EXPECT_NEAR(expected[destination], pushed[destination], kEpsilon);
+    EXPECT_NEAR(expected[destination],
+                matrix.GetDestinationValue(destination),
+                kEpsilon);
+  }
+}
+
+/// @brief Destinations are pushed only when their value changes,
+/// and always within their allowed range
+TEST(ModulationMatrix, PushOnChange) {
+  ModulationMatrix matrix(kBlockSize);
+  float source_value(0.5f);
+  unsigned int pushes_count(0);
+  float pushed(0.0f);
+  const unsigned int kSource(matrix.AddSource([&source_value](std::size_t) {
+    return source_value;
+  }));
+  const unsigned int kDestination(matrix.AddDestination(
+    [&pushes_count, &pushed](float value) {
+      pushes_count += 1;
+      pushed = value;
+    },
+    0.25f,
+    0.0f,
+    1.0f,
+    soundtailor::modulators::kDestinationControlRate));
+  matrix.SetRoute(kSource, kDestination, 1.0f);
+  for (unsigned int block(0); block < kBlocksCount; ++block) {
+    matrix.Process(kBlockSize);
+  }
+  EXPECT_EQ(1u, pushes_count);
+  EXPECT_EQ(0.75f, pushed);
+  // Out of range: clamped
+  source_value = 2.0f;
+  for (unsigned int block(0); block < kBlocksCount; ++block) {
+    matrix.Process(kBlockSize);
+  }
+  EXPECT_EQ(2u, pushes_count);
+  EXPECT_EQ(1.0f, pushed);
+  // Route removed: back to the base value
+  matrix.SetRoute(kSource, kDestination, 0.0f);
+  matrix.Process(kBlockSize);
+  EXPECT_EQ(3u, pushes_count);
+  EXPECT_EQ(0.25f, pushed);
+}
+
+/// @brief Audio rate destinations ramp from one block value to the next
+TEST(ModulationMatrix, AudioRate) {
+  std::default_random_engine kRandomGenerator;
+  ModulationMatrix matrix(kBlockSize);
+  float source_value(0.0f);
+  const unsigned int kSource(matrix.AddSource([&source_value](std::size_t) {
+    return source_value;
+  }));
+  const unsigned int kDestination(matrix.AddDestination(
+    ModulationMatrix::Destination(),
+    0.0f,
+    -1.0f,
+    1.0f,
+    soundtailor::modulators::kDestinationAudioRate));
+  matrix.SetRoute(kSource, kDestination, 1.0f);
+  const float kEpsilon(1e-6f);
+  for (unsigned int block(0); block < kBlocksCount; ++block) {
+    const float kPrevious(source_value);
+    source_value = (block % 3 == 0) ? source_value
+                                    : kNormDistribution(kRandomGenerator);
+    matrix.Process(kBlockSize);
+    const float* values(matrix.GetDestinationBlock(kDestination));
+    const float kStep((source_value - kPrevious) / kBlockSize);
+    for (unsigned int i(0); i < kBlockSize; ++i) {
+      EXPECT_NEAR(kPrevious + (i + 1) * kStep, values[i], kEpsilon * 16.0f);
+    }
+    EXPECT_NEAR(source_value, values[kBlockSize - 1], kEpsilon * 16.0f);
+  }
+}
+
+/// @brief Modulate an oscillator frequency with a LFO:
+/// the oscillator is never updated more than once per block
+TEST(ModulationMatrix, OneUpdatePerBlock) {
+  const float kBaseFrequency(0.01f);
+  const float kLfoFrequency(1.0f / 96000.0f);
+  std::vector<float> output(kBlockSize);
+
+  Lfo lfo;
+  lfo.SetFrequency(kLfoFrequency);
+  SawtoothDPW generator;
+  unsigned int pushes_count(0);
+  ModulationMatrix matrix(kBlockSize);
+  const unsigned int kSource(matrix.AddSource([&lfo](std::size_t length) {
+    return lfo.ProcessControl(length);
+  }));
+  const unsigned int kDestination(matrix.AddDestination(
+    [&generator, &pushes_count](float value) {
+      generator.SetFrequency(value);
+      pushes_count += 1;
+    },
+    kBaseFrequency,
+    0.0f,
+    0.5f,
+    soundtailor::modulators::kDestinationControlRate));
+  matrix.SetRoute(kSource, kDestination, 0.5f * kBaseFrequency);
+  for (unsigned int block(0); block < kBlocksCount; ++block) {
+    matrix.Process(kBlockSize);
+    soundtailor::ProcessBlock(&output[0], kBlockSize, generator);
+  }
+  EXPECT_LT(0u, pushes_count);
+  EXPECT_GE(kBlocksCount, pushes_count);
+}
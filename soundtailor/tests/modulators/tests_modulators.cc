@@ -21,18 +21,34 @@
 #include "soundtailor/tests/modulators/tests_modulators_fixture.h"
 
 #include "soundtailor/src/modulators/adsd.h"
+#include "soundtailor/src/modulators/adsr.h"
 #include "soundtailor/src/generators/generators_common.h"
 
 using soundtailor::modulators::Adsd;
+using soundtailor::modulators::Adsr;
 // For testing purpose only
 using soundtailor::generators::Differentiator;
 
 /// @brief All tested types
-typedef ::testing::Types<Adsd> ModulatorTypes;
+typedef ::testing::Types<Adsd, Adsr> ModulatorTypes;
 
 TYPED_TEST_SUITE(Modulator, ModulatorTypes);
 TYPED_TEST_SUITE(ModulatorData, ModulatorTypes);
 
+/// @brief Steepest attack slope of each modulator,
+/// relatively to the one of a linear attack of the same length
+template <typename ModulatorType>
+float GetMaxSlopeFactor(void) {
+  return 1.0f;
+}
+
+/// @brief An exponential attack is at its steepest at its very beginning
+template <>
+float GetMaxSlopeFactor<Adsr>(void) {
+  return static_cast<float>((1.0 + Adsr::kAttackRatio)
+                            * std::log(1.0 + 1.0 / Adsr::kAttackRatio));
+}
+
 /// @brief Generates an envelop, check for its range (must be >= 0)
 TYPED_TEST(Modulator, Range) {
   std::cerr << "Instance size : " << sizeof(TypeParam) << std::endl;
@@ -294,7 +310,9 @@ TYPED_TEST(Modulator, OutRegularity) {
     // A very small epsilon is added for computation/casts imprecisions
     // TODO(gm): this might not be required if all floating point operations
     // were properly understood and managed.
-    const float kMaxDelta(static_cast<float>(1.0 / std::min(this->kAttack_, this->kDecay_) + 1e-7));
+    const float kMaxDelta(static_cast<float>(GetMaxSlopeFactor<TypeParam>()
+                                             / std::min(this->kAttack_, this->kDecay_)
+                                             + 1e-7));
     // Envelops should all begin at zero!
     Differentiator differentiator;
     // Checking the whole envelop since clicks may occur anywhere
@@ -419,3 +437,124 @@ TYPED_TEST(ModulatorData, BlockPerf) {
     }
   }
 }
+
+/// @brief Check that the release length only depends on the release setting
+TEST(Adsr, ReleaseTime) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_int_distribution<unsigned int> kTimeDistribution(1, 96000);
+  const unsigned int kSustain(128);
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const unsigned int kAttack(kTimeDistribution(kRandomGenerator));
+    const unsigned int kDecay(kTimeDistribution(kRandomGenerator));
+    const unsigned int kRelease(kTimeDistribution(kRandomGenerator));
+
+    Adsr generator;
+    generator.SetParameters(kAttack,
+                            kDecay,
+                            kRelease,
+                            kNormPosDistribution(kRandomGenerator));
+    generator.TriggerOn();
+    for (unsigned int i(0); i < kAttack + kDecay + kSustain; ++i) {
+      generator.ComputeOneSample();
+    }
+    generator.TriggerOff();
+    unsigned int release_length(0);
+    while (soundtailor::modulators::kZero != generator.GetCurrentSection()) {
+      generator.ComputeOneSample();
+      release_length += 1;
+    }
+    EXPECT_EQ(kRelease, release_length);
+  }
+}
+
+/// @brief Check the exponential shape of all segments:
+/// the attack has to be concave, decay and release convex
+TEST(Adsr, Curvature) {
+  const unsigned int kAttack(1024);
+  const unsigned int kDecay(2048);
+  const unsigned int kSustain(256);
+  const unsigned int kRelease(4096);
+  const float kSustainLevel(0.5f);
+
+  Adsr generator;
+  generator.SetParameters(kAttack, kDecay, kRelease, kSustainLevel);
+  generator.TriggerOn();
+  std::vector<float> envelop;
+  for (unsigned int i(0); i < kAttack + kDecay + kSustain; ++i) {
+    envelop.push_back(generator.ComputeOneSample());
+  }
+  generator.TriggerOff();
+  for (unsigned int i(0); i < kRelease; ++i) {
+    envelop.push_back(generator.ComputeOneSample());
+  }
+  // Tiny epsilon for floating point rounding,
+  // segments last samples are skipped since snapped to their end level
+  const float kEpsilon(1e-6f);
+  for (unsigned int i(1); i < kAttack - 1; ++i) {
+    const float kCurvature(envelop[i + 1] - 2.0f * envelop[i] + envelop[i - 1]);
+    EXPECT_GE(kEpsilon, kCurvature);
+  }
+  for (unsigned int i(kAttack + 1); i < kAttack + kDecay - 1; ++i) {
+    const float kCurvature(envelop[i + 1] - 2.0f * envelop[i] + envelop[i - 1]);
+    EXPECT_LE(-kEpsilon, kCurvature);
+  }
+  const unsigned int kReleaseBegin(kAttack + kDecay + kSustain);
+  for (unsigned int i(kReleaseBegin + 1);
+       i < kReleaseBegin + kRelease - 1;
+       ++i) {
+    const float kCurvature(envelop[i + 1] - 2.0f * envelop[i] + envelop[i - 1]);
+    EXPECT_LE(-kEpsilon, kCurvature);
+  }
+  // Segments end levels are exactly reached
+  EXPECT_EQ(1.0f, envelop[kAttack]);
+  EXPECT_EQ(kSustainLevel, envelop[kAttack + kDecay]);
+  // Half way through, the release is well below the linear one
+  EXPECT_GT(0.5f * kSustainLevel, envelop[kReleaseBegin + kRelease / 2]);
+}
+
+/// @brief Check that the vectorized path matches the sample per sample one
+TEST(Adsr, Vectorized) {
+  std::default_random_engine kRandomGenerator;
+  std::uniform_int_distribution<unsigned int> kTimeDistribution(0, 9600);
+  const unsigned int kSustain(128);
+  const unsigned int kTail(256);
+  for (unsigned int iterations(0); iterations < 16; ++iterations) {
+    IGNORE(iterations);
+    const unsigned int kAttack(kTimeDistribution(kRandomGenerator));
+    const unsigned int kDecay(kTimeDistribution(kRandomGenerator));
+    const unsigned int kRelease(kTimeDistribution(kRandomGenerator));
+    const float kSustainLevel(kNormPosDistribution(kRandomGenerator));
+
+    Adsr generator_vector;
+    Adsr generator_scalar;
+    generator_vector.SetParameters(kAttack, kDecay, kRelease, kSustainLevel);
+    generator_scalar.SetParameters(kAttack, kDecay, kRelease, kSustainLevel);
+    generator_vector.TriggerOn();
+    generator_scalar.TriggerOn();
+    const unsigned int kTriggerOnLength(
+      GetMultipleOf4(kAttack + kDecay + kSustain));
+    const unsigned int kTotalLength(
+      kTriggerOnLength + GetMultipleOf4(kRelease + kTail));
+    const float kEpsilon(1e-4f);
+    for (unsigned int i(0); i < kTotalLength; i += soundtailor::SampleSize) {
+      if (kTriggerOnLength == i) {
+        generator_vector.TriggerOff();
+        generator_scalar.TriggerOff();
+      }
+      const Sample kVector(generator_vector());
+      EXPECT_NEAR(generator_scalar.ComputeOneSample(),
+                  VectorMath::GetByIndex<0>(kVector),
+                  kEpsilon);
+      EXPECT_NEAR(generator_scalar.ComputeOneSample(),
+                  VectorMath::GetByIndex<1>(kVector),
+                  kEpsilon);
+      EXPECT_NEAR(generator_scalar.ComputeOneSample(),
+                  VectorMath::GetByIndex<2>(kVector),
+                  kEpsilon);
+      EXPECT_NEAR(generator_scalar.ComputeOneSample(),
+                  VectorMath::GetByIndex<3>(kVector),
+                  kEpsilon);
+    }
+  }
+}
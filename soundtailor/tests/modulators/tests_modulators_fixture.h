@@ -94,6 +94,9 @@ class Modulator : public ::testing::Test {
       // Nothing to do here
     }
 
+    // Copied by ZeroCrossing
+    AdsdFunctor(const AdsdFunctor& right) = default;
+
     Sample operator()(void) {
       const Sample input((*modulators_)());
       return differentiator_(input);
@@ -0,0 +1,226 @@
+/// @file tests_smoothed_parameter.cc
+/// @brief SoundTailor parameter smoothing tests
+/// @author gm
+/// @copyright gm 2014
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/white_noise.h"
+#include "soundtailor/src/modulators/smoothed_parameter.h"
+
+using soundtailor::filters::StateVariable;
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::generators::WhiteNoise;
+using soundtailor::modulators::SmoothedParameter;
+
+static const unsigned int kDataTestSetSize(4096);
+
+/// @brief Compare the smoothed values with a straightforward
+/// per-sample implementation of each smoothing type
+TEST(SmoothedParameter, MatchesReference) {
+  const float kStart(0.25f);
+  const float kTarget(4.0f);
+  // Not a multiple of SampleSize on purpose
+  const float kTime(401.0f);
+  const soundtailor::modulators::SmoothingType kTypes[] = {
+    soundtailor::modulators::kSmoothingLinear,
+    soundtailor::modulators::kSmoothingOnePole,
+    soundtailor::modulators::kSmoothingMultiplicative
+  };
+  for (const soundtailor::modulators::SmoothingType kType : kTypes) {
+    SmoothedParameter parameter(kType, kStart);
+    parameter.SetTime(kTime);
+    parameter.SetTarget(kTarget);
+    EXPECT_TRUE(parameter.IsSmoothing());
+    std::vector<float> out(kDataTestSetSize);
+    parameter.ProcessBlock(&out[0], kDataTestSetSize);
+
+    double expected(kStart);
+    const double kPole(std::exp(-1.0 / kTime));
+    const double kRatio(std::pow(kTarget / kStart, 1.0 / kTime));
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      if (kType == soundtailor::modulators::kSmoothingLinear) {
+        expected = i + 1 < kTime
+          ? kStart + (kTarget - kStart) * (i + 1) / kTime
+          : kTarget;
+      } else if (kType == soundtailor::modulators::kSmoothingOnePole) {
+        expected = kTarget + (expected - kTarget) * kPole;
+      } else {
+        expected = i + 1 < kTime ? expected * kRatio : kTarget;
+      }
+      EXPECT_NEAR(expected, out[i], 1e-3f);
+    }
+    // Ramps reach exactly their target
+    if (kType != soundtailor::modulators::kSmoothingOnePole) {
+      EXPECT_EQ(kTarget, out[static_cast<unsigned int>(kTime)]);
+      EXPECT_EQ(kTarget, out[kDataTestSetSize - 1]);
+    }
+    EXPECT_FALSE(parameter.IsSmoothing());
+    EXPECT_EQ(kTarget, parameter.GetValue());
+    // Constant fast path afterwards
+    EXPECT_TRUE(VectorMath::Equal(kTarget, parameter()));
+  }
+}
+
+/// @brief Check that changes are always reported as smoothing,
+/// even without any smoothing time, and that retargeting is continuous
+TEST(SmoothedParameter, Retarget) {
+  SmoothedParameter parameter;
+  parameter.SetTarget(1.0f);
+  EXPECT_TRUE(parameter.IsSmoothing());
+  EXPECT_TRUE(VectorMath::Equal(1.0f, parameter()));
+  EXPECT_FALSE(parameter.IsSmoothing());
+  // Same target: nothing to do
+  parameter.SetTarget(1.0f);
+  EXPECT_FALSE(parameter.IsSmoothing());
+
+  parameter.SetTime(64.0f);
+  parameter.SetTarget(0.0f);
+  float last(1.0f);
+  for (unsigned int i(0); i < 8; ++i) {
+    last = VectorMath::GetLast(parameter());
+  }
+  EXPECT_NEAR(0.5f, last, 1e-5f);
+  // Going back up from where it was
+  parameter.SetTarget(1.0f);
+  const Sample kNext(parameter());
+  EXPECT_NEAR(last + 0.5f / 64.0f, VectorMath::GetFirst(kNext), 1e-5f);
+}
+
+/// @brief Setting the same target again on each block, as hosts automation
+/// usually does, must not restart the smoothing
+TEST(SmoothedParameter, SameTargetEachBlock) {
+  const unsigned int kBlockSize(64);
+  const float kTarget(4.0f);
+  const float kTime(401.0f);
+  const soundtailor::modulators::SmoothingType kTypes[] = {
+    soundtailor::modulators::kSmoothingLinear,
+    soundtailor::modulators::kSmoothingOnePole,
+    soundtailor::modulators::kSmoothingMultiplicative
+  };
+  for (const soundtailor::modulators::SmoothingType kType : kTypes) {
+    SmoothedParameter parameter(kType, 0.25f);
+    parameter.SetTime(kTime);
+    // Set only once
+    SmoothedParameter reference(parameter);
+    reference.SetTarget(kTarget);
+    std::vector<float> out(kDataTestSetSize);
+    std::vector<float> expected(kDataTestSetSize);
+    for (unsigned int i(0); i < kDataTestSetSize; i += kBlockSize) {
+      parameter.SetTarget(kTarget);
+      parameter.ProcessBlock(&out[i], kBlockSize);
+      reference.ProcessBlock(&expected[i], kBlockSize);
+    }
+    for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+      EXPECT_EQ(expected[i], out[i]);
+    }
+    // Ramps reach their target within the smoothing time
+    if (kType != soundtailor::modulators::kSmoothingOnePole) {
+      EXPECT_EQ(kTarget, out[static_cast<unsigned int>(kTime)]);
+    }
+    EXPECT_FALSE(parameter.IsSmoothing());
+    EXPECT_EQ(kTarget, parameter.GetValue());
+  }
+}
+
+/// @brief Smoothed frequency modulation has to match the plain audio rate
+/// modulation API fed with the same ramp
+TEST(SmoothedParameter, GeneratorAutomation) {
+  const unsigned int kBlockSize(256);
+  SmoothedParameter frequency(soundtailor::modulators::kSmoothingMultiplicative,
+                              0.01f);
+  frequency.SetTime(1000.0f);
+  frequency.SetTarget(0.02f);
+  // Same ramp, retrieved beforehand
+  SmoothedParameter reference_frequency(frequency);
+  std::vector<float> ramp(kDataTestSetSize);
+  reference_frequency.ProcessBlock(&ramp[0], kDataTestSetSize);
+
+  SawtoothDPW generator;
+  SawtoothDPW reference;
+  generator.SetFrequency(0.01f);
+  reference.SetFrequency(0.01f);
+  std::vector<float> out(kDataTestSetSize);
+  std::vector<float> expected(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; i += kBlockSize) {
+    soundtailor::ProcessBlockSmoothedFM(frequency,
+                                        &out[i],
+                                        kBlockSize,
+                                        generator);
+  }
+  soundtailor::ProcessBlockFM(&ramp[0],
+                              &expected[0],
+                              kDataTestSetSize,
+                              reference);
+  for (unsigned int i(0); i < kDataTestSetSize; ++i) {
+    EXPECT_NEAR(expected[i], out[i], 1e-3f);
+  }
+  // Back to the unmodulated path, at the target frequency
+  EXPECT_FALSE(frequency.IsSmoothing());
+  reference.SetFrequency(0.02f);
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    EXPECT_TRUE(VectorMath::GreaterEqual(
+      1e-3f,
+      VectorMath::Abs(VectorMath::Sub(reference(), generator()))));
+  }
+}
+
+/// @brief Smoothed filter parameters have to match setting them
+/// once per Sample
+TEST(SmoothedParameter, FilterAutomation) {
+  const unsigned int kBlockSize(256);
+  std::vector<float> input(kDataTestSetSize);
+  WhiteNoise noise;
+  soundtailor::ProcessBlock(&input[0], kDataTestSetSize, noise);
+
+  SmoothedParameter frequency(soundtailor::modulators::kSmoothingOnePole, 0.1f);
+  SmoothedParameter resonance(soundtailor::modulators::kSmoothingLinear, 0.5f);
+  frequency.SetTime(200.0f);
+  resonance.SetTime(3000.0f);
+  frequency.SetTarget(0.01f);
+  resonance.SetTarget(2.0f);
+  SmoothedParameter reference_frequency(frequency);
+  SmoothedParameter reference_resonance(resonance);
+
+  StateVariable filter;
+  StateVariable reference;
+  std::vector<float> out(kDataTestSetSize);
+  for (unsigned int i(0); i < kDataTestSetSize; i += kBlockSize) {
+    soundtailor::ProcessBlockSmoothed(&input[i],
+                                      &out[i],
+                                      kBlockSize,
+                                      frequency,
+                                      resonance,
+                                      filter);
+  }
+  for (unsigned int i(0); i < kDataTestSetSize; i += soundtailor::SampleSize) {
+    reference.SetParameters(VectorMath::GetLast(reference_frequency()),
+                            VectorMath::GetLast(reference_resonance()));
+    const Sample kExpected(reference(VectorMath::Fill(&input[i])));
+    EXPECT_TRUE(VectorMath::GreaterEqual(
+      1e-5f,
+      VectorMath::Abs(VectorMath::Sub(kExpected,
+                                      VectorMath::Fill(&out[i])))));
+  }
+  EXPECT_FALSE(frequency.IsSmoothing());
+  EXPECT_FALSE(resonance.IsSmoothing());
+}
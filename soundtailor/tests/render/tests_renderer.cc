@@ -0,0 +1,65 @@
+/// @file tests_renderer.cc
+/// @brief SoundTailor offline renderer tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/render/renderer.h"
+#include "soundtailor/render/score.h"
+
+using soundtailor::render::Note;
+using soundtailor::render::Render;
+using soundtailor::render::Renderer;
+
+/// @brief Render one note: check the output length, and that it is only
+/// audible from the note on up to the end of its release
+TEST(Renderer, OneNote) {
+  const float kSamplingRate(48000.0f);
+  Render render;
+  render.filename = "note.wav";
+  render.patch_name = "default";
+  render.patch = soundtailor::render::DefaultPatch();
+  render.duration = 1.0f;
+  const Note kNote = {0.1f, 0.2f, 57, 1.0f};
+  render.notes.push_back(kNote);
+
+  Renderer renderer(kSamplingRate, 256);
+  std::vector<float> out;
+  const std::size_t kLength(renderer.Process(render, &out));
+  EXPECT_EQ(48000u, kLength);
+  EXPECT_LE(kLength, out.size());
+
+  const std::size_t kNoteOn(renderer.GetLength(kNote.start));
+  const std::size_t kNoteOff(renderer.GetLength(kNote.start + kNote.length));
+  // Release has to be over 100ms after note off: some margin added
+  const std::size_t kSilence(kNoteOff
+                             + renderer.GetLength(
+                                 2.0f * render.patch.release / 1000.0f));
+  float peak(0.0f);
+  for (std::size_t i(0); i < kLength; ++i) {
+    if (i < kNoteOn || i >= kSilence) {
+      EXPECT_EQ(0.0f, out[i]);
+    } else {
+      peak = std::max(peak, std::abs(out[i]));
+    }
+  }
+  EXPECT_LT(0.1f, peak);
+}
@@ -0,0 +1,110 @@
+/// @file tests_score.cc
+/// @brief SoundTailor offline render score parsing tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <sstream>
+#include <string>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/render/score.h"
+
+using soundtailor::render::Note;
+using soundtailor::render::Patch;
+using soundtailor::render::Score;
+
+/// @brief Parse the given score description, expecting it to fail
+/// with an error containing the given message
+static void ExpectError(const std::string& description,
+                        const std::string& message) {
+  std::istringstream input(description);
+  Score score;
+  std::string error;
+  EXPECT_FALSE(soundtailor::render::ParseScore(input, &score, &error));
+  EXPECT_NE(std::string::npos, error.find(message)) << error;
+}
+
+/// @brief Check that a valid score gets all of its settings
+TEST(Score, Parse) {
+  std::istringstream input(
+    "# Comment\n"
+    "sampling_rate 44100\n"
+    "block_size 128\n"
+    "\n"
+    "patch bass\n"
+    "  oscillator square_blit  # Trailing comment\n"
+    "  filter state_variable 800 1.0\n"
+    "  envelop 5 200 0.5 300\n"
+    "end\n"
+    "render bass.wav bass 2.0\n"
+    "  note 0.0 1.5 36 1.0\n"
+    "  note 1.0 0.5 48 0.5\n"
+    "end\n");
+  Score score;
+  std::string error;
+  EXPECT_TRUE(soundtailor::render::ParseScore(input, &score, &error));
+  EXPECT_TRUE(error.empty());
+  EXPECT_EQ(44100.0f, score.sampling_rate);
+  EXPECT_EQ(128u, score.block_size);
+  ASSERT_EQ(1u, score.renders.size());
+  EXPECT_EQ("bass.wav", score.renders[0].filename);
+  EXPECT_EQ(2.0f, score.renders[0].duration);
+
+  const Patch& kPatch(score.renders[0].patch);
+  EXPECT_EQ(soundtailor::render::kOscillatorSquareBLIT, kPatch.oscillator);
+  EXPECT_EQ(soundtailor::render::kFilterStateVariable, kPatch.filter);
+  EXPECT_EQ(800.0f, kPatch.cutoff);
+  EXPECT_EQ(1.0f, kPatch.resonance);
+  EXPECT_EQ(0.5f, kPatch.sustain);
+  EXPECT_EQ(300.0f, kPatch.release);
+  // Unspecified parameters keep their default value
+  EXPECT_EQ(soundtailor::render::DefaultPatch().gain, kPatch.gain);
+
+  ASSERT_EQ(2u, score.renders[0].notes.size());
+  const Note& kNote(score.renders[0].notes[1]);
+  EXPECT_EQ(1.0f, kNote.start);
+  EXPECT_EQ(0.5f, kNote.length);
+  EXPECT_EQ(48, kNote.pitch);
+  EXPECT_EQ(0.5f, kNote.velocity);
+}
+
+/// @brief Check that invalid scores are rejected, with the relevant error
+TEST(Score, Errors) {
+  ExpectError("sample_rate 48000\n", "line 1: unknown keyword");
+  ExpectError("patch lead\n  vibrato 5\nend\n",
+              "line 2: unknown patch parameter");
+  ExpectError("patch lead\n  oscillator sine\nend\n", "unknown oscillator");
+  ExpectError("patch lead\n  filter moog 800\nend\n", "expected: filter");
+  ExpectError("block_size 6\n", "expected: block_size");
+  ExpectError("end\n", "outside of any patch");
+  ExpectError("patch lead\n  gain 0.5\n", "missing 'end'");
+  ExpectError("patch lead\nend\nrender lead.wav lead 1.0\n  note 0 1 60 1\n",
+              "missing 'end'");
+  ExpectError("patch lead\n  filter moog 800 100.0\nend\n",
+              "line 3: resonance out of the filter range");
+  ExpectError("patch lead\n  envelop 5 -1 0.5 100\nend\n",
+              "envelop times cannot be negative");
+  ExpectError("render lead.wav lead 1.0\nend\n", "undefined patch 'lead'");
+  ExpectError("patch lead\nend\nrender lead.wav lead 1.0\n  note 0 1 128 1\n"
+              "end\n",
+              "line 4: note pitch");
+  ExpectError("patch lead\nend\nrender lead.wav lead 1.0\n  note 0 1 60\n"
+              "end\n",
+              "expected: note");
+}
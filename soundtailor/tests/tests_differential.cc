@@ -0,0 +1,439 @@
+/// @file tests_differential.cc
+/// @brief SoundTailor optimized versus reference paths differential fuzzing
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+// std::abs
+// std::max, std::min
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+// std::memcpy
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/filters/firstorder_polefixedzero.h"
+#include "soundtailor/src/filters/moog_lowpassblock.h"
+#include "soundtailor/src/filters/moog_musicdsp.h"
+#include "soundtailor/src/filters/moog_musicdsp_var1.h"
+#include "soundtailor/src/filters/moog_musicdsp_var2.h"
+#include "soundtailor/src/filters/moog_musicdsp_varstilson.h"
+#include "soundtailor/src/filters/moog_oversampled.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/filters/state_variable.h"
+#include "soundtailor/src/generators/dpw.h"
+#include "soundtailor/src/generators/generators_common.h"
+#include "soundtailor/src/generators/sawtooth_blit.h"
+#include "soundtailor/src/generators/sawtooth_dpw.h"
+#include "soundtailor/src/generators/square_blit.h"
+#include "soundtailor/src/generators/triangle_dpw.h"
+#include "soundtailor/src/generators/white_noise.h"
+
+using soundtailor::SampleSize;
+using soundtailor::filters::FirstOrderPoleFixedZero;
+using soundtailor::filters::MoogLowPassBlock;
+using soundtailor::filters::MoogMusicDSP;
+using soundtailor::filters::MoogMusicDSPVar1;
+using soundtailor::filters::MoogMusicDSPVar2;
+using soundtailor::filters::MoogMusicDSPVarStilson;
+using soundtailor::filters::MoogOversampled;
+using soundtailor::filters::SecondOrderRaw;
+using soundtailor::filters::StateVariable;
+using soundtailor::generators::DPW;
+using soundtailor::generators::PhaseAccumulator;
+using soundtailor::generators::SawtoothBLIT;
+using soundtailor::generators::SawtoothDPW;
+using soundtailor::generators::SquareBLIT;
+using soundtailor::generators::TriangleDPW;
+using soundtailor::generators::WhiteNoise;
+
+// Each trial renders kTrialLength samples by blocks of random sizes,
+// parameters being randomly automated between blocks
+#if (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+static const unsigned int kTrialsCount(8);
+#else  // (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+static const unsigned int kTrialsCount(64);
+#endif  // (_SOUNDTAILOR_BUILD_CONFIGURATION_DEBUG)
+static const unsigned int kTrialLength(8192);
+static const unsigned int kMaxBlockSize(512);
+
+/// @brief References below this magnitude are not taken into account
+/// for ULP errors, which are meaningless around zero
+static const float kUlpFloor(1e-3f);
+
+/// @brief Distance in units in the last place between two floats
+/// (max value if any of them is not finite)
+static std::uint64_t UlpDistance(const float left, const float right) {
+  if (!std::isfinite(left) || !std::isfinite(right)) {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+  std::int32_t left_bits;
+  std::int32_t right_bits;
+  std::memcpy(&left_bits, &left, sizeof(left));
+  std::memcpy(&right_bits, &right, sizeof(right));
+  // Mapping to a monotonic integer scale across zero
+  const std::int64_t kLeft(left_bits < 0
+                           ? std::numeric_limits<std::int32_t>::min()
+                             - static_cast<std::int64_t>(left_bits)
+                           : left_bits);
+  const std::int64_t kRight(right_bits < 0
+                            ? std::numeric_limits<std::int32_t>::min()
+                              - static_cast<std::int64_t>(right_bits)
+                            : right_bits);
+  return static_cast<std::uint64_t>(kLeft > kRight ? kLeft - kRight
+                                                   : kRight - kLeft);
+}
+
+/// @brief Errors above this are counted as outliers:
+/// a discontinuity moved by one sample, rather than rounding differences
+static const float kOutlierThreshold(1e-2f);
+
+/// @brief Maximum errors of an optimized path against its reference
+struct ErrorBounds {
+  ErrorBounds()
+      : max_absolute(0.0f),
+        max_inlier(0.0f),
+        max_reference(0.0f),
+        max_ulp(0),
+        outliers_count(0),
+        samples_count(0) {
+  }
+
+  void Update(const float reference, const float actual) {
+    const float kAbsolute(std::isfinite(actual)
+                          ? std::abs(actual - reference)
+                          : std::numeric_limits<float>::infinity());
+    max_absolute = std::max(max_absolute, kAbsolute);
+    if (kAbsolute > kOutlierThreshold) {
+      outliers_count += 1;
+    } else {
+      max_inlier = std::max(max_inlier, kAbsolute);
+    }
+    max_reference = std::max(max_reference, std::abs(reference));
+    if (std::abs(reference) >= kUlpFloor) {
+      max_ulp = std::max(max_ulp, UlpDistance(reference, actual));
+    }
+    samples_count += 1;
+  }
+
+  /// @brief Maximum absolute error relative to the reference peak
+  /// (or to 1.0 if it is below)
+  float GetRelative(void) const {
+    return max_absolute / std::max(max_reference, 1.0f);
+  }
+
+  /// @brief Ratio of samples with an error above kOutlierThreshold
+  double GetOutliersRatio(void) const {
+    return samples_count > 0
+           ? static_cast<double>(outliers_count) / samples_count
+           : 0.0;
+  }
+
+  /// @brief Report bounds for the current (typed) test
+  void Print(void) const {
+    const ::testing::TestInfo* kInfo(
+      ::testing::UnitTest::GetInstance()->current_test_info());
+    std::cerr << kInfo->test_suite_name() << " " << kInfo->type_param()
+              << ": max absolute error " << max_absolute
+              << " (relative " << GetRelative()
+              << "), max ULP error " << max_ulp
+              << ", " << outliers_count << " outliers (max inlier error "
+              << max_inlier << ") over " << samples_count
+              << " samples" << std::endl;
+  }
+
+  float max_absolute;
+  float max_inlier;  ///< Maximum error, outliers excluded
+  float max_reference;  ///< Reference peak
+  std::uint64_t max_ulp;
+  std::size_t outliers_count;
+  std::size_t samples_count;
+};
+
+/// @brief Random blocks sizes, multiples of SampleSize
+static unsigned int RandomBlockSize(std::default_random_engine* engine) {
+  std::uniform_int_distribution<unsigned int> distribution(
+    1,
+    kMaxBlockSize / SampleSize);
+  return distribution(*engine) * SampleSize;
+}
+
+/// @brief Random filter parameters automation:
+/// random walk of the frequency on a logarithmic scale, resonance below
+/// self-oscillation (which would amplify any rounding difference)
+template <typename FilterType>
+class FilterAutomation {
+ public:
+  explicit FilterAutomation(std::default_random_engine* engine)
+      : engine_(engine),
+        log_min_(std::log(std::max(FilterType::Meta().freq_min, 1e-3f))),
+        log_max_(std::log(std::min(FilterType::Meta().freq_max, 0.45f))),
+        log_frequency_(std::uniform_real_distribution<float>(
+          log_min_,
+          log_max_)(*engine)),
+        resonance_(std::uniform_real_distribution<float>(
+          FilterType::Meta().res_min,
+          FilterType::Meta().res_min
+          + 0.5f * (FilterType::Meta().res_max
+                    - FilterType::Meta().res_min))(*engine)) {
+  }
+
+  /// @brief Apply the next automation step on both filters
+  void Apply(FilterType* left, FilterType* right) {
+    std::normal_distribution<float> step(0.0f, 0.2f);
+    log_frequency_ = std::min(std::max(log_frequency_ + step(*engine_),
+                                       log_min_),
+                              log_max_);
+    // Rounding may get the frequency slightly out of the filter range
+    const float kFrequency(std::min(std::max(std::exp(log_frequency_),
+                                             FilterType::Meta().freq_min),
+                                    FilterType::Meta().freq_max));
+    left->SetParameters(kFrequency, resonance_);
+    right->SetParameters(kFrequency, resonance_);
+  }
+
+ private:
+  std::default_random_engine* engine_;
+  const float log_min_;
+  const float log_max_;
+  float log_frequency_;
+  const float resonance_;
+};
+
+/// @brief Fuzz the given optimized path against its reference
+///
+/// @param[in]  process   Called with the filters, input, references
+/// and actual outputs and block size, has to fill both outputs
+template <typename FilterType, typename Processor>
+static ErrorBounds FuzzFilter(Processor process) {
+  std::default_random_engine engine;
+  WhiteNoise noise;
+  std::vector<float> input(kMaxBlockSize);
+  std::vector<float> reference(kMaxBlockSize);
+  std::vector<float> actual(kMaxBlockSize);
+  ErrorBounds bounds;
+  for (unsigned int trial(0); trial < kTrialsCount; ++trial) {
+    FilterType reference_filter;
+    FilterType actual_filter;
+    FilterAutomation<FilterType> automation(&engine);
+    unsigned int rendered(0);
+    while (rendered < kTrialLength) {
+      const unsigned int kBlockSize(RandomBlockSize(&engine));
+      automation.Apply(&reference_filter, &actual_filter);
+      soundtailor::ProcessBlock(&input[0], kBlockSize, noise);
+      process(&reference_filter,
+              &actual_filter,
+              &input[0],
+              &reference[0],
+              &actual[0],
+              kBlockSize);
+      for (unsigned int i(0); i < kBlockSize; ++i) {
+        bounds.Update(reference[i], actual[i]);
+      }
+      rendered += kBlockSize;
+    }
+  }
+  bounds.Print();
+  return bounds;
+}
+
+/// @brief Filters providing a scalar reference for their Sample path
+// MoogLowAliasNonLinear scalar path is tuned for oversampling: no reference
+template <typename FilterType>
+class FuzzFilterScalar : public ::testing::Test {
+};
+
+typedef ::testing::Types<FirstOrderPoleFixedZero,
+                         MoogLowPassBlock,
+                         MoogMusicDSP,
+                         MoogMusicDSPVar1,
+                         MoogMusicDSPVar2,
+                         MoogMusicDSPVarStilson,
+                         MoogOversampled,
+                         SecondOrderRaw> FuzzFilterScalarTypes;
+
+TYPED_TEST_SUITE(FuzzFilterScalar, FuzzFilterScalarTypes);
+
+/// @brief Sample path against the scalar path
+TYPED_TEST(FuzzFilterScalar, SampleVsScalar) {
+  const ErrorBounds kBounds(FuzzFilter<TypeParam>([](
+      TypeParam* reference_filter,
+      TypeParam* actual_filter,
+      const float* input,
+      float* reference,
+      float* actual,
+      const unsigned int block_size) {
+    for (unsigned int i(0); i < block_size; ++i) {
+      reference[i] = (*reference_filter)(input[i]);
+    }
+    for (unsigned int i(0); i < block_size; i += SampleSize) {
+      VectorMath::Store(&actual[i],
+                        (*actual_filter)(VectorMath::Fill(&input[i])));
+    }
+  }));
+  // Summation order differences get amplified by high resonances
+  EXPECT_GT(1e-4f, kBounds.GetRelative());
+}
+
+/// @brief Filters with their own block processing method
+template <typename FilterType>
+class FuzzFilterBlock : public ::testing::Test {
+};
+
+typedef ::testing::Types<MoogMusicDSP,
+                         MoogMusicDSPVar1,
+                         MoogMusicDSPVar2,
+                         MoogMusicDSPVarStilson,
+                         StateVariable> FuzzFilterBlockTypes;
+
+TYPED_TEST_SUITE(FuzzFilterBlock, FuzzFilterBlockTypes);
+
+/// @brief Block path against the Sample path
+TYPED_TEST(FuzzFilterBlock, BlockVsSample) {
+  const ErrorBounds kBounds(FuzzFilter<TypeParam>([](
+      TypeParam* reference_filter,
+      TypeParam* actual_filter,
+      const float* input,
+      float* reference,
+      float* actual,
+      const unsigned int block_size) {
+    for (unsigned int i(0); i < block_size; i += SampleSize) {
+      VectorMath::Store(&reference[i],
+                        (*reference_filter)(VectorMath::Fill(&input[i])));
+    }
+    actual_filter->ProcessBlock(input, actual, block_size);
+  }));
+  // Summation order differences get amplified by high resonances
+  EXPECT_GT(1e-4f, kBounds.GetRelative());
+}
+
+/// @brief Generators providing a scalar reference (ProcessParameters())
+/// for their Sample path
+template <typename GeneratorType>
+class FuzzGenerator : public ::testing::Test {
+};
+
+typedef ::testing::Types<DPW<3>,
+                         DPW<4>,
+                         PhaseAccumulator,
+                         SawtoothBLIT,
+                         SawtoothDPW,
+                         SquareBLIT,
+                         TriangleDPW> FuzzGeneratorTypes;
+
+TYPED_TEST_SUITE(FuzzGenerator, FuzzGeneratorTypes);
+
+/// @brief Expected errors of a generator Sample path against its scalar one
+struct GeneratorTolerance {
+  float max_inlier;  ///< Rounding differences
+  float max_outlier;  ///< Discontinuities moved by one sample
+};
+
+/// @brief Tolerances of each generator, fitted to the observed errors
+template <typename GeneratorType>
+GeneratorTolerance GetGeneratorTolerance(void);
+
+/// @brief Closed form computations: no discontinuity can move
+template <>
+GeneratorTolerance GetGeneratorTolerance<DPW<3> >(void) {
+  return {2e-6f, 0.0f};
+}
+
+template <>
+GeneratorTolerance GetGeneratorTolerance<DPW<4> >(void) {
+  return {1e-5f, 0.0f};
+}
+
+/// @brief A moved wrap yields a full scale error, the phase staying within
+/// [-1.0 ; 1.0]
+template <>
+GeneratorTolerance GetGeneratorTolerance<PhaseAccumulator>(void) {
+  return {1e-4f, 2.0f};
+}
+
+/// @brief Band limited steps: the phase drift is amplified by their slope,
+/// errors spread continuously up to the outliers threshold
+template <>
+GeneratorTolerance GetGeneratorTolerance<SawtoothBLIT>(void) {
+  return {kOutlierThreshold, 0.1f};
+}
+
+/// @brief Same as band limited steps, with a steeper transition
+template <>
+GeneratorTolerance GetGeneratorTolerance<SawtoothDPW>(void) {
+  return {kOutlierThreshold, 0.2f};
+}
+
+template <>
+GeneratorTolerance GetGeneratorTolerance<SquareBLIT>(void) {
+  return {kOutlierThreshold, 0.1f};
+}
+
+/// @brief No discontinuity in the waveform itself, only in its derivative
+template <>
+GeneratorTolerance GetGeneratorTolerance<TriangleDPW>(void) {
+  return {5e-4f, 0.0f};
+}
+
+/// @brief Sample path against the scalar path, frequency being randomly
+/// automated between blocks
+TYPED_TEST(FuzzGenerator, SampleVsScalar) {
+  std::default_random_engine engine;
+  // Same range as the generators tests
+  const float kLogMin(std::log(10.0f / 48000.0f));
+  const float kLogMax(std::log(2000.0f / 48000.0f));
+  std::uniform_real_distribution<float> frequency_distribution(kLogMin,
+                                                               kLogMax);
+  std::normal_distribution<float> step(0.0f, 0.2f);
+  std::vector<float> actual(kMaxBlockSize);
+  ErrorBounds bounds;
+  for (unsigned int trial(0); trial < kTrialsCount; ++trial) {
+    TypeParam reference_generator;
+    TypeParam actual_generator;
+    float log_frequency(frequency_distribution(engine));
+    unsigned int rendered(0);
+    while (rendered < kTrialLength) {
+      const unsigned int kBlockSize(RandomBlockSize(&engine));
+      log_frequency = std::min(std::max(log_frequency + step(engine),
+                                        kLogMin),
+                               kLogMax);
+      reference_generator.SetFrequency(std::exp(log_frequency));
+      actual_generator.SetFrequency(std::exp(log_frequency));
+      for (unsigned int i(0); i < kBlockSize; i += SampleSize) {
+        VectorMath::Store(&actual[i], actual_generator());
+      }
+      for (unsigned int i(0); i < kBlockSize; ++i) {
+        bounds.Update(reference_generator.ProcessParameters(), actual[i]);
+      }
+      rendered += kBlockSize;
+    }
+  }
+  bounds.Print();
+  // The Sample path increments its phase by 4 steps at once:
+  // rounding differences accumulate, and make the occasional discontinuity
+  // happen one sample earlier or later than in the scalar path
+  EXPECT_GT(1e-3, bounds.GetOutliersRatio());
+  const GeneratorTolerance kTolerance(GetGeneratorTolerance<TypeParam>());
+  EXPECT_GE(kTolerance.max_inlier, bounds.max_inlier);
+  EXPECT_GE(std::max(kTolerance.max_inlier, kTolerance.max_outlier),
+            bounds.max_absolute);
+}
@@ -0,0 +1,98 @@
+/// @file tests_instrumentation.cc
+/// @brief SoundTailor hot path instrumentation tests
+/// @author gm
+/// @copyright gm 2016
+///
+/// This file is part of SoundTailor
+///
+/// SoundTailor is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// SoundTailor is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with SoundTailor.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstring>
+#include <thread>
+
+#include "soundtailor/tests/tests.h"
+
+#include "soundtailor/src/instrumentation.h"
+#include "soundtailor/src/filters/secondorder_raw.h"
+#include "soundtailor/src/modulators/adsd.h"
+
+using soundtailor::filters::SecondOrderRaw;
+using soundtailor::instrumentation::Snapshot;
+using soundtailor::instrumentation::TakeSnapshot;
+using soundtailor::modulators::Adsd;
+
+namespace instrumentation = soundtailor::instrumentation;
+
+/// @brief Each probe has its own name
+TEST(Instrumentation, ProbeNames) {
+  for (unsigned int probe(0); probe < instrumentation::kProbesCount; ++probe) {
+    EXPECT_LT(0U, std::strlen(instrumentation::GetProbeName(
+      static_cast<instrumentation::Probe>(probe))));
+  }
+}
+
+/// @brief Events happening in another thread have to be reported
+/// by snapshots, and nothing at all if instrumentation is disabled
+TEST(Instrumentation, Snapshot) {
+  const unsigned int kSetParametersCount(10);
+  const Snapshot kBefore(TakeSnapshot());
+
+  std::thread worker([kSetParametersCount]() {
+    SecondOrderRaw filter;
+    for (unsigned int i(0); i < kSetParametersCount; ++i) {
+      filter.SetParameters(0.01f * (i + 1), 0.7071f);
+    }
+    // One whole note: attack, decay, sustain, release
+    Adsd envelop;
+    envelop.SetParameters(16, 16, 16, 0.5f);
+    envelop.TriggerOn();
+    for (unsigned int i(0); i < 64; ++i) {
+      envelop.ComputeOneSample();
+    }
+    envelop.TriggerOff();
+    for (unsigned int i(0); i < 64; ++i) {
+      envelop.ComputeOneSample();
+    }
+  });
+  worker.join();
+
+  const Snapshot kAfter(TakeSnapshot());
+  const std::uint64_t kTriggers(
+    kAfter.counts[instrumentation::kProbeAdsdTrigger]
+    - kBefore.counts[instrumentation::kProbeAdsdTrigger]);
+  const std::uint64_t kTransitions(
+    kAfter.counts[instrumentation::kProbeAdsdSectionTransition]
+    - kBefore.counts[instrumentation::kProbeAdsdSectionTransition]);
+  const std::uint64_t kSetParameters(
+    kAfter.counts[instrumentation::kProbeSecondOrderRawSetParameters]
+    - kBefore.counts[instrumentation::kProbeSecondOrderRawSetParameters]);
+  const std::uint64_t kCycles(
+    kAfter.cycles[instrumentation::kProbeSecondOrderRawSetParameters]
+    - kBefore.cycles[instrumentation::kProbeSecondOrderRawSetParameters]);
+
+  if (instrumentation::kEnabled) {
+    EXPECT_EQ(2U, kTriggers);
+    // Attack to decay, decay to sustain, release to zero
+    EXPECT_EQ(3U, kTransitions);
+    EXPECT_EQ(kSetParametersCount, kSetParameters);
+    EXPECT_LT(0U, kCycles);
+    EXPECT_LT(kBefore.threads_count, kAfter.threads_count);
+  } else {
+    EXPECT_EQ(0U, kTriggers);
+    EXPECT_EQ(0U, kTransitions);
+    EXPECT_EQ(0U, kSetParameters);
+    EXPECT_EQ(0U, kCycles);
+    EXPECT_EQ(0U, kAfter.threads_count);
+  }
+}